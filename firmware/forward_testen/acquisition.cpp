@@ -0,0 +1,158 @@
+#include "acquisition.hpp"
+
+#include <modm/architecture/interface/delay.hpp>
+#include <modm/architecture/interface/interrupt.hpp>
+#include <modm/processing/fiber.hpp>
+
+using namespace Board;
+
+namespace
+{
+    // factory calibration, measured at 3.0 V analog supply
+    const uint16_t &VrefintCalibration = *reinterpret_cast<const uint16_t*>(0x1FFF75AA);
+    const uint16_t &Temperature30 = *reinterpret_cast<const uint16_t*>(0x1FFF75A8);
+    const uint16_t &Temperature130 = *reinterpret_cast<const uint16_t*>(0x1FFF75CA);
+
+    constexpr size_t Size = 2 * Acquisition::Frames * Acquisition::Channels;
+
+    // both halves of the double buffer
+    volatile uint16_t buffer[Size];
+    volatile uint32_t completed{0};
+    uint32_t taken{0};
+    uint32_t overruns{0};
+    volatile modm::fiber::id waiter{0};
+
+    DMA_Channel_TypeDef*
+    dma()
+    {
+        return reinterpret_cast<DMA_Channel_TypeDef*>(DMA1_Channel1_BASE +
+                (DMA1_Channel2_BASE - DMA1_Channel1_BASE) * (Analog::DmaChannel - 1));
+    }
+
+    void
+    initializeAdc()
+    {
+        RCC->AHB2ENR |= RCC_AHB2ENR_ADC12EN;
+        // synchronous clock 170 MHz / 4, below the 60 MHz limit
+        ADC12_COMMON->CCR = ADC_CCR_CKMODE_1 | ADC_CCR_CKMODE_0 | ADC_CCR_VREFEN | ADC_CCR_VSENSESEL;
+
+        ADC1->CR = 0;   // leave deep power down
+        ADC1->CR = ADC_CR_ADVREGEN;
+        modm::delay_us(20);
+        ADC1->CR |= ADC_CR_ADCAL;
+        while (ADC1->CR & ADC_CR_ADCAL) {}
+
+        // the internal channels need 4 us of sampling, 640.5 cycles are 15 us
+        uint32_t sequence = (Acquisition::Channels - 1) << ADC_SQR1_L_Pos;
+        uint32_t smpr1 = 0, smpr2 = 0;
+        for (size_t ii = 0; ii < Acquisition::Channels; ii++)
+        {
+            const uint32_t channel = Analog::Channels[ii];
+            sequence |= channel << (ADC_SQR1_SQ1_Pos + 6 * ii);
+            if (channel < 10) smpr1 |= 0b111 << (3 * channel);
+            else smpr2 |= 0b111 << (3 * (channel - 10));
+        }
+        static_assert(Acquisition::Channels <= 4, "SQR1 holds four conversions!");
+        ADC1->SQR1 = sequence;
+        ADC1->SMPR1 = smpr1;
+        ADC1->SMPR2 = smpr2;
+
+        // rising edge of TIM3_TRGO (EXT4), circular DMA, keep the newest on overrun
+        ADC1->CFGR = ADC_CFGR_EXTEN_0 | (4 << ADC_CFGR_EXTSEL_Pos) |
+                     ADC_CFGR_DMAEN | ADC_CFGR_DMACFG | ADC_CFGR_OVRMOD;
+
+        ADC1->ISR = ADC_ISR_ADRDY;
+        ADC1->CR |= ADC_CR_ADEN;
+        while (not (ADC1->ISR & ADC_ISR_ADRDY)) {}
+    }
+
+    void
+    initializeDma()
+    {
+        modm::platform::Rcc::enable<modm::platform::Peripheral::Dmamux1>();
+        modm::platform::Rcc::enable<modm::platform::Peripheral::Dma1>();
+
+        dma()->CCR = 0;
+        (DMAMUX1_Channel0 + (Analog::DmaChannel - 1))->CCR = Analog::DmaRequest;
+        dma()->CPAR = reinterpret_cast<uintptr_t>(&ADC1->DR);
+        dma()->CMAR = reinterpret_cast<uintptr_t>(buffer);
+        dma()->CNDTR = Size;
+        dma()->CCR = DMA_CCR_MSIZE_0 | DMA_CCR_PSIZE_0 | DMA_CCR_PL_1 | DMA_CCR_MINC |
+                     DMA_CCR_CIRC | DMA_CCR_HTIE | DMA_CCR_TCIE | DMA_CCR_EN;
+
+        NVIC_SetPriority(DMA1_Channel3_IRQn, 6);
+        NVIC_EnableIRQ(DMA1_Channel3_IRQn);
+    }
+}
+
+void
+Acquisition::initialize()
+{
+    static_assert(Analog::DmaChannel == 3, "The interrupt handler below is for DMA1 channel 3!");
+
+    initializeDma();
+    initializeAdc();
+
+    // OC4REF is high for one tick at the trough of the center-aligned
+    // counter, the middle of the on-time, and becomes TRGO. MotorTimer2
+    // already runs, further triggers do not affect it.
+    MotorTimer3::configureOutputChannel(4, MotorTimer3::OutputCompareMode::Pwm, 1, MotorTimer3::PinState::Disable);
+    TIM3->CR2 = (TIM3->CR2 & ~TIM_CR2_MMS) | uint32_t(MotorTimer3::MasterMode::CompareOc4Ref);
+
+    ADC1->CR |= ADC_CR_ADSTART;
+}
+
+Acquisition::Batch
+Acquisition::wait()
+{
+    waiter = modm::this_fiber::get_id();
+    while (completed == taken) {
+        modm::this_fiber::suspend();
+    }
+    waiter = 0;
+
+    const uint32_t sequence = completed;
+    overruns += sequence - taken - 1;
+    taken = sequence;
+    // odd batches are in the first half
+    const size_t offset = (sequence & 1) ? 0 : Frames * Channels;
+    return Batch(buffer + offset, Frames, sequence);
+}
+
+uint32_t
+Acquisition::getOverruns()
+{
+    return overruns;
+}
+
+uint16_t
+Acquisition::toSupply(uint16_t vrefint)
+{
+    if (vrefint == 0) {
+        return 0;
+    }
+    return uint32_t(3000) * VrefintCalibration / vrefint;
+}
+
+int16_t
+Acquisition::toTemperature(uint16_t sample, uint16_t supply)
+{
+    // the calibration values are for 3.0 V
+    const int32_t scaled = int32_t(sample) * supply / 3000;
+    return 30 + (scaled - Temperature30) * (130 - 30) / (Temperature130 - Temperature30);
+}
+
+uint16_t
+Acquisition::toBattery(uint16_t sample, uint16_t supply)
+{
+    return uint32_t(sample) * supply * Board::Analog::BatteryDivider / 4095;
+}
+
+MODM_ISR(DMA1_Channel3)
+{
+    DMA1->IFCR = DMA_IFCR_CGIF3;
+    completed = completed + 1;
+    if (waiter) {
+        modm::fiber::resume(waiter);
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef ACQUISITION_HPP
+#define ACQUISITION_HPP
+
+#include <cstdint>
+#include <iterator>
+
+#include "hardware.hpp"
+#include "sample_batch.hpp"
+
+/**
+ * @brief PWM-synchronous ADC sampling into DMA double buffers.
+ *
+ * MotorTimer3 triggers ADC1 once per PWM period at a fixed phase, the
+ * sequence of Board::Analog is converted and the DMA writes the frames into
+ * one half of a circular buffer while the other half is processed. Each
+ * completed half resumes the fiber waiting in wait(), there is no polling
+ * and no per-sample interrupt.
+ */
+namespace Acquisition
+{
+    static constexpr size_t Channels = std::size(Board::Analog::Channels);
+    static constexpr size_t Frames = Board::Analog::Frames;
+    using Batch = SampleBatch<Channels>;
+
+    /// @return the position of an ADC channel in the frames
+    constexpr size_t
+    indexOf(uint8_t channel)
+    {
+        for (size_t ii = 0; ii < Channels; ii++) {
+            if (Board::Analog::Channels[ii] == channel) return ii;
+        }
+        return Channels;
+    }
+
+    /// Call after Board::initialize(), MotorTimer3 has to run.
+    void initialize();
+
+    /**
+     * @brief Suspends the calling fiber until the next batch.
+     *
+     * The batch stays valid for one batch period, until the DMA comes back
+     * to its half of the buffer.
+     */
+    Batch wait();
+
+    /// @return the number of batches completed before the previous one was taken
+    uint32_t getOverruns();
+
+    /// @return the analog supply in mV from a VREFINT sample
+    uint16_t toSupply(uint16_t vrefint);
+
+    /// @return the chip temperature in degree Celsius
+    int16_t toTemperature(uint16_t sample, uint16_t supply);
+
+    /// @return VM in mV from a sample of the Battery divider
+    uint16_t toBattery(uint16_t sample, uint16_t supply);
+}
+
+#endif // ACQUISITION_HPP
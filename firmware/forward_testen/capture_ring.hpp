@@ -0,0 +1,199 @@
+#ifndef CAPTURE_RING_HPP
+#define CAPTURE_RING_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <modm/architecture/detect.hpp>
+#include "capture_span.hpp"
+
+#ifdef MODM_OS_HOSTED
+// host tests take the edges from the motor models of the SimBoard
+#include "sim/capture_ring.hpp"
+
+template<class Capture, size_t Size = 32>
+using CaptureRing = sim::CaptureRing<Capture, Size>;
+#else
+
+#include <modm/platform.hpp>
+
+/**
+ * @brief Input capture into a ring buffer by DMA.
+ *
+ * The capture timer runs free, every rising edge of the input latches the
+ * counter and the DMA copies it into a circular buffer, so there is no CPU
+ * load per edge. Consumers call poll() periodically, faster than the timer
+ * wraps, which counts the new edges and tracks the time since the last one.
+ * Estimators from `capture::` operate on spans of the ring.
+ *
+ * `Capture` describes the hardware:
+ * @code
+ * struct Capture
+ * {
+ *     using Timer = Timer17;
+ *     using Signal = GpioA7::Ch1;
+ *     static constexpr uintptr_t TimerBase = TIM17_BASE;
+ *     static constexpr uint8_t DmaChannel = 1;    // DMA1 channel 1..8
+ *     static constexpr uint8_t DmaRequest = 84;   // DMAMUX request of Signal
+ *     static constexpr uint32_t TickFrequency = 100'000;
+ * };
+ * @endcode
+ *
+ * @tparam Size number of timestamps in the ring, a power of two
+ */
+template<class Capture, size_t Size = 32>
+class CaptureRing
+{
+    static_assert((Size & (Size - 1)) == 0, "The ring size must be a power of two!");
+    static_assert(Capture::DmaChannel >= 1 and Capture::DmaChannel <= 8, "DMA1 has channels 1 to 8!");
+
+    using Timer = typename Capture::Timer;
+    using Signal = typename Capture::Signal;
+
+    static constexpr uint32_t Channel = []
+    {
+        using modm::platform::Gpio;
+        static_assert(Signal::Signal == Gpio::Signal::Ch1 or Signal::Signal == Gpio::Signal::Ch2 or
+                      Signal::Signal == Gpio::Signal::Ch3 or Signal::Signal == Gpio::Signal::Ch4,
+                      "The input must connect to a capture channel!");
+        if (Signal::Signal == Gpio::Signal::Ch1) return 1;
+        if (Signal::Signal == Gpio::Signal::Ch2) return 2;
+        if (Signal::Signal == Gpio::Signal::Ch3) return 3;
+        return 4;
+    }();
+
+public:
+    using Timestamp = typename Timer::Value;
+    using Span = CaptureSpan<Timestamp>;
+
+    /**
+     * @param filter    number of timer clocks the input must be stable, see
+     *                  the ICxF bits in the reference manual
+     */
+    template<class SystemClock>
+    static void
+    initialize(uint8_t filter = 0b0011)
+    {
+        static_assert(Timer::template getClockFrequency<SystemClock>() % Capture::TickFrequency == 0,
+                      "The tick frequency must divide the timer clock!");
+
+        // a timer which already counts, e.g. as a TimerClock, keeps its time base
+        if (not (timer()->CR1 & TIM_CR1_CEN))
+        {
+            Timer::enable();
+            Timer::setMode(Timer::Mode::UpCounter);
+            Timer::setPrescaler(Timer::template getClockFrequency<SystemClock>() / Capture::TickFrequency);
+            Timer::setOverflow(Timestamp(~0u));
+            Timer::applyAndReset();
+        }
+
+        Timer::template connect<Signal>();
+        Timer::template configureInputChannel<Signal>(
+                Timer::InputCaptureMapping::InputOwn,
+                Timer::InputCapturePrescaler::Div1,
+                Timer::InputCapturePolarity::Rising, filter);
+
+        modm::platform::Rcc::enable<modm::platform::Peripheral::Dmamux1>();
+        modm::platform::Rcc::enable<modm::platform::Peripheral::Dma1>();
+
+        dma()->CCR = 0;
+        mux()->CCR = Capture::DmaRequest;
+        dma()->CPAR = Capture::TimerBase + offsetof(TIM_TypeDef, CCR1) + 4 * (Channel - 1);
+        dma()->CMAR = reinterpret_cast<uintptr_t>(ring);
+        dma()->CNDTR = Size;
+        constexpr uint32_t width = (sizeof(Timestamp) == 4) ? 0b10 : 0b01;
+        dma()->CCR = (width * DMA_CCR_MSIZE_0) | (width * DMA_CCR_PSIZE_0) |
+                     DMA_CCR_PL_1 | DMA_CCR_MINC | DMA_CCR_CIRC | DMA_CCR_EN;
+
+        Timer::enableDmaRequest(typename Timer::DmaRequestEnable(uint32_t(TIM_DIER_CC1DE) << (Channel - 1)));
+        Timer::start();
+    }
+
+    /// Counts new edges, call at least once per timer wrap.
+    static void
+    poll()
+    {
+        const size_t position = writePosition();
+        const Timestamp now = Timer::getValue();
+        const size_t added = (position - lastPosition) & (Size - 1);
+        if (added)
+        {
+            edges += added;
+            lastPosition = position;
+            idle = Timestamp(now - ring[(position - 1) & (Size - 1)]);
+        }
+        else if (edges)
+        {
+            // saturates instead of wrapping with the timer
+            const uint32_t step = Timestamp(now - lastPoll);
+            idle = (idle > ~step) ? ~0u : idle + step;
+        }
+        lastPoll = now;
+    }
+
+    /// @return the number of edges seen by poll()
+    static uint32_t
+    getEdgeCount()
+    {
+        return edges;
+    }
+
+    /// @return the ticks between the last edge and the last poll()
+    static uint32_t
+    getIdleTime()
+    {
+        return idle;
+    }
+
+    /// @return the newest `length` timestamps known to poll(), fewer if not available
+    static Span
+    getSpan(size_t length)
+    {
+        if (length > edges) length = edges;
+        if (length > Size) length = Size;
+        return Span(ring, Size, (lastPosition - 1) & (Size - 1), length);
+    }
+
+    static constexpr uint32_t
+    getTickFrequency()
+    {
+        return Capture::TickFrequency;
+    }
+
+private:
+    static TIM_TypeDef*
+    timer()
+    {
+        return reinterpret_cast<TIM_TypeDef*>(Capture::TimerBase);
+    }
+
+    static DMA_Channel_TypeDef*
+    dma()
+    {
+        return reinterpret_cast<DMA_Channel_TypeDef*>(DMA1_Channel1_BASE +
+                (DMA1_Channel2_BASE - DMA1_Channel1_BASE) * (Capture::DmaChannel - 1));
+    }
+
+    static DMAMUX_Channel_TypeDef*
+    mux()
+    {
+        return DMAMUX1_Channel0 + (Capture::DmaChannel - 1);
+    }
+
+    /// @return the index the DMA writes next
+    static size_t
+    writePosition()
+    {
+        return (Size - dma()->CNDTR) & (Size - 1);
+    }
+
+    static inline volatile Timestamp ring[Size];
+    static inline size_t lastPosition{0};
+    static inline Timestamp lastPoll{0};
+    static inline uint32_t edges{0};
+    static inline uint32_t idle{0};
+};
+
+#endif // MODM_OS_HOSTED
+
+#endif // CAPTURE_RING_HPP
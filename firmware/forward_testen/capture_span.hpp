@@ -0,0 +1,117 @@
+#ifndef CAPTURE_SPAN_HPP
+#define CAPTURE_SPAN_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief View of consecutive edge timestamps in a ring buffer.
+ *
+ * Timestamps are timer ticks of the width of `Timestamp`, differences are
+ * taken modulo that width, so the timer has to run free and a single period
+ * must be shorter than one timer wrap. The view reads the ring in place, it
+ * stays valid as long as the writer does not lap the oldest entry.
+ */
+template<typename Timestamp>
+class CaptureSpan
+{
+public:
+    constexpr CaptureSpan() = default;
+
+    /**
+     * @param ring      ring buffer of `Size` entries, `Size` a power of two
+     * @param newest    index of the newest entry
+     */
+    constexpr CaptureSpan(const volatile Timestamp *ring, size_t size, size_t newest, size_t length) :
+        ring(ring), mask(size - 1), newest(newest), length(length)
+    {
+    }
+
+    /// @return the number of timestamps
+    constexpr size_t
+    size() const
+    {
+        return length;
+    }
+
+    /// @return the timestamp `age` edges before the newest one
+    constexpr Timestamp
+    operator[](size_t age) const
+    {
+        return ring[(newest - age) & mask];
+    }
+
+    /// @return ticks between the oldest and the newest edge
+    constexpr uint32_t
+    duration() const
+    {
+        return (length < 2) ? 0 : Timestamp((*this)[0] - (*this)[length - 1]);
+    }
+
+private:
+    const volatile Timestamp *ring{nullptr};
+    size_t mask{0};
+    size_t newest{0};
+    size_t length{0};
+};
+
+/**
+ * Speed estimators over a span of edge timestamps.
+ *
+ * Averaging over several periods instead of using the last one suppresses
+ * the jitter of the FG output, caused by the tolerances of the rotor magnets
+ * and hall sensors, without adding any per-edge work.
+ */
+namespace capture
+{
+    /// @return the mean period of the span in ticks, 0 for less than two edges
+    template<typename Timestamp>
+    constexpr uint32_t
+    period(const CaptureSpan<Timestamp> &span)
+    {
+        return (span.size() < 2) ? 0 : span.duration() / (span.size() - 1);
+    }
+
+    /// @return the mean frequency of the span in mHz, 0 for less than two edges
+    template<typename Timestamp>
+    constexpr uint32_t
+    frequency(const CaptureSpan<Timestamp> &span, uint32_t tickFrequency)
+    {
+        const uint32_t ticks = span.duration();
+        if (ticks == 0) {
+            return 0;
+        }
+        return uint64_t(span.size() - 1) * tickFrequency * 1000 / ticks;
+    }
+
+    /**
+     * @brief Change of frequency over the span in mHz/s.
+     *
+     * Compares the mean frequency of the older and the newer half of the
+     * span, divided by the time between the centers of the two halves.
+     * Needs at least four edges, returns 0 otherwise.
+     */
+    template<typename Timestamp>
+    constexpr int32_t
+    acceleration(const CaptureSpan<Timestamp> &span, uint32_t tickFrequency)
+    {
+        const size_t half = span.size() / 2;
+        if (half < 2) {
+            return 0;
+        }
+        // both halves have `half - 1` periods, the oldest edge is skipped for odd sizes
+        const uint32_t newer = Timestamp(span[0] - span[half - 1]);
+        const uint32_t older = Timestamp(span[half] - span[2 * half - 1]);
+        if (newer == 0 or older == 0) {
+            return 0;
+        }
+        const int64_t periods = half - 1;
+        const int64_t fNewer = periods * tickFrequency * 1000 / newer;
+        const int64_t fOlder = periods * tickFrequency * 1000 / older;
+        // centers of the halves are half a span apart
+        const int64_t distance = (uint64_t(newer) + older) / 2 + Timestamp(span[half - 1] - span[half]);
+        return (fNewer - fOlder) * tickFrequency / distance;
+    }
+}
+
+#endif // CAPTURE_SPAN_HPP
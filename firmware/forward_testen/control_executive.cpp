@@ -0,0 +1,158 @@
+#include "control_executive.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <modm/architecture/interface/atomic_lock.hpp>
+#include <modm/architecture/interface/interrupt.hpp>
+
+using namespace Board;
+
+namespace
+{
+    struct StageTasks
+    {
+        ControlExecutive::Task tasks[ControlExecutive::MaxTasks]{};
+        volatile uint8_t count{0};
+    };
+
+    StageTasks stages[ControlExecutive::Stages];
+    uint16_t divider{1};
+    uint16_t ticks{0};
+    uint32_t frequency{0};
+    uint32_t period{0};
+    uint32_t updatePeriod{0};   ///< CPU cycles between two timer updates
+    uint32_t lastUpdate{0};
+    bool updated{false};
+    uint32_t lastStart{0};
+    bool started{false};
+    ControlExecutive::Statistics statistics{};
+
+    void
+    measure(ControlExecutive::Timing &timing, uint32_t cycles)
+    {
+        timing.cycles = cycles;
+        timing.maxCycles = std::max(timing.maxCycles, cycles);
+    }
+
+    void
+    execute()
+    {
+        const uint32_t start = DWT->CYCCNT;
+        if (started)
+        {
+            const int32_t jitter = int32_t(start - lastStart - period);
+            statistics.minJitter = std::min(statistics.minJitter, jitter);
+            statistics.maxJitter = std::max(statistics.maxJitter, jitter);
+        }
+        lastStart = start;
+        started = true;
+
+        uint32_t begin = start;
+        for (size_t stage = 0; stage < ControlExecutive::Stages; stage++)
+        {
+            for (size_t ii = 0; ii < stages[stage].count; ii++) {
+                stages[stage].tasks[ii]();
+            }
+            const uint32_t end = DWT->CYCCNT;
+            measure(statistics.stages[stage], end - begin);
+            begin = end;
+        }
+
+        measure(statistics.total, begin - start);
+        if (statistics.total.cycles > period) {
+            statistics.overruns++;
+        }
+        statistics.iterations++;
+    }
+}
+
+void
+ControlExecutive::detail::initialize(uint16_t divider, uint32_t frequency)
+{
+    {
+        modm::atomic::Lock lock;
+        ::divider = divider;
+        ::frequency = frequency;
+        period = SystemClock::Frequency / frequency;
+        updatePeriod = period / divider;
+        ticks = 0;
+        updated = false;
+        started = false;
+    }
+    resetStatistics();
+
+    MotorTimer3::enableInterrupt(MotorTimer3::Interrupt::Update);
+    MotorTimer3::enableInterruptVector(true, 5);
+}
+
+bool
+ControlExecutive::add(Stage stage, Task task)
+{
+    modm::atomic::Lock lock;
+    StageTasks &tasks = stages[uint8_t(stage)];
+    if (tasks.count >= MaxTasks) {
+        return false;
+    }
+    tasks.tasks[tasks.count] = task;
+    tasks.count = tasks.count + 1;
+    return true;
+}
+
+uint32_t
+ControlExecutive::getFrequency()
+{
+    return frequency;
+}
+
+uint32_t
+ControlExecutive::getPeriod()
+{
+    return period;
+}
+
+ControlExecutive::Statistics
+ControlExecutive::getStatistics()
+{
+    modm::atomic::Lock lock;
+    return statistics;
+}
+
+void
+ControlExecutive::resetStatistics()
+{
+    modm::atomic::Lock lock;
+    statistics = {};
+    statistics.minJitter = std::numeric_limits<int32_t>::max();
+    statistics.maxJitter = std::numeric_limits<int32_t>::min();
+    started = false;
+}
+
+MODM_ISR(TIM3)
+{
+    const auto flags = MotorTimer3::getInterruptFlags();
+    MotorTimer3::acknowledgeInterruptFlags(flags);
+
+    if (not (flags & MotorTimer3::InterruptFlag::Update)) {
+        return;
+    }
+
+    // Updates while this interrupt was still running or blocked only set the
+    // flag once, count them from the time since the previous one.
+    const uint32_t now = DWT->CYCCNT;
+    uint32_t updates = 1;
+    if (updated) {
+        updates = std::max<uint32_t>(1, (now - lastUpdate + updatePeriod / 2) / updatePeriod);
+    }
+    lastUpdate = now;
+    updated = true;
+    statistics.lostUpdates += updates - 1;
+
+    ticks += updates;
+    if (ticks >= divider)
+    {
+        // keep the phase, a skipped iteration is an overrun
+        statistics.overruns += ticks / divider - 1;
+        ticks %= divider;
+        execute();
+    }
+}
@@ -0,0 +1,97 @@
+#ifndef CONTROL_EXECUTIVE_HPP
+#define CONTROL_EXECUTIVE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "hardware.hpp"
+
+/**
+ * @brief Fixed-rate real-time loop in the update interrupt of MotorTimer3.
+ *
+ * The motor PWM timer updates twice per PWM period, every `divider` updates
+ * the executive runs the registered tasks stage by stage: all sense tasks,
+ * then all estimate tasks and so on, each stage in registration order. The
+ * duty cycles written in the actuate stage are applied with the next PWM
+ * period, so the delay from sensing to actuation is constant.
+ *
+ * Every iteration is measured with the DWT cycle counter: the execution time
+ * of each stage, and the jitter of the period between two iterations. An
+ * iteration which takes longer than the period is an overrun, the next one
+ * is delayed and the overrun counted. Timer updates which pass while the
+ * interrupt runs or is blocked set the update flag only once, they are
+ * recovered from the cycles since the previous update, so the iterations
+ * keep their phase and a skipped iteration counts as an overrun too.
+ */
+namespace ControlExecutive
+{
+    enum class
+    Stage : uint8_t
+    {
+        Sense,
+        Estimate,
+        Control,
+        Actuate,
+    };
+
+    static constexpr size_t Stages = 4;
+    /// Tasks per stage
+    static constexpr size_t MaxTasks = 4;
+
+    using Task = void (*)();
+
+    struct Timing
+    {
+        uint32_t cycles;    ///< CPU cycles of the last iteration
+        uint32_t maxCycles;
+    };
+
+    struct Statistics
+    {
+        uint32_t iterations;
+        uint32_t overruns;
+        uint32_t lostUpdates;   ///< timer updates merged into a later interrupt
+        Timing total;
+        Timing stages[Stages];
+        int32_t minJitter;  ///< CPU cycles, shortest period minus the nominal one
+        int32_t maxJitter;
+    };
+
+    namespace detail
+    {
+        void initialize(uint16_t divider, uint32_t frequency);
+    }
+
+    /**
+     * @brief Sets the loop rate and enables the timer interrupt.
+     *
+     * Call after Board::initialize(), the loop starts right away and runs
+     * the tasks as they are added.
+     *
+     * @tparam Frequency    1 to 10 kHz, must divide the PWM update frequency
+     */
+    template<uint32_t Frequency>
+    void
+    initialize()
+    {
+        static_assert(1'000 <= Frequency and Frequency <= 10'000,
+                      "The control loop runs at 1 to 10 kHz!");
+        static_assert(Board::MotorPwm::UpdateFrequency % Frequency == 0,
+                      "The control frequency must divide the PWM update frequency!");
+        detail::initialize(Board::MotorPwm::UpdateFrequency / Frequency, Frequency);
+    }
+
+    /// @return false if the stage is full
+    bool add(Stage stage, Task task);
+
+    uint32_t getFrequency();
+
+    /// Nominal CPU cycles per iteration, the budget of all stages together
+    uint32_t getPeriod();
+
+    Statistics getStatistics();
+
+    void resetStatistics();
+}
+
+#endif // CONTROL_EXECUTIVE_HPP
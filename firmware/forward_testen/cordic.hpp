@@ -0,0 +1,138 @@
+#ifndef CORDIC_HPP
+#define CORDIC_HPP
+
+#include <cstdint>
+
+#include <modm/platform.hpp>
+#include <modm/architecture/interface/atomic_lock.hpp>
+
+#include "soft_math.hpp"
+
+/**
+ * @brief Trigonometry on the CORDIC coprocessor of the STM32G4.
+ *
+ * Angles are Q1.31 fractions of pi, so the full int32_t range is one turn
+ * and angles wrap around on overflow. Results are Q1.31 as well. The
+ * coprocessor is used in zero-overhead mode: reading the result stalls the
+ * bus until the calculation is done, about 30 cycles for 24 iterations.
+ *
+ * Devices without CORDIC use the equivalent functions from `soft::`, which
+ * agree with the coprocessor to a few LSB.
+ */
+namespace Cordic
+{
+    using SinCos = soft::SinCos;
+
+#ifdef CORDIC
+    namespace detail
+    {
+        enum class
+        Function : uint32_t
+        {
+            Cosine = 0,
+            Phase = 2,
+            Modulus = 3,
+            SquareRoot = 9,
+        };
+
+        /// 24 iterations, one result, 32 bit arguments and results
+        constexpr uint32_t
+        config(Function function, bool twoArguments, bool twoResults = false, uint32_t scale = 0)
+        {
+            return (uint32_t(function) << CORDIC_CSR_FUNC_Pos) | (6 << CORDIC_CSR_PRECISION_Pos) |
+                   (scale << CORDIC_CSR_SCALE_Pos) | (twoResults ? CORDIC_CSR_NRES : 0) |
+                   (twoArguments ? CORDIC_CSR_NARGS : 0);
+        }
+    }
+
+    inline void
+    initialize()
+    {
+        modm::platform::Rcc::enable<modm::platform::Peripheral::Cordic>();
+    }
+
+    inline SinCos
+    sincos(int32_t angle)
+    {
+        constexpr uint32_t Config = detail::config(detail::Function::Cosine, true, true);
+
+        modm::atomic::Lock lock;
+        CORDIC->CSR = Config;
+        CORDIC->WDATA = angle;
+        CORDIC->WDATA = 0x7fffffff;     // modulus 1
+        const int32_t cos = CORDIC->RDATA;
+        const int32_t sin = CORDIC->RDATA;
+        return {sin, cos};
+    }
+
+    /// @return the angle of (x, y) as Q1.31 fraction of pi
+    inline int32_t
+    atan2(int32_t y, int32_t x)
+    {
+        constexpr uint32_t Config = detail::config(detail::Function::Phase, true);
+
+        // the modulus must stay below 1, halving both keeps the angle
+        modm::atomic::Lock lock;
+        CORDIC->CSR = Config;
+        CORDIC->WDATA = x >> 1;
+        CORDIC->WDATA = y >> 1;
+        return CORDIC->RDATA;
+    }
+
+    /// @return sqrt(x^2 + y^2), saturated to Q1.31
+    inline int32_t
+    hypot(int32_t x, int32_t y)
+    {
+        constexpr uint32_t Config = detail::config(detail::Function::Modulus, true);
+
+        int32_t half;
+        {
+            modm::atomic::Lock lock;
+            CORDIC->CSR = Config;
+            CORDIC->WDATA = x >> 1;
+            CORDIC->WDATA = y >> 1;
+            half = CORDIC->RDATA;
+        }
+        return (half >= (1 << 30)) ? INT32_MAX : half * 2;
+    }
+
+    /// @return the square root of a non-negative Q1.31 value, 0 for negative ones
+    inline int32_t
+    sqrt(int32_t x)
+    {
+        if (x <= 0) {
+            return 0;
+        }
+        // the coprocessor converges for 0.027 <= x < 0.75 with scale 0 and up
+        // to 1.75 with scale 1, so normalize to [0.25, 1) by powers of four
+        const uint32_t shift = (__builtin_clz(x) - 1) / 2;
+        const int32_t normal = x << (2 * shift);
+        const bool scaled = normal >= 0x6000'0000;
+
+        int32_t root;
+        {
+            modm::atomic::Lock lock;
+            CORDIC->CSR = scaled ? detail::config(detail::Function::SquareRoot, false, false, 1) :
+                                   detail::config(detail::Function::SquareRoot, false);
+            CORDIC->WDATA = scaled ? (normal >> 1) : normal;
+            root = CORDIC->RDATA;
+        }
+        if (scaled) {
+            root = (root >= (1 << 30)) ? INT32_MAX : root * 2;
+        }
+        return root >> shift;
+    }
+#else
+    inline void
+    initialize()
+    {
+    }
+
+    using soft::sincos;
+    using soft::atan2;
+    using soft::hypot;
+    using soft::sqrt;
+#endif
+}
+
+#endif // CORDIC_HPP
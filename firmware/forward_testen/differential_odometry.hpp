@@ -0,0 +1,120 @@
+#ifndef DIFFERENTIAL_ODOMETRY_HPP
+#define DIFFERENTIAL_ODOMETRY_HPP
+
+#include <cstdint>
+
+/**
+ * @brief Pose of a differential-drive robot integrated from wheel edges.
+ *
+ * Every update() takes the signed tacho edges of both wheels since the last
+ * call, the arc between the two poses is approximated by a straight segment
+ * in the direction of the mean heading (midpoint rule). The position is kept
+ * in micrometers with 16 fractional bits and the heading as Q1.31 fraction
+ * of pi, so it wraps around by itself. All arithmetic is integer and the
+ * trigonometry comes from `SinCos`, so a replay of the same edges gives the
+ * same pose on the target and on the host.
+ *
+ * `SinCos` takes a Q1.31 angle and returns a struct with Q1.31 `sin` and
+ * `cos` members, like `Cordic::sincos()`.
+ */
+template<auto SinCos>
+class DifferentialOdometry
+{
+public:
+    struct Geometry
+    {
+        uint32_t distancePerEdge = 1000;    ///< um of wheel travel per tacho edge
+        uint32_t trackWidth = 150'000;      ///< um between the wheel contact points
+    };
+
+    struct Pose
+    {
+        int32_t x;          ///< um
+        int32_t y;          ///< um
+        int32_t heading;    ///< Q1.31 fraction of pi, counterclockwise from x
+    };
+
+    DifferentialOdometry()
+    {
+        setGeometry(Geometry());
+    }
+
+    explicit DifferentialOdometry(const Geometry &geometry)
+    {
+        setGeometry(geometry);
+    }
+
+    void
+    setGeometry(const Geometry &geometry)
+    {
+        distancePerEdge = geometry.distancePerEdge;
+        // 2^31 / pi per radian, 16 fractional bits
+        headingPerEdge = int64_t(double(geometry.distancePerEdge) / geometry.trackWidth *
+                                 683565275.57643158 * 65536);
+    }
+
+    void
+    reset(const Pose &pose = Pose())
+    {
+        x = int64_t(pose.x) << 16;
+        y = int64_t(pose.y) << 16;
+        heading = pose.heading;
+    }
+
+    /// @param left,right   edges since the last call, negative backwards
+    void
+    update(int32_t left, int32_t right)
+    {
+        if (left == 0 and right == 0) {
+            return;
+        }
+        const int32_t turn = (int64_t(right - left) * headingPerEdge) >> 16;
+        const auto [sin, cos] = SinCos(wrap(heading, turn / 2));
+        // twice the travel in um, Q1.31 to Q16 and the halving in one shift
+        const int64_t travel = int64_t(left + right) * distancePerEdge;
+        x += (travel * cos) >> 16;
+        y += (travel * sin) >> 16;
+        heading = wrap(heading, turn);
+    }
+
+    /**
+     * @brief Complementary correction from a distance measured along the heading.
+     *
+     * Shifts the position along the heading by a fraction of the difference
+     * between the measured distance to a known wall in front and the one
+     * predicted from the current pose and a map, both in um.
+     *
+     * @param gain  weight of the measurement as Q15, 0 ignores it
+     */
+    void
+    correct(int32_t measured, int32_t predicted, uint16_t gain)
+    {
+        // a wall farther away than predicted means the robot is behind its estimate
+        const int64_t shift = (int64_t(predicted - measured) * gain) >> 15;
+        const auto [sin, cos] = SinCos(heading);
+        x += (shift * cos) >> 15;
+        y += (shift * sin) >> 15;
+    }
+
+    Pose
+    getPose() const
+    {
+        return {int32_t(x >> 16), int32_t(y >> 16), heading};
+    }
+
+private:
+    /// Adds angles modulo one turn, signed overflow is undefined
+    static constexpr int32_t
+    wrap(int32_t angle, int32_t delta)
+    {
+        return int32_t(uint32_t(angle) + uint32_t(delta));
+    }
+
+    int64_t x{0};               ///< um, 16 fractional bits
+    int64_t y{0};
+    int32_t heading{0};
+    int32_t distancePerEdge{1000};
+    int64_t headingPerEdge{0};  ///< Q1.31 per edge difference, 16 fractional bits
+};
+
+#endif // DIFFERENTIAL_ODOMETRY_HPP
@@ -0,0 +1,134 @@
+#include "edge_capture.hpp"
+#include "hardware.hpp"
+
+#include <bit>
+#include <modm/architecture/driver/atomic/queue.hpp>
+#include <modm/architecture/interface/atomic_lock.hpp>
+#include <modm/architecture/interface/interrupt.hpp>
+
+namespace
+{
+    modm::atomic::Queue<EdgeCapture::Edge, EdgeCapture::Capacity> queue;
+    bool (*readers[16])() {};
+    volatile uint32_t registered{0};
+    volatile uint32_t overruns{0};
+
+    constexpr IRQn_Type
+    toInterrupt(uint8_t line)
+    {
+        if (line <= 4) {
+            return IRQn_Type(EXTI0_IRQn + line);
+        }
+        return (line <= 9) ? EXTI9_5_IRQn : EXTI15_10_IRQn;
+    }
+
+    /// Lines with a vector of their own here, the others come from the FaultMonitor.
+    template<uint32_t Lines>
+    void
+    stamp()
+    {
+        const uint32_t cycles = DWT->CYCCNT;
+        EdgeCapture::capture(EXTI->PR1 & Lines, cycles);
+    }
+}
+
+bool
+EdgeCapture::detail::add(uint8_t line, uint8_t port, bool (*read)(), Trigger trigger, uint8_t priority)
+{
+    const uint32_t bit = 1ul << line;
+    const uint32_t shift = 4 * (line % 4);
+    const bool rising = uint8_t(trigger) & uint8_t(Trigger::Rising);
+    const bool falling = uint8_t(trigger) & uint8_t(Trigger::Falling);
+    const IRQn_Type interrupt = toInterrupt(line);
+
+    modm::atomic::Lock lock;
+    if (not isForwarded(line) and NVIC_GetEnableIRQ(interrupt) and NVIC_GetPriority(interrupt) != priority) {
+        return false;
+    }
+    if (EXTI->IMR1 & bit)
+    {
+        // already enabled, by the FaultMonitor or an earlier add()
+        if (((SYSCFG->EXTICR[line / 4] >> shift) & 0xf) != port or
+            bool(EXTI->RTSR1 & bit) != rising or bool(EXTI->FTSR1 & bit) != falling) {
+            return false;
+        }
+    }
+    else
+    {
+        RCC->APB2ENR |= RCC_APB2ENR_SYSCFGEN;
+        SYSCFG->EXTICR[line / 4] = (SYSCFG->EXTICR[line / 4] & ~(0xfu << shift)) | (uint32_t(port) << shift);
+        EXTI->RTSR1 = rising ? (EXTI->RTSR1 | bit) : (EXTI->RTSR1 & ~bit);
+        EXTI->FTSR1 = falling ? (EXTI->FTSR1 | bit) : (EXTI->FTSR1 & ~bit);
+        EXTI->PR1 = bit;
+        EXTI->IMR1 |= bit;
+    }
+    readers[line] = read;
+    registered |= bit;
+
+    if (not isForwarded(line)) {
+        NVIC_SetPriority(interrupt, priority);
+    }
+    NVIC_EnableIRQ(interrupt);
+    return true;
+}
+
+size_t
+EdgeCapture::read(std::span<Edge> edges)
+{
+    size_t count = 0;
+    while (count < edges.size() and not queue.isEmpty())
+    {
+        edges[count++] = queue.get();
+        queue.pop();
+    }
+    return count;
+}
+
+uint32_t
+EdgeCapture::getOverruns()
+{
+    return overruns;
+}
+
+void
+EdgeCapture::capture(uint32_t pending, uint32_t cycles)
+{
+    pending &= registered;
+    EXTI->PR1 = pending;
+    while (pending)
+    {
+        const uint8_t line = std::countr_zero(pending);
+        pending &= pending - 1;
+        const Edge edge{cycles, line, readers[line]()};
+        // the lines preempt each other, only one of them may push at a time
+        modm::atomic::Lock lock;
+        if (not queue.push(edge)) {
+            overruns = overruns + 1;
+        }
+    }
+}
+
+MODM_ISR(EXTI0)
+{
+    stamp<1ul << 0>();
+}
+
+MODM_ISR(EXTI2)
+{
+    stamp<1ul << 2>();
+}
+
+MODM_ISR(EXTI3)
+{
+    stamp<1ul << 3>();
+}
+
+MODM_ISR(EXTI4)
+{
+    stamp<1ul << 4>();
+}
+
+MODM_ISR(EXTI15_10)
+{
+    stamp<0xfc00>();
+}
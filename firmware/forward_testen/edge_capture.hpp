@@ -0,0 +1,92 @@
+#ifndef EDGE_CAPTURE_HPP
+#define EDGE_CAPTURE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/**
+ * @brief Timestamps of GPIO edges from the EXTI lines.
+ *
+ * The interrupt of the EXTI line of a registered pin stamps each edge with
+ * the DWT cycle counter, reads the pin and appends both to a lock-free
+ * queue, nothing else runs in it. A fiber takes the edges in batches with
+ * read() later. The counter runs at the CPU clock, 5.9 ns per cycle, and
+ * wraps after 25 s, so differences are taken modulo 2^32.
+ *
+ * The vectors of the lines 1 and 5 to 9 belong to the FaultMonitor, they
+ * keep its highest priority and it forwards them to capture() after the
+ * shutdown. Its nFAULT lines may be registered with their falling trigger
+ * and FaultPriority, and each FaultMonitor::selfTest() adds an edge at high
+ * level. Other pins on these lines would run at the nFAULT priority, so
+ * add() refuses them at compile time. The other vectors run at the priority
+ * given to add(), below the nFAULT, the lines 10 to 15 share one. As the
+ * interrupts preempt each other, each push into the queue is a short
+ * critical section.
+ */
+namespace EdgeCapture
+{
+    enum class
+    Trigger : uint8_t
+    {
+        Rising  = 0b01,
+        Falling = 0b10,
+        Both    = 0b11,
+    };
+
+    struct Edge
+    {
+        uint32_t cycles;    ///< DWT cycle counter at the interrupt entry
+        uint8_t line;       ///< EXTI line, the pin number
+        bool level;         ///< pin level in the interrupt
+    };
+
+    /// Edges in the queue, about 1 KiB
+    static constexpr size_t Capacity = 128;
+    /// Interrupt priority of the lines with a vector of their own, below the nFAULT
+    static constexpr uint8_t DefaultPriority = 2;
+    /// Interrupt priority of the nFAULT vectors of the FaultMonitor
+    static constexpr uint8_t FaultPriority = 0;
+
+    /// @return true for the lines 1 and 5 to 9, which share the vectors of the FaultMonitor
+    constexpr bool
+    isForwarded(uint8_t line)
+    {
+        return line == 1 or (5 <= line and line <= 9);
+    }
+
+    namespace detail
+    {
+        bool add(uint8_t line, uint8_t port, bool (*read)(), Trigger trigger, uint8_t priority);
+    }
+
+    /**
+     * @brief Routes the EXTI line of the pin to its port and enables it.
+     *
+     * Call after FaultMonitor::initialize(). The lines 1 and 5 to 9 of its
+     * vectors only take FaultPriority, which they have already.
+     *
+     * @return false if the line is used by another pin or with another trigger,
+     *         or if the shared vector of the lines 10 to 15 has another priority
+     */
+    template<class Pin, uint8_t Priority = DefaultPriority>
+    bool
+    add(Trigger trigger = Trigger::Both)
+    {
+        static_assert(not isForwarded(Pin::pin) or Priority == FaultPriority,
+                      "The line shares an nFAULT vector, its edges would run at the fault priority!");
+        return detail::add(Pin::pin, uint8_t(Pin::port), Pin::read, trigger, Priority);
+    }
+
+    /// Moves the oldest edges into `edges`.
+    /// @return the number of edges moved
+    size_t read(std::span<Edge> edges);
+
+    /// @return the number of edges lost to a full queue
+    uint32_t getOverruns();
+
+    /// Stamps and acknowledges the registered lines of the `pending` mask, called by the EXTI interrupts.
+    void capture(uint32_t pending, uint32_t cycles);
+}
+
+#endif // EDGE_CAPTURE_HPP
@@ -0,0 +1,205 @@
+#include "fault_monitor.hpp"
+#include "hardware.hpp"
+#include "motor_control.hpp"
+#include "edge_capture.hpp"
+
+#include <algorithm>
+#include <modm/architecture/interface/atomic_lock.hpp>
+#include <modm/architecture/interface/interrupt.hpp>
+#include <modm/processing/fiber.hpp>
+
+using namespace Board;
+
+namespace
+{
+    constexpr uint32_t Line1 = 1u << M1_Fault::pin;
+    constexpr uint32_t Line2 = 1u << M2_Fault::pin;
+
+    volatile bool latched{false};
+    volatile bool testing{false};
+    volatile uint32_t testStart{0};
+    FaultMonitor::Fault fault{};
+    FaultMonitor::Statistics statistics{};
+    volatile modm::fiber::id waiter{0};
+
+    /// Routes the EXTI line of a pin to its port.
+    template<class Pin>
+    void
+    route()
+    {
+        constexpr uint32_t shift = 4 * (Pin::pin % 4);
+        SYSCFG->EXTICR[Pin::pin / 4] = (SYSCFG->EXTICR[Pin::pin / 4] & ~(0xfu << shift)) |
+                                       (uint32_t(Pin::port) << shift);
+    }
+
+    /// @return the Source bits of the nFAULT inputs which are low
+    uint8_t
+    readSources()
+    {
+        return (M1_Fault::read() ? 0 : FaultMonitor::Motor1) |
+               (M2_Fault::read() ? 0 : FaultMonitor::Motor2);
+    }
+
+    /// Keeps the first fault and wakes the waiter, the outputs are already cut.
+    void
+    latch(uint8_t sources, uint32_t cycles)
+    {
+        MotorControl::disable();
+        if (not latched)
+        {
+            fault.sources = sources;
+            fault.time = modm::Clock::now();
+            fault.cycles = cycles;
+            latched = true;
+        }
+        if (waiter) {
+            modm::fiber::resume(waiter);
+        }
+    }
+
+    void
+    trip()
+    {
+        // first cut the outputs, everything else can wait
+        MotorPwm::forceInactive();
+        const uint32_t cycles = DWT->CYCCNT;
+        M1_Sleep::reset();
+        M2_Sleep::reset();
+
+        if (testing)
+        {
+            testing = false;
+            statistics.reaction = cycles - testStart;
+            statistics.maxReaction = std::max(statistics.maxReaction, statistics.reaction);
+            statistics.selfTests++;
+            return;
+        }
+        latch(readSources(), cycles);
+    }
+}
+
+void
+FaultMonitor::initialize()
+{
+    RCC->APB2ENR |= RCC_APB2ENR_SYSCFGEN;
+    route<M1_Fault>();
+    route<M2_Fault>();
+
+    // nFAULT is active low
+    EXTI->FTSR1 |= Line1 | Line2;
+    EXTI->PR1 = Line1 | Line2;
+    EXTI->IMR1 |= Line1 | Line2;
+
+    NVIC_SetPriority(EXTI9_5_IRQn, EdgeCapture::FaultPriority);
+    NVIC_SetPriority(EXTI1_IRQn, EdgeCapture::FaultPriority);
+    NVIC_EnableIRQ(EXTI9_5_IRQn);
+    NVIC_EnableIRQ(EXTI1_IRQn);
+
+    // an edge before the interrupt was enabled is lost
+    if (not M1_Fault::read() or not M2_Fault::read()) {
+        EXTI->SWIER1 = Line1;
+    }
+}
+
+bool
+FaultMonitor::isLatched()
+{
+    return latched;
+}
+
+FaultMonitor::Fault
+FaultMonitor::getFault()
+{
+    modm::atomic::Lock lock;
+    return fault;
+}
+
+bool
+FaultMonitor::clear()
+{
+    modm::atomic::Lock lock;
+    // without a working interrupt nFAULT could not stop the motors
+    if (readSources() or (fault.sources & SelfTest)) {
+        return false;
+    }
+    latched = false;
+    fault = Fault();
+    MotorPwm::setCompare(0, 0);
+    MotorPwm::release();
+    return true;
+}
+
+void
+FaultMonitor::wait()
+{
+    waiter = modm::this_fiber::get_id();
+    while (not latched) {
+        modm::this_fiber::suspend();
+    }
+    waiter = 0;
+}
+
+uint32_t
+FaultMonitor::selfTest()
+{
+    // the reaction takes a few hundred cycles, a line silent for 1 ms is dead
+    constexpr uint32_t Timeout = SystemClock::Frequency / 1000;
+
+    const bool sleep1 = M1_Sleep::isSet();
+    const bool sleep2 = M2_Sleep::isSet();
+    testing = true;
+    testStart = DWT->CYCCNT;
+    EXTI->SWIER1 = Line1;
+    while (testing and DWT->CYCCNT - testStart < Timeout) {}
+
+    modm::atomic::Lock lock;
+    if (testing)
+    {
+        // nothing cut the outputs, nFAULT would not either
+        testing = false;
+        MotorPwm::forceInactive();
+        M1_Sleep::reset();
+        M2_Sleep::reset();
+        latch(SelfTest, DWT->CYCCNT);
+        return 0;
+    }
+    // a real nFAULT during the test was taken for the test interrupt
+    if (const uint8_t sources = readSources()) {
+        latch(sources, DWT->CYCCNT);
+    }
+    if (not latched)
+    {
+        MotorPwm::release();
+        M1_Sleep::set(sleep1);
+        M2_Sleep::set(sleep2);
+    }
+    return statistics.reaction;
+}
+
+FaultMonitor::Statistics
+FaultMonitor::getStatistics()
+{
+    modm::atomic::Lock lock;
+    return statistics;
+}
+
+// The vectors are shared with the EdgeCapture, the shutdown goes first.
+MODM_ISR(EXTI9_5)
+{
+    const uint32_t cycles = DWT->CYCCNT;
+    const uint32_t pending = EXTI->PR1 & 0x3e0;
+    if (pending & Line1)
+    {
+        EXTI->PR1 = Line1;
+        trip();
+    }
+    EdgeCapture::capture(pending, cycles);
+}
+
+MODM_ISR(EXTI1)
+{
+    const uint32_t cycles = DWT->CYCCNT;
+    EXTI->PR1 = Line2;
+    trip();
+    EdgeCapture::capture(Line2, cycles);
+}
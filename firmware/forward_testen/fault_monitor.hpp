@@ -0,0 +1,85 @@
+#ifndef FAULT_MONITOR_HPP
+#define FAULT_MONITOR_HPP
+
+#include <cstdint>
+
+#include <modm/architecture/interface/clock.hpp>
+
+/**
+ * @brief Fast shutdown on the nFAULT outputs of the MCT8314Z drivers.
+ *
+ * A falling edge on M1_Fault (PA6, EXTI6) or M2_Fault (PF1, EXTI1) enters
+ * an interrupt with the highest priority, which forces both PWM outputs low
+ * and puts both drivers to sleep, before anything else. The motor timers
+ * 2 and 3 have no break input, so this cannot be done by the timer itself.
+ *
+ * The first fault is latched with its sources and time, the motors stay off
+ * until clear(). A supervisory fiber blocked in wait() is resumed.
+ *
+ * The reaction time is measured by selfTest(): it triggers the interrupt by
+ * software and counts the CPU cycles until the outputs are forced, which
+ * includes the interrupt entry. Sections with disabled interrupts, e.g.
+ * MotorPwm::setCompare(), add to it, so the maximum over many self tests
+ * is reported.
+ */
+namespace FaultMonitor
+{
+    enum
+    Source : uint8_t
+    {
+        Motor1 = 0b01,
+        Motor2 = 0b10,
+        SelfTest = 0b100,   ///< the self test interrupt did not arrive
+    };
+
+    struct Fault
+    {
+        uint8_t sources;                ///< Source bits, 0 if the pin was high again
+        modm::Clock::time_point time;
+        uint32_t cycles;                ///< DWT cycle counter at the shutdown
+    };
+
+    struct Statistics
+    {
+        uint32_t selfTests;
+        uint32_t reaction;      ///< CPU cycles of the last self test
+        uint32_t maxReaction;
+    };
+
+    /// Call after Board::initialize(), latches at once if a driver already reports a fault.
+    void initialize();
+
+    bool isLatched();
+
+    /// @return the latched fault
+    Fault getFault();
+
+    /**
+     * @brief Releases the latch and the PWM outputs.
+     *
+     * The drivers stay asleep and the motors disabled until the next command.
+     *
+     * @return false if an nFAULT input is still low or the self test failed
+     */
+    bool clear();
+
+    /// Suspends the calling fiber until a fault is latched.
+    void wait();
+
+    /**
+     * @brief Measures the reaction time through the real shutdown path.
+     *
+     * Cuts the motor outputs for a moment, run it while the motors are off.
+     * An nFAULT input which is low after the test is latched as a fault,
+     * since its interrupt was taken for the test. If the interrupt does not
+     * arrive within 1 ms, the outputs are cut by software and the fault
+     * latched with the SelfTest source.
+     *
+     * @return CPU cycles from the trigger to the forced outputs, 0 on a timeout
+     */
+    uint32_t selfTest();
+
+    Statistics getStatistics();
+}
+
+#endif // FAULT_MONITOR_HPP
@@ -0,0 +1,129 @@
+#include "flash_record.hpp"
+
+#include <modm/platform.hpp>
+#include <modm/architecture/interface/atomic_lock.hpp>
+
+// end of the firmware image, provided by the linker script
+extern "C" const uint8_t __rom_end[];
+
+namespace
+{
+    constexpr uint32_t Key1 = 0x4567'0123;
+    constexpr uint32_t Key2 = 0xCDEF'89AB;
+
+    constexpr uint32_t ErrorFlags = FLASH_SR_OPERR | FLASH_SR_PROGERR | FLASH_SR_WRPERR |
+                                    FLASH_SR_PGAERR | FLASH_SR_SIZERR | FLASH_SR_PGSERR |
+                                    FLASH_SR_MISERR | FLASH_SR_FASTERR;
+
+    // Bank 2 of the 512 KiB device in dual-bank mode
+    constexpr uintptr_t Bank2Address = FLASH_BASE + 256 * 1024;
+
+    bool
+    isDualBank()
+    {
+        return FLASH->OPTR & FLASH_OPTR_DBANK;
+    }
+
+    size_t
+    pageSize()
+    {
+        return isDualBank() ? 2048 : 4096;
+    }
+
+    void
+    unlockFlash()
+    {
+        if (FLASH->CR & FLASH_CR_LOCK) {
+            FLASH->KEYR = Key1;
+            FLASH->KEYR = Key2;
+        }
+    }
+
+    void
+    lockFlash()
+    {
+        FLASH->CR |= FLASH_CR_LOCK;
+    }
+
+    /// Waits for the current operation and clears its status flags.
+    bool
+    finishOperation()
+    {
+        while (FLASH->SR & FLASH_SR_BSY) {}
+        const uint32_t status = FLASH->SR;
+        FLASH->SR = status & (ErrorFlags | FLASH_SR_EOP);
+        return (status & ErrorFlags) == 0;
+    }
+
+    /// Discards cached lines of erased or reprogrammed flash (RM0440 3.3.3).
+    /// The caches can only be reset while they are disabled.
+    void
+    resetCaches()
+    {
+        const uint32_t enabled = FLASH->ACR & (FLASH_ACR_DCEN | FLASH_ACR_ICEN);
+        FLASH->ACR &= ~(FLASH_ACR_DCEN | FLASH_ACR_ICEN);
+        FLASH->ACR |= FLASH_ACR_DCRST | FLASH_ACR_ICRST;
+        FLASH->ACR &= ~(FLASH_ACR_DCRST | FLASH_ACR_ICRST);
+        FLASH->ACR |= enabled;
+    }
+}
+
+bool
+flash::erasePage(uintptr_t address)
+{
+    const uintptr_t page = address & ~(pageSize() - 1);
+    if (page < reinterpret_cast<uintptr_t>(__rom_end)) {
+        return false;
+    }
+
+    uint32_t bank = 0;
+    uint32_t index = (page - FLASH_BASE) / pageSize();
+    if (isDualBank() and page >= Bank2Address) {
+        bank = FLASH_CR_BKER;
+        index = (page - Bank2Address) / pageSize();
+    }
+
+    unlockFlash();
+    bool success = finishOperation();
+    if (success) {
+        FLASH->CR = (FLASH->CR & ~(FLASH_CR_PNB | FLASH_CR_BKER | FLASH_CR_PG)) |
+                    FLASH_CR_PER | bank | (index << FLASH_CR_PNB_Pos);
+        FLASH->CR |= FLASH_CR_STRT;
+        success = finishOperation();
+        FLASH->CR &= ~(FLASH_CR_PER | FLASH_CR_PNB | FLASH_CR_BKER);
+        resetCaches();
+    }
+    lockFlash();
+    return success;
+}
+
+bool
+flash::program(uintptr_t address, const void *data, size_t length)
+{
+    if (address % 8) {
+        return false;
+    }
+
+    const auto *source = static_cast<const uint8_t *>(data);
+    unlockFlash();
+    bool success = finishOperation();
+    FLASH->CR |= FLASH_CR_PG;
+    for (size_t offset = 0; success and offset < length; offset += 8)
+    {
+        uint32_t words[2] = {0xFFFF'FFFF, 0xFFFF'FFFF};
+        std::memcpy(words, source + offset, (length - offset) < 8 ? (length - offset) : 8);
+
+        auto *target = reinterpret_cast<volatile uint32_t *>(address + offset);
+        {
+            // both words must be written back to back
+            modm::atomic::Lock lock;
+            target[0] = words[0];
+            target[1] = words[1];
+        }
+        success = finishOperation();
+    }
+    FLASH->CR &= ~FLASH_CR_PG;
+    resetCaches();
+    lockFlash();
+    return success;
+}
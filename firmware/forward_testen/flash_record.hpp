@@ -0,0 +1,105 @@
+#ifndef FLASH_RECORD_HPP
+#define FLASH_RECORD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <modm/math/utils/crc.hpp>
+
+namespace flash
+{
+    /// Last 2 KiB of the 512 KiB flash, kept free for persistent records.
+    static constexpr uintptr_t RecordAddress = 0x0807'F800;
+    static constexpr size_t RecordSize = 2048;
+
+    /**
+     * @brief Erases the flash page containing the given address.
+     *
+     * Refuses to erase pages overlapping the firmware image.
+     */
+    bool erasePage(uintptr_t address);
+
+    /**
+     * @brief Programs data into erased flash in 64-bit double words.
+     *
+     * The address must be 8-byte aligned, a trailing partial double word is
+     * padded with 0xFF.
+     */
+    bool program(uintptr_t address, const void *data, size_t length);
+}
+
+/**
+ * @brief Stores a single trivially copyable object in a dedicated flash area.
+ *
+ * The object is saved together with a magic number, a format version and its
+ * size, all protected by a CRC32. load() rejects erased, outdated and
+ * corrupted records, so callers can simply fall back to defaults.
+ */
+template<typename T, uint16_t Version, uintptr_t Address = flash::RecordAddress>
+class FlashRecord
+{
+    static_assert(std::is_trivially_copyable_v<T>, "FlashRecord requires a trivially copyable type!");
+
+    static constexpr uint32_t Magic = 0x5349'4D41; // "SIMA"
+
+    struct alignas(8) Image
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t length;
+        T payload;
+        uint32_t crc;
+    };
+    static_assert(sizeof(Image) <= flash::RecordSize, "Record does not fit into the flash area!");
+
+    static uint32_t
+    checksum(const Image &image)
+    {
+        return modm::math::crc32(reinterpret_cast<const uint8_t *>(&image), offsetof(Image, crc));
+    }
+
+public:
+    /// @return true if a valid record was found and copied into `value`.
+    static bool
+    load(T &value)
+    {
+        const Image &image = *reinterpret_cast<const Image *>(Address);
+        if (image.magic != Magic or image.version != Version or image.length != sizeof(T)) {
+            return false;
+        }
+        if (image.crc != checksum(image)) {
+            return false;
+        }
+        std::memcpy(&value, &image.payload, sizeof(T));
+        return true;
+    }
+
+    /// Replaces the stored record and verifies it by reading it back.
+    static bool
+    store(const T &value)
+    {
+        Image image;
+        std::memset(&image, 0, sizeof(image));
+        image.magic = Magic;
+        image.version = Version;
+        image.length = sizeof(T);
+        std::memcpy(&image.payload, &value, sizeof(T));
+        image.crc = checksum(image);
+
+        if (not flash::erasePage(Address) or not flash::program(Address, &image, sizeof(image))) {
+            return false;
+        }
+        return std::memcmp(reinterpret_cast<const void *>(Address), &image, sizeof(image)) == 0;
+    }
+
+    /// Erases the record, so the next load() fails.
+    static bool
+    invalidate()
+    {
+        return flash::erasePage(Address);
+    }
+};
+
+#endif // FLASH_RECORD_HPP
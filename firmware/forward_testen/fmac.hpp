@@ -0,0 +1,248 @@
+#ifndef FMAC_HPP
+#define FMAC_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <modm/platform.hpp>
+
+#include "soft_math.hpp"
+
+/**
+ * @brief FIR and IIR filters over sample buffers on the FMAC of the STM32G4.
+ *
+ * Samples and coefficients are Q1.15, the accumulator has 26 bits, the sum
+ * is shifted left by `gain` and saturated. The filters keep their history in
+ * RAM between process() calls, every call loads it together with the
+ * coefficients into the FMAC, so several filters can share the one unit.
+ * Loading costs about one bus access per tap, process() pays off from a few
+ * samples per call. Not reentrant, only call process() from one fiber.
+ *
+ * Devices without FMAC use `soft::Fir` and `soft::Iir`, which give the same
+ * results as long as the 26 bit accumulator of the FMAC does not overflow.
+ */
+namespace Fmac
+{
+#ifdef FMAC
+    namespace detail
+    {
+        enum class
+        Function : uint32_t
+        {
+            LoadX1 = 1,
+            LoadX2 = 2,
+            LoadY = 3,
+            Fir = 8,
+            Iir = 9,
+        };
+
+        /// Space for new samples beyond the history in X1 and Y
+        inline constexpr uint32_t Headroom = 2;
+        inline constexpr uint32_t Memory = 256;
+
+        inline void
+        initialize()
+        {
+            modm::platform::Rcc::enable<modm::platform::Peripheral::Fmac>();
+        }
+
+        inline void
+        start(Function function, uint32_t p, uint32_t q = 0, uint32_t r = 0)
+        {
+            FMAC->PARAM = FMAC_PARAM_START | (uint32_t(function) << FMAC_PARAM_FUNC_Pos) |
+                          (r << FMAC_PARAM_R_Pos) | (q << FMAC_PARAM_Q_Pos) | (p << FMAC_PARAM_P_Pos);
+        }
+
+        /// Loads `values` into a buffer, the load stops by itself after `count` writes.
+        inline void
+        load(Function function, const int16_t *values, uint32_t count, uint32_t q = 0)
+        {
+            if (count + q == 0) {
+                return;
+            }
+            start(function, count, q);
+            for (uint32_t ii = 0; ii < count + q; ii++) {
+                FMAC->WDATA = uint16_t(values[ii]);
+            }
+        }
+
+        /// Runs the started filter over the samples, writing and reading as space allows.
+        inline void
+        stream(const int16_t *input, int16_t *output, size_t length)
+        {
+            size_t written = 0, read = 0;
+            while (read < length)
+            {
+                if (written < length and not (FMAC->SR & FMAC_SR_X1FULL)) {
+                    FMAC->WDATA = uint16_t(input[written++]);
+                }
+                if (not (FMAC->SR & FMAC_SR_YEMPTY)) {
+                    output[read++] = int16_t(FMAC->RDATA);
+                }
+            }
+            FMAC->PARAM = 0;
+        }
+
+        /// Appends the newest samples to a history with the oldest first.
+        template<size_t Size>
+        void
+        remember(std::array<int16_t, Size> &history, size_t used, const int16_t *samples, size_t length)
+        {
+            if (used == 0) {
+                return;
+            }
+            if (length >= used) {
+                std::copy(samples + length - used, samples + length, history.begin());
+            } else {
+                std::copy(history.begin() + length, history.begin() + used, history.begin());
+                std::copy(samples, samples + length, history.begin() + used - length);
+            }
+        }
+
+        /**
+         * Resets the FMAC and splits its memory into X1 for the inputs, X2
+         * for the coefficients and Y for the outputs, in that order.
+         */
+        inline void
+        configure(uint32_t x1, uint32_t x2, uint32_t y)
+        {
+            FMAC->CR = FMAC_CR_RESET;
+            while (FMAC->CR & FMAC_CR_RESET) ;
+            FMAC->X1BUFCFG = (x1 << FMAC_X1BUFCFG_X1_BUF_SIZE_Pos) | (0 << FMAC_X1BUFCFG_X1_BASE_Pos);
+            FMAC->X2BUFCFG = (x2 << FMAC_X2BUFCFG_X2_BUF_SIZE_Pos) | (x1 << FMAC_X2BUFCFG_X2_BASE_Pos);
+            FMAC->YBUFCFG = (y << FMAC_YBUFCFG_Y_BUF_SIZE_Pos) | ((x1 + x2) << FMAC_YBUFCFG_Y_BASE_Pos);
+            FMAC->CR = FMAC_CR_CLIPEN;
+        }
+    }
+
+    inline void
+    initialize()
+    {
+        detail::initialize();
+    }
+
+    /**
+     * @brief FIR filter over buffers.
+     *
+     *     y[n] = (sum b[k] x[n-k]) << gain
+     */
+    template<size_t Taps>
+    class Fir
+    {
+        static_assert(Taps >= 1 and Taps <= 127);
+        static_assert(2 * Taps + 2 * detail::Headroom <= detail::Memory,
+                      "The filter does not fit into the FMAC memory!");
+
+    public:
+        /// @param gain left shift of the sum, 0 to 7
+        explicit Fir(const std::array<int16_t, Taps> &coefficients, uint8_t gain = 0) :
+            coefficients(coefficients), gain(gain)
+        {
+        }
+
+        void
+        reset()
+        {
+            history.fill(0);
+        }
+
+        /// Filters `length` samples, `input` and `output` may be the same buffer.
+        void
+        process(const int16_t *input, int16_t *output, size_t length)
+        {
+            if (length == 0) {
+                return;
+            }
+            // the input is overwritten in place, keep its end first
+            const auto previous = history;
+            detail::remember(history, History, input, length);
+
+            using detail::Function;
+            detail::configure(Taps + detail::Headroom, Taps, detail::Headroom);
+            detail::load(Function::LoadX1, previous.data(), History);
+            detail::load(Function::LoadX2, coefficients.data(), Taps);
+            detail::start(Function::Fir, Taps, 0, gain);
+            detail::stream(input, output, length);
+        }
+
+    private:
+        static constexpr size_t History = Taps - 1;
+
+        std::array<int16_t, Taps> coefficients;
+        /// x[n-1] last
+        std::array<int16_t, History ? History : 1> history{};
+        uint8_t gain;
+    };
+
+    /**
+     * @brief IIR filter in direct form 1 over buffers.
+     *
+     *     y[n] = (sum b[k] x[n-k] + sum a[k] y[n-k]) << gain
+     *
+     * with k from 1 for the feedback. The feedback coefficients are added,
+     * that is with the opposite sign of the usual transfer function notation.
+     */
+    template<size_t Feedforward, size_t Feedback>
+    class Iir
+    {
+        static_assert(Feedforward >= 2 and Feedforward <= 64 and Feedback >= 1 and Feedback <= 16,
+                      "The FMAC supports 2 to 64 feedforward and 1 to 16 feedback taps!");
+
+    public:
+        Iir(const std::array<int16_t, Feedforward> &b, const std::array<int16_t, Feedback> &a,
+            uint8_t gain = 0) : gain(gain)
+        {
+            std::copy(b.begin(), b.end(), coefficients.begin());
+            std::copy(a.begin(), a.end(), coefficients.begin() + Feedforward);
+        }
+
+        void
+        reset()
+        {
+            inputs.fill(0);
+            outputs.fill(0);
+        }
+
+        void
+        process(const int16_t *input, int16_t *output, size_t length)
+        {
+            if (length == 0) {
+                return;
+            }
+            const auto previous = inputs;
+            detail::remember(inputs, Feedforward - 1, input, length);
+
+            using detail::Function;
+            detail::configure(Feedforward + detail::Headroom, Feedforward + Feedback,
+                              Feedback + detail::Headroom);
+            detail::load(Function::LoadX1, previous.data(), Feedforward - 1);
+            detail::load(Function::LoadX2, coefficients.data(), Feedforward, Feedback);
+            detail::load(Function::LoadY, outputs.data(), Feedback);
+            detail::start(Function::Iir, Feedforward, Feedback, gain);
+            detail::stream(input, output, length);
+            detail::remember(outputs, Feedback, output, length);
+        }
+
+    private:
+        /// b[0..N) followed by a[1..M]
+        std::array<int16_t, Feedforward + Feedback> coefficients;
+        /// x[n-1] last
+        std::array<int16_t, Feedforward - 1> inputs{};
+        /// y[n-1] last
+        std::array<int16_t, Feedback> outputs{};
+        uint8_t gain;
+    };
+#else
+    inline void
+    initialize()
+    {
+    }
+
+    using soft::Fir;
+    using soft::Iir;
+#endif
+}
+
+#endif // FMAC_HPP
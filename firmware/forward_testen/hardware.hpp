@@ -1,13 +1,27 @@
 #ifndef HARDWARE_HPP
 #define HARDWARE_HPP
 
+#include <modm/architecture/detect.hpp>
+
+#ifdef MODM_OS_HOSTED
+// host tests run the firmware against the models of the SimBoard
+#include "sim/sim_board.hpp"
+#else
+
 #include <modm/platform.hpp>
 #include <modm/architecture/interface/clock.hpp>
-#include <modm/platform/i2c/i2c_master_1.hpp>
+#include <modm/architecture/interface/atomic_lock.hpp>
+#include <modm/platform/i2c/i2c_master_3.hpp>
 #include <modm/platform/uart/uart_hal_1.hpp>
 
 #include <modm/platform/timer/timer_3.hpp>
 #include <modm/platform/timer/timer_2.hpp>
+#include <modm/platform/timer/timer_5.hpp>
+#include <modm/platform/timer/timer_17.hpp>
+#include <modm/platform/clock/timer_clock.hpp>
+
+#include "pwm_configuration.hpp"
+#include "motor_mode.hpp"
 
 
 using namespace modm::platform;
@@ -132,6 +146,25 @@ namespace Board
     using M2_Dir   = GpioA1;
     using M2_Brake = GpioA4;
 
+    /// BSRR writes of the MotorMode, one store per port
+    struct MotorPort
+    {
+        template<uint8_t Port>
+        static void
+        write(uint32_t bsrr)
+        {
+            if constexpr (Gpio::Port(Port) == Gpio::Port::A) GPIOA->BSRR = bsrr;
+            if constexpr (Gpio::Port(Port) == Gpio::Port::B) GPIOB->BSRR = bsrr;
+            if constexpr (Gpio::Port(Port) == Gpio::Port::C) GPIOC->BSRR = bsrr;
+            if constexpr (Gpio::Port(Port) == Gpio::Port::F) GPIOF->BSRR = bsrr;
+            if constexpr (Gpio::Port(Port) == Gpio::Port::G) GPIOG->BSRR = bsrr;
+        }
+    };
+    /// Sleep, Brake and Dir of both drivers, ordered and in the fewest port writes
+    using MotorMode = MotorModeSwitch<MotorPort,
+                                      DriverPins<M1_Sleep, M1_Brake, M1_Dir>,
+                                      DriverPins<M2_Sleep, M2_Brake, M2_Dir>>;
+
     // Optional waveforms
     using Wave1 = GpioA3;
     using Wave2 = GpioA2;
@@ -142,84 +175,195 @@ namespace Board
     // Timer for Motor1
     using MotorTimer2 = modm::platform::Timer2; // PA0 can do Timer2 CH1
 
+    // ------------------- Tacho capture -------------------
+    // The FG outputs are captured by free running timers and moved into
+    // memory by DMA, see CaptureRing. PA7/PB2 don't route to Timer2/3.
+    struct M1_Capture
+    {
+        using Timer = modm::platform::Timer17;  // PA7 can do Timer17 CH1
+        using Signal = GpioA7::Ch1;
+        static constexpr uintptr_t TimerBase = TIM17_BASE;
+        static constexpr uint8_t DmaChannel = 1;
+        static constexpr uint8_t DmaRequest = 84;  // TIM17_CH1
+        // 16 bit, wraps after 655 ms
+        static constexpr uint32_t TickFrequency = 100_kHz;
+    };
+    struct M2_Capture
+    {
+        using Timer = modm::platform::Timer5;   // PB2 can do Timer5 CH1
+        using Signal = GpioB2::Ch1;
+        static constexpr uintptr_t TimerBase = TIM5_BASE;
+        static constexpr uint8_t DmaChannel = 2;
+        static constexpr uint8_t DmaRequest = 72;  // TIM5_CH1
+        static constexpr uint32_t TickFrequency = 1_MHz;
+    };
+
+    // ------------------- Time base -------------------
+    /// 64-bit microseconds behind modm::Clock and modm::PreciseClock, see
+    /// precise_clock.cpp. Counts on the timer of M2_Capture, same 1 MHz.
+    using TimeBase = TimerClock<M2_Capture::Timer>;
+
+    // ------------------- Motor PWM -------------------
+    /**
+     * Both motor timers run as one: MotorTimer3 is the master and emits its
+     * counter enable on TRGO, MotorTimer2 is started by it (ITR2). Both have
+     * the same configuration, so the PWM periods of the two wheels stay
+     * aligned without ever resetting a counter. setCompare() writes both
+     * compare preload registers while the update events are disabled, the
+     * new duty cycles therefore take effect together at the next update.
+     *
+     * 20 kHz center-aligned is above the audible range, with 170 MHz timer
+     * clock that leaves 4250 duty steps.
+     */
+    struct MotorPwm
+    {
+        using Pwm1 = GpioB0::Ch3;   // Motor 1
+        using Pwm2 = GpioA0::Ch1;   // Motor 2
+
+        using Configuration = PwmConfiguration<MotorTimer3, SystemClock, 20_kHz, 1000>;
+        /// Compare value for 100% duty
+        static constexpr uint16_t Resolution = Configuration::Resolution;
+        /// Update events per second of both timers, twice per period
+        static constexpr uint32_t UpdateFrequency = Configuration::UpdateFrequency;
+
+        static void
+        initialize()
+        {
+            MotorTimer3::connect<Pwm1>();
+            MotorTimer3::enable();
+            Configuration::configure(MotorTimer3::SlaveMode::Disabled,
+                                     MotorTimer3::SlaveModeTrigger(0),
+                                     MotorTimer3::MasterMode::Enable);
+
+            MotorTimer2::connect<Pwm2>();
+            MotorTimer2::enable();
+            MotorTimer2::setMode(Configuration::Mode,
+                                 MotorTimer2::SlaveMode::Trigger,
+                                 MotorTimer2::SlaveModeTrigger::Internal2);
+            MotorTimer2::setPrescaler(Configuration::Prescaler);
+            MotorTimer2::setOverflow(Configuration::Overflow);
+
+            // Configure PWM @ 50% initially
+            MotorTimer3::configureOutputChannel<Pwm1>(MotorTimer3::OutputCompareMode::Pwm, Resolution / 2);
+            MotorTimer2::configureOutputChannel<Pwm2>(MotorTimer2::OutputCompareMode::Pwm, Resolution / 2);
+            MotorTimer2::applyAndReset();
+            MotorTimer3::applyAndReset();
+            // starts MotorTimer2 as well
+            MotorTimer3::start();
+        }
+
+        /// Sets both compare values, they are applied at the same update event.
+        static void
+        setCompare(uint16_t motor1, uint16_t motor2)
+        {
+            modm::atomic::Lock lock;
+            TIM3->CR1 |= TIM_CR1_UDIS;
+            TIM2->CR1 |= TIM_CR1_UDIS;
+            MotorTimer3::setCompareValue<Pwm1>(motor1);
+            MotorTimer2::setCompareValue<Pwm2>(motor2);
+            TIM2->CR1 &= ~TIM_CR1_UDIS;
+            TIM3->CR1 &= ~TIM_CR1_UDIS;
+        }
+
+        /**
+         * Forces both outputs low at once, regardless of the compare values,
+         * until release(). Register level, so it is short enough for the
+         * fault interrupt: Pwm1 is CH3 of TIM3, Pwm2 is CH1 of TIM2.
+         */
+        static void
+        forceInactive()
+        {
+            TIM3->CCMR2 = (TIM3->CCMR2 & ~TIM_CCMR2_OC3M) | TIM_CCMR2_OC3M_2;
+            TIM2->CCMR1 = (TIM2->CCMR1 & ~TIM_CCMR1_OC1M) | TIM_CCMR1_OC1M_2;
+        }
+
+        /// Returns both outputs to PWM mode 1.
+        static void
+        release()
+        {
+            TIM3->CCMR2 = (TIM3->CCMR2 & ~TIM_CCMR2_OC3M) | TIM_CCMR2_OC3M_2 | TIM_CCMR2_OC3M_1;
+            TIM2->CCMR1 = (TIM2->CCMR1 & ~TIM_CCMR1_OC1M) | TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1;
+        }
+    };
+
+
+    // ------------------- Analog -------------------
+    /**
+     * ADC1 converts the sequence once per PWM period, triggered at the trough
+     * of the center-aligned MotorTimer3, the middle of the on-time. This PCB
+     * routes no current sense or battery divider to the MCU, so only the
+     * internal channels are sampled, add routed inputs to `Channels`.
+     */
+    struct Analog
+    {
+        static constexpr uint8_t Vrefint = 18;
+        static constexpr uint8_t Temperature = 16;
+        /// ADC1 channel of a divider from VM, not in `Channels` as this PCB has none
+        static constexpr uint8_t Battery = 0xff;
+        /// VM per volt at the divider output
+        static constexpr uint16_t BatteryDivider = 11;
+        /// Conversion sequence, ADC1 channel numbers
+        static constexpr uint8_t Channels[] = {Vrefint, Temperature};
+        static constexpr uint8_t DmaChannel = 3;
+        static constexpr uint8_t DmaRequest = 5;    // ADC1
+        /// PWM periods per batch, 20 = 1 kHz at 20 kHz PWM
+        static constexpr size_t Frames = 20;
+    };
+
 
     // ------------------- Debug UART -------------------
     namespace DebugUart {
         using DebugUartTx = GpioA9; // TX pin
-        using DebugUart   = BufferedUart<UsartHal1>;
+        using DebugUartRx = GpioA10; // RX pin, mission commands
+        using DebugUart   = BufferedUart<UsartHal1, UartRxBuffer<64>>;
 
         static constexpr uint32_t DebugUartBaudrate = 9600_Bd;  
 
         static void inline initialize()
         {
-            DebugUart::connect<DebugUartTx::Tx>();
+            DebugUart::connect<DebugUartTx::Tx, DebugUartRx::Rx>();
             DebugUart::initialize<Board::SystemClock, 115200_Bd>();
         }
     }
 
-//    // ------------------- I2C (to be implemented) -------------------
-//    struct I2c
-//    {
-//        using Sda = GpioB5;
-//        using Scl = GpioA8;
-//        using Master = I2cMaster1;
-//
-//        static void initialize()
-//        {
-//            Master::connect<Sda::Sda, Scl::Scl>();
-//            Master::initialize<SystemClock, 400_kBd>();
-//        }
-//    };
+    // ------------------- I2C (VL53L0X ToF sensor) -------------------
+    // PB5/PA8 only route to I2C3, not I2C1
+    struct I2c
+    {
+        using Sda = GpioB5;
+        using Scl = GpioA8;
+        using Master = I2cMaster3;
+
+        static void initialize()
+        {
+            Master::connect<Sda::Sda, Scl::Scl>();
+            Master::initialize<SystemClock, 400_kBd>();
+        }
+    };
 
     // ------------------- Board Initialization -------------------
     inline void
     initialize()
     {
-        // 1) Clock & SysTick
+        // 1) Clock & SysTick, the time base before anything waits
         SystemClock::enable();
         SysTickTimer::initialize<SystemClock>();
+        TimeBase::initialize<SystemClock>();
 
         // 2) --- Setup Motor1 Pins ---
-        M1_Sleep::setOutput(true);  // Enable motor driver if active high.
-        M1_Fault::setInput();
+        M1_Fault::setInput(Gpio::InputType::PullUp);  // open drain, low on fault
         M1_Tacho::setInput();
-        M1_Dir::setOutput(false);    // false = forward?
-        M1_Brake::setOutput(false);  // false = brake released -> led stays off
-        // PWM - Timer3 (Motor1) on PB0 => CH3
-        M1_Pwm::setOutput();
-        MotorTimer3::connect<GpioB0::Ch3>();
-        MotorTimer3::enable();
-        MotorTimer3::setMode(MotorTimer3::Mode::UpCounter);
-        MotorTimer3::setPrescaler(17 - 1);  // => 170 MHz / 17 = 10 MHz
-        MotorTimer3::setOverflow(1000);     // => 10 MHz / 1000 = 10 kHz
-        // Configure PWM @ 50% initially
-        MotorTimer3::configureOutputChannel<GpioB0::Ch3>(
-            MotorTimer3::OutputCompareMode::Pwm,
-            500 // 50% of 1000
-        );
-        MotorTimer3::applyAndReset();
-        MotorTimer3::start();
 
         // 3) --- Setup Motor2 Pins ---
-        M2_Sleep::setOutput(true);
-        M2_Fault::setInput();
+        M2_Fault::setInput(Gpio::InputType::PullUp);
         M2_Tacho::setInput();
-        M2_Dir::setOutput(false);
-        M2_Brake::setOutput(false);
-        // Timer2 (Motor2) on PA0 => CH1 --
-        M2_Pwm::setOutput();
-        MotorTimer2::connect<GpioA0::Ch1>();
-        MotorTimer2::enable();
-        MotorTimer2::setMode(MotorTimer2::Mode::UpCounter);
-        MotorTimer2::setPrescaler(17 - 1);
-        MotorTimer2::setOverflow(1000);
-        // Configure PWM @ 50% initially
-        MotorTimer2::configureOutputChannel<GpioA0::Ch1>(
-            MotorTimer2::OutputCompareMode::Pwm,
-            500 // 50% of 1000
-        );
-        MotorTimer2::applyAndReset();
-        MotorTimer2::start();
+
+        // Outputs start low, asleep, then active and forward with the brake released
+        GpioSet<M1_Sleep, M1_Dir, M1_Brake, M2_Sleep, M2_Dir, M2_Brake>::setOutput();
+        MotorMode::apply<MotorMode::Sleep>();
+
+        // PWM - Timer3 (Motor1) on PB0 => CH3, Timer2 (Motor2) on PA0 => CH1
+        MotorPwm::initialize();
 
         // 4) --- Led pins ---
         Led_D2::setOutput();
@@ -230,8 +374,13 @@ namespace Board
 
         // 6) Debug Uart
         DebugUart::initialize();
+
+        // 7) I2C for the ToF sensor
+        I2c::initialize();
     }
 
 } // namespace Board
 
+#endif // MODM_OS_HOSTED
+
 #endif // HARDWARE_HPP
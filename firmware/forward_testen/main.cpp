@@ -1,33 +1,49 @@
 #include "hardware.hpp"
-#include <modm/architecture/interface/delay.hpp>
+#include "range_sensor.hpp"
+#include "motor_control.hpp"
+#include "control_executive.hpp"
+#include "odometry.hpp"
+#include "fault_monitor.hpp"
+#include "acquisition.hpp"
+#include "test_sequence.hpp"
+#include "obstacle_avoidance.hpp"
+#include "mission.hpp"
+#include "edge_capture.hpp"
+#include "fmac.hpp"
+#include <algorithm>
+#include <span>
 #include <modm/debug/logger.hpp>
+#include <modm/math/fixed_point.hpp>
+#include <modm/processing/fiber.hpp>
+#include <modm/processing/timer.hpp>
 
 using namespace Board;
+using namespace std::chrono_literals;
 
 /**
- * @brief Drives the motor at a given speed percentage.
+ * @brief Drives the motor at a given fraction of full duty.
  *
- * Sets the PWM duty cycle for the motor channels.
+ * Ramps the PWM duty cycle of the motor channels from the previous value,
+ * a step would cause current spikes and wheel slip. Returns once the new
+ * duty cycle is reached.
  */
-void driveForward(uint16_t speedPercent)
+void driveForward(modm::Q15 speed)
 {
-    if (speedPercent > 100) {
-        speedPercent = 100;
-    }
+    // in compare counts, 0 to 100% in about 0.6 s
+    static MotionProfile ramp{MotionProfile::Parameters{
+            .acceleration = 2 * MotorPwm::Resolution,
+            .jerk = 20 * MotorPwm::Resolution,
+            .frequency = 1000}};
 
     // (Assumes that the Direction pins are set by the caller.)
-    uint16_t duty1 = (MotorTimer3::getOverflow() * speedPercent) / 100;
-    uint16_t duty2 = (MotorTimer2::getOverflow() * speedPercent) / 100;
-
-    MotorTimer3::configureOutputChannel<GpioB0::Ch3>(
-        MotorTimer3::OutputCompareMode::Pwm, duty1);
-    MotorTimer2::configureOutputChannel<GpioA0::Ch1>(
-        MotorTimer2::OutputCompareMode::Pwm, duty2);
-
-    MotorTimer3::applyAndReset();
-    MotorTimer3::start();
-    MotorTimer2::applyAndReset();
-    MotorTimer2::start();
+    ramp.setTarget(std::max(speed, modm::Q15()).scale(MotorPwm::Resolution));
+    while (ramp.isBusy())
+    {
+        const uint16_t duty = ramp.update();
+        // both wheels change at the same PWM period
+        MotorPwm::setCompare(duty, duty);
+        modm::this_fiber::sleep_for(1ms);
+    }
 }
 
 /**
@@ -42,9 +58,11 @@ void logPwmSettings()
     uint16_t overflow2 = MotorTimer2::getOverflow();
 
     MODM_LOG_INFO << "PWM Settings:" << modm::endl;
+    MODM_LOG_INFO << "  frequency = " << MotorPwm::Configuration::PwmFrequency << " Hz"
+                  << ", prescaler = " << MotorTimer3::getPrescaler() << modm::endl;
     MODM_LOG_INFO << "  MotorTimer3 overflow = " << overflow1 << modm::endl;
     MODM_LOG_INFO << "  MotorTimer2 overflow = " << overflow2 << modm::endl;
-    modm::delay_ms(100);
+    modm::this_fiber::sleep_for(100ms);
 }
 
 /**
@@ -56,18 +74,12 @@ void logPwmSettings()
  */
 void driveAtFullDuty(bool fullOn = true)
 {
-    uint16_t duty = fullOn ? MotorTimer3::getOverflow() : 0;
+    uint16_t duty = fullOn ? MotorPwm::Resolution : 0;
     MODM_LOG_INFO << "Setting PWM duty to " << (fullOn ? "100%" : "0%")
                   << " (" << duty << ")" << modm::endl;
-    modm::delay_ms(100);
+    modm::this_fiber::sleep_for(100ms);
 
-    MotorTimer3::configureOutputChannel<GpioB0::Ch3>(
-        MotorTimer3::OutputCompareMode::Pwm, duty);
-    MotorTimer2::configureOutputChannel<GpioA0::Ch1>(
-        MotorTimer2::OutputCompareMode::Pwm, duty);
-
-    MotorTimer3::applyAndReset();
-    MotorTimer2::applyAndReset();
+    MotorPwm::setCompare(duty, duty);
 }
 
 /**
@@ -79,7 +91,7 @@ void driveAtFullDuty(bool fullOn = true)
 void testPwmPinToggle()
 {
     MODM_LOG_INFO << "Starting PWM pin toggle test..." << modm::endl;
-    modm::delay_ms(100);
+    modm::this_fiber::sleep_for(100ms);
 
     // Temporarily disable PWM on M1_Pwm and reconfigure it as a standard output.
     M1_Pwm::setOutput();
@@ -88,7 +100,7 @@ void testPwmPinToggle()
     for (int i = 0; i < 10; ++i) {
         M1_Pwm::toggle();
         MODM_LOG_INFO << "  Toggling PWM pin (" << (i + 1) << "/10)" << modm::endl;
-        modm::delay_ms(500);
+        modm::this_fiber::sleep_for(500ms);
     }
 
     // Restore PWM functionality.
@@ -96,109 +108,352 @@ void testPwmPinToggle()
     MotorTimer3::start();
 
     MODM_LOG_INFO << "PWM pin toggle test complete." << modm::endl;
-    modm::delay_ms(100);
+    modm::this_fiber::sleep_for(100ms);
 }
 
 /**
- * @brief Tests various enable combinations while allowing manual rotation.
+ * @brief Enable combinations of the drivers, with manual rotation.
+ *
+ * Each step drives both motors at 50% duty for 10 seconds, turn the wheels
+ * by hand meanwhile to see if the motors begin commutating.
+ */
+constexpr TestSequence::Step enableModes[] = {
+    // Normal operation: nSLEEP high, BRAKE low, DIR low, the wheels turn clockwise
+    {"01", TestSequence::Sleep, 0.5, 500ms, 10s, {.minFrequency = 1, .fault = TestSequence::Fault::Clear}},
+    // Reverse operation: DIR high, the wheels turn counterclockwise
+    {"02", TestSequence::Sleep | TestSequence::Dir, 0.5, 500ms, 10s,
+     {.minFrequency = 1, .fault = TestSequence::Fault::Clear}},
+    // Brake active: the motors must not drive, only manual rotation
+    {"03", TestSequence::Sleep | TestSequence::Brake, 0.5, 500ms, 10s, {.fault = TestSequence::Fault::Clear}},
+    // Sleep mode: nSLEEP low, the drivers and their FG outputs are off
+    {"04", 0, 0.5, 500ms, 10s, {.maxFrequency = 0}},
+};
+
+static_assert(uint8_t(MotorMode::Sleep) == uint8_t(TestSequence::Sleep) and
+              uint8_t(MotorMode::Brake) == uint8_t(TestSequence::Brake) and
+              uint8_t(MotorMode::Dir) == uint8_t(TestSequence::Dir));
+
+/// Runs test sequences on the motor drivers, see TestSequence.
+struct MotorIo
+{
+    static void
+    apply(const TestSequence::Step &step)
+    {
+        MotorMode::apply(step.pins);
+        driveForward(step.duty);
+    }
+
+    static void
+    wait(std::chrono::milliseconds time)
+    {
+        modm::this_fiber::sleep_for(time);
+    }
+
+    static uint32_t
+    getEdgeCount(uint8_t motor)
+    {
+        return MotorControl::getEdgeCount(MotorControl::Wheel(motor));
+    }
+
+    static bool
+    isFault(uint8_t motor)
+    {
+        const bool latched = FaultMonitor::isLatched() and (FaultMonitor::getFault().sources & (1 << motor));
+        return latched or not (motor ? M2_Fault::read() : M1_Fault::read());
+    }
+
+    static void
+    report(const TestSequence::Record &record)
+    {
+        MODM_LOG_INFO << "ts " << record.index << " " << record.code << " "
+                      << record.frequency[0] << " " << record.frequency[1] << " "
+                      << record.faults << " " << record.passed << modm::endl; // "Step, code, FG Hz 1 and 2, faults, passed."
+    }
+};
+
+/**
+ * @brief Reports driver faults.
  *
- * This function cycles through four specific combinations:
+ * Wakes up after the fault interrupt has already switched the motors off and
+ * logs the sources. The fault stays latched until the next reset, commands
+ * of the test sequence are ignored from then on.
+ */
+void supervise()
+{
+    while (true)
+    {
+        FaultMonitor::wait();
+        const auto fault = FaultMonitor::getFault();
+        MODM_LOG_ERROR << "FT " << fault.sources << " "
+                       << fault.time.time_since_epoch().count() << modm::endl; // "Driver fault: sources, ms."
+        modm::this_fiber::poll([] { return not FaultMonitor::isLatched(); });
+    }
+}
+
+/// Latest analog supply in mV and chip temperature in degree Celsius.
+uint16_t analogSupply{0};
+int16_t chipTemperature{0};
+
+/**
+ * @brief Evaluates the PWM-synchronous ADC batches.
  *
- * 1. Normal Operation: nSLEEP = HIGH, BRAKE = LOW, DIR = LOW.
- * 2. Reverse Operation: nSLEEP = HIGH, BRAKE = LOW, DIR = HIGH.
- * 3. Brake Active: nSLEEP = HIGH, BRAKE = HIGH, DIR = LOW.
- * 4. Sleep Mode: nSLEEP = LOW, BRAKE = LOW, DIR = LOW.
+ * Runs once per batch, woken up by the DMA. The samples of each channel are
+ * smoothed on the FMAC over the batch boundaries, Vrefint by a moving
+ * average over 8 PWM periods, the slow temperature by a first-order low
+ * pass with a time constant of 16 periods, which settles within a few
+ * batches after the start. The last output of each batch is converted.
  *
- * For each combination, the motor is driven at a preset PWM duty cycle (75%)
- * and the program waits 10 seconds to allow you to manually rotate the wheel
- * to see if the motor begins commutating.
+ * A routed battery divider feeds VM into the feed-forward of MotorControl.
+ * This PCB has none, the integral of the speed loops absorbs the sag.
  */
-void testEnableModes(uint16_t speedPercent)
+void monitor()
 {
-    // const uint16_t speedPercent = 75;
-    const int testDuration_ms = 10000;  // 10 seconds per configuration
-
-    // Test 1: Normal Operation
-    MODM_LOG_INFO << "01" << modm::endl; // "Test 1: Normal Operation (nSLEEP=HIGH, BRAKE=LOW, DIR=LOW)"
-    M1_Sleep::setOutput(true);  // nSLEEP high: driver active.
-    M2_Sleep::setOutput(true);
-    M1_Brake::setOutput(false); // BRAKE low: normal operation.
-    M2_Brake::setOutput(false);
-    M1_Dir::setOutput(false);   // DIR low: choose clockwise (for example).
-    M2_Dir::setOutput(false);
-    driveForward(speedPercent);
-    MODM_LOG_INFO << "cw" << modm::endl; // "Rotate wheel manually (clockwise) now."
-    modm::delay_ms(testDuration_ms);
-
-    // Test 2: Reverse Operation
-    MODM_LOG_INFO << "02" << modm::endl;  // "Test 2: Reverse Operation (nSLEEP=HIGH, BRAKE=LOW, DIR=HIGH)"
-    M1_Sleep::setOutput(true);
-    M2_Sleep::setOutput(true);
-    M1_Brake::setOutput(false);
-    M2_Brake::setOutput(false);
-    M1_Dir::setOutput(true);   // DIR high: reverse rotation.
-    M2_Dir::setOutput(true);
-    driveForward(speedPercent);
-    MODM_LOG_INFO << "cc" << modm::endl; //  "Rotate wheel manually (counterclockwise) now."
-    modm::delay_ms(testDuration_ms);
-
-    // Test 3: Brake Active
-    MODM_LOG_INFO << "03" << modm::endl; // "Test 3: Brake Active (nSLEEP=HIGH, BRAKE=HIGH, DIR=LOW)"
-    M1_Sleep::setOutput(true);
-    M2_Sleep::setOutput(true);
-    M1_Brake::setOutput(true); // BRAKE high: motor is braked.
-    M2_Brake::setOutput(true);
-    M1_Dir::setOutput(false);   // Direction doesn't matter here.
-    M2_Dir::setOutput(false);
-    driveForward(speedPercent);
-    MODM_LOG_INFO << "br" << modm::endl; // "Rotate wheel manually; motor should not turn (brake active)."
-    modm::delay_ms(testDuration_ms);
-
-    // Test 4: Sleep Mode
-    MODM_LOG_INFO << "04" << modm::endl; // "Test 4: Sleep Mode (nSLEEP=LOW, BRAKE=LOW, DIR=LOW)"
-    M1_Sleep::setOutput(false); // nSLEEP low: driver in sleep.
-    M2_Sleep::setOutput(false);
-    M1_Brake::setOutput(false);
-    M2_Brake::setOutput(false);
-    M1_Dir::setOutput(false);
-    M2_Dir::setOutput(false);
-    driveForward(speedPercent);
-    MODM_LOG_INFO << "sl" << modm::endl; // "Rotate wheel manually; motor should not run (sleep mode)."
-    modm::delay_ms(testDuration_ms);
+    // Q1.15 fractions of the ADC full scale
+    static Fmac::Fir<8> supplyFilter({4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096});
+    // y[n] = x[n] / 16 + y[n-1] * 15 / 16
+    static Fmac::Iir<2, 1> temperatureFilter({2048, 0}, {30720});
+    static Fmac::Fir<8> batteryFilter({4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096});
+    std::array<int16_t, Acquisition::Frames> samples;
+
+    while (true)
+    {
+        const auto batch = Acquisition::wait();
+        const size_t frames = std::min(batch.size(), samples.size());
+        if (frames == 0) {
+            continue;
+        }
+        const auto filter = [&](auto &filter, uint8_t channel) -> uint16_t
+        {
+            const size_t index = Acquisition::indexOf(channel);
+            for (size_t frame = 0; frame < frames; frame++) {
+                samples[frame] = int16_t(batch(frame, index) << 3);
+            }
+            filter.process(samples.data(), samples.data(), frames);
+            return std::max<int16_t>(samples[frames - 1], 0) >> 3;
+        };
+        analogSupply = Acquisition::toSupply(filter(supplyFilter, Analog::Vrefint));
+        chipTemperature = Acquisition::toTemperature(filter(temperatureFilter, Analog::Temperature), analogSupply);
+        if constexpr (Acquisition::indexOf(Analog::Battery) < Acquisition::Channels) {
+            MotorControl::setSupplyVoltage(Acquisition::toBattery(filter(batteryFilter, Analog::Battery), analogSupply));
+        }
+    }
 }
 
+/// Intervals between the FG edges of motor 2, in CPU cycles
+struct EdgeTiming
+{
+    uint32_t edges{0};
+    uint32_t last{0};
+    uint32_t minInterval{UINT32_MAX};
+    uint32_t maxInterval{0};
+};
+EdgeTiming edgeTiming;
+
 /**
- * @brief Main function.
+ * @brief Evaluates the timestamped edges in batches.
  *
- * Initializes the board, performs a baseline drive test, then cycles through
- * enable combinations with manual rotation.
+ * Drains the EdgeCapture every 10ms, fast enough for 12 kHz of edges,
+ * keeps the interval statistics of the FG edges of motor 2 and logs the
+ * nFAULT edges.
  */
-int main()
+void timeEdges()
 {
-    Board::initialize();
-    MODM_LOG_INFO << "In" << modm::endl; // "Init."
+    EdgeCapture::Edge edges[32];
+    while (true)
+    {
+        modm::this_fiber::sleep_for(10ms);
+        while (const size_t count = EdgeCapture::read(edges))
+        {
+            for (const auto &edge : std::span(edges, count))
+            {
+                if (edge.line == M1_Fault::pin or edge.line == M2_Fault::pin) {
+                    MODM_LOG_INFO << "fe " << edge.line << " " << edge.cycles << modm::endl; // "nFAULT edge: line, cycles."
+                    continue;
+                }
+                EdgeTiming &timing = edgeTiming;
+                const uint32_t interval = edge.cycles - timing.last;
+                if (timing.edges++)
+                {
+                    timing.minInterval = std::min(timing.minInterval, interval);
+                    timing.maxInterval = std::max(timing.maxInterval, interval);
+                }
+                timing.last = edge.cycles;
+            }
+        }
+    }
+}
+
+/// The ToF sensor answered at startup.
+bool rangeAvailable{false};
+
+/**
+ * @brief Explores the surroundings, avoiding the obstacles in front.
+ *
+ * Measures the range and evaluates the behavior every 20ms, the speed
+ * controllers follow its wheel speeds. Logs the lateness of the ticks
+ * every 10s. Stops on a driver fault and resumes once it is cleared.
+ */
+void explore()
+{
+    ObstacleAvoidance behavior;
+    behavior.reset();
+    // the behavior counts ticks, keep them on a 20ms grid
+    modm::PreciseDeadlineTimer period{20ms};
+    while (true)
+    {
+        period.wait();
+        if (period.statistics().expirations == 500)
+        {
+            const auto &lateness = period.statistics();
+            MODM_LOG_INFO << "el " << lateness.mean().count() << " " << lateness.maximum.count() << " "
+                          << lateness.missed << modm::endl; // "Tick lateness in us, mean and max, missed ticks."
+            period.resetStatistics();
+        }
+        // an uploaded mission has the wheels
+        if (FaultMonitor::isLatched() or Mission::isRunning()) {
+            behavior.reset();
+            continue;
+        }
+        RangeSensor::update();
+        const Odometry::Pose pose = Odometry::getPose();
+        const auto command = behavior.update({
+                .tracking = RangeSensor::filter.isTracking(),
+                .distance = RangeSensor::filter.getDistance(),
+                .velocity = RangeSensor::filter.getVelocity(),
+                .x = pose.x,
+                .y = pose.y,
+                .heading = pose.heading,
+                .left = MotorControl::getSpeed(MotorControl::Wheel::Left),
+                .right = MotorControl::getSpeed(MotorControl::Wheel::Right)});
+        MotorControl::setSpeed(command.left, command.right);
+        Led_D2::set(behavior.getState() != ObstacleAvoidance::State::Cruise);
+    }
+}
 
+/**
+ * @brief Runs the test sequence.
+ *
+ * Performs a baseline drive test, then cycles through enable combinations
+ * with manual rotation and holds a closed-loop wheel speed. Finally explores
+ * with obstacle avoidance if the ToF sensor is available.
+ */
+void runTests()
+{
     // Blink a heartbeat LED during startup.
     for (int i = 0; i < 5; i++) {
         Led_D2::toggle();
-        modm::delay_ms(1000);
+        modm::this_fiber::sleep_for(1000ms);
     }
 
     MODM_LOG_INFO << "75" << modm::endl; // "Starting baseline drive at 75% duty."
-    modm::delay_ms(100);
-    driveForward(75);
-    modm::delay_ms(2000);
+    modm::this_fiber::sleep_for(100ms);
+    driveForward(0.75);
+    modm::this_fiber::sleep_for(2000ms);
 
     // Run the enable mode tests.
-    testEnableModes(50);
+    const auto summary = TestSequence::run<MotorIo>(enableModes);
+    MODM_LOG_INFO << "tr " << summary.failed << "/" << summary.steps << modm::endl; // "Failed of all steps."
+
+    // Hold a wheel speed with the tacho feedback, logs the loop cost in CPU cycles.
+    MODM_LOG_INFO << "cl" << modm::endl; // "Closed-loop speed control at 2000 rpm."
+    MotorControl::setSpeed(2000, 2000);
+    for (int i = 0; i < 10; i++) {
+        modm::this_fiber::sleep_for(500ms);
+        if (i == 0) {
+            // FG intervals without the ramp up
+            edgeTiming = EdgeTiming();
+        }
+        const auto statistics = MotorControl::getStatistics();
+        MODM_LOG_INFO << MotorControl::getSpeed(MotorControl::Wheel::Left) << " "
+                      << MotorControl::getSpeed(MotorControl::Wheel::Right) << " "
+                      << statistics.cycles << "/" << statistics.maxCycles << modm::endl;
+    }
+    MotorControl::disable();
+    MODM_LOG_INFO << "eg " << edgeTiming.edges << " " << edgeTiming.minInterval << " " << edgeTiming.maxInterval << modm::endl; // "FG edges of motor 2, shortest and longest interval in cycles."
+    MODM_LOG_INFO << "eo " << EdgeCapture::getOverruns() << modm::endl; // "Lost edges."
+    const auto timing = ControlExecutive::getStatistics();
+    MODM_LOG_INFO << "ce " << timing.overruns << " " << timing.lostUpdates << " "
+                  << timing.minJitter << " " << timing.maxJitter;
+    for (const auto &stage : timing.stages) {
+        MODM_LOG_INFO << " " << stage.maxCycles;
+    }
+    MODM_LOG_INFO << modm::endl; // "Overruns, lost timer updates, period jitter in cycles, maximum cycles per stage."
+
+    // Turn the wheels ten revolutions with a jerk-limited ramp up and down.
+    MODM_LOG_INFO << "mv" << modm::endl; // "Move 10 revolutions at 2000 rpm."
+    const uint32_t edges = MotorControl::getEdgeCount(MotorControl::Wheel::Left);
+    MotorControl::move(10, 10, 2000);
+    while (MotorControl::isMoving()) {
+        modm::this_fiber::sleep_for(100ms);
+        MODM_LOG_INFO << MotorControl::getSetpoint(MotorControl::Wheel::Left) << " "
+                      << MotorControl::getSpeed(MotorControl::Wheel::Left) << modm::endl;
+    }
+    MotorControl::disable();
+    MODM_LOG_INFO << (MotorControl::getEdgeCount(MotorControl::Wheel::Left) - edges) << " "
+                  << MotorControl::getStatistics().maxCycles << modm::endl;
+    // Pose in mm and degrees, starting at the origin.
+    const Odometry::Pose pose = Odometry::getPose();
+    MODM_LOG_INFO << "po " << pose.x / 1000 << " " << pose.y / 1000 << " "
+                  << int32_t((int64_t(pose.heading) * 180) >> 31) << modm::endl;
+
+    MODM_LOG_INFO << "ad " << analogSupply << " " << chipTemperature << " "
+                  << Acquisition::getOverruns() << modm::endl; // "Analog supply mV, temperature, lost batches."
 
     MODM_LOG_INFO << "00" << modm::endl; // "End of tests."
 
-    // After testing, continue with a heartbeat loop.
+    if (rangeAvailable) {
+        MODM_LOG_INFO << "ex" << modm::endl; // "Exploring with obstacle avoidance."
+        explore();
+    }
+
+    // Without the ToF sensor, continue with a heartbeat loop.
     while (true) {
         Led_D2::toggle();
-        modm::delay_ms(1000);
+        modm::this_fiber::sleep_for(1000ms);
+    }
+}
+
+modm::Fiber<> supervisor(supervise);
+modm::Fiber<> sampler(monitor);
+modm::Fiber<2048> sequence(runTests);
+modm::Fiber<> commands(Mission::serve);
+modm::Fiber<> edgeTimer(timeEdges);
+
+/**
+ * @brief Main function.
+ *
+ * Initializes the board and the fault shutdown, measures its reaction time
+ * and runs the test sequence next to the fault supervisor.
+ */
+int main()
+{
+    Board::initialize();
+    MODM_LOG_INFO << "In" << modm::endl; // "Init."
+
+    // Arm the nFAULT shutdown before any motor runs.
+    FaultMonitor::initialize();
+    // a failed test latches a fault, which supervise() reports
+    for (int i = 0; i < 16 and not FaultMonitor::isLatched(); i++) {
+        FaultMonitor::selfTest();
+    }
+    MODM_LOG_INFO << "ft " << FaultMonitor::getStatistics().maxReaction << modm::endl; // "Fault reaction in cycles."
+
+    // Fast boot from the stored calibration, recalibrates if it is missing.
+    rangeAvailable = RangeSensor::initialize();
+    if (not rangeAvailable) {
+        MODM_LOG_INFO << "tf" << modm::endl; // "ToF sensor unavailable."
     }
+    MotorControl::initialize();
+    Mission::initialize();
+    Fmac::initialize();
+    Acquisition::initialize();
+
+    // Edge timestamps of the FG output of motor 2 next to its timer capture, and of nFAULT.
+    // M1_Tacho on line 7 would share the vector and the priority of M1_Fault, TIM17 captures it alone.
+    EdgeCapture::add<M2_Tacho>();
+    EdgeCapture::add<M1_Fault, EdgeCapture::FaultPriority>(EdgeCapture::Trigger::Falling);
+    EdgeCapture::add<M2_Fault, EdgeCapture::FaultPriority>(EdgeCapture::Trigger::Falling);
 
+    modm::fiber::Scheduler::run();
     return 0;
 }
@@ -0,0 +1,237 @@
+#include "mission.hpp"
+#include "motor_control.hpp"
+#include "control_executive.hpp"
+#include "odometry.hpp"
+#include "fault_monitor.hpp"
+
+#include <charconv>
+#include <modm/architecture/interface/atomic_lock.hpp>
+#include <modm/debug/logger.hpp>
+#include <modm/processing/fiber.hpp>
+
+using namespace Board;
+
+namespace
+{
+    Mission::Follower follower;
+    uint32_t started{0};    ///< completed primitives at the start of the run
+
+    /// The command line being received and the state of the last poll
+    struct Reader
+    {
+        char line[32];
+        size_t length{0};
+        bool overflow{false};
+        bool running{false};
+    };
+    Reader reader;
+
+    /// One more signed integer after spaces
+    bool
+    parse(std::string_view &text, int32_t &value)
+    {
+        while (not text.empty() and text.front() == ' ') {
+            text.remove_prefix(1);
+        }
+        const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (error != std::errc()) {
+            return false;
+        }
+        text.remove_prefix(end - text.data());
+        return true;
+    }
+
+    /// mm to um, limited to 10 m
+    bool
+    toDistance(int32_t millimeter, int32_t &micrometer)
+    {
+        if (millimeter < -10'000 or millimeter > 10'000) {
+            return false;
+        }
+        micrometer = millimeter * 1000;
+        return true;
+    }
+
+    /// Degree to Q1.31, without the ambiguous half turn
+    bool
+    toAngle(int32_t degree, int32_t &angle)
+    {
+        if (degree <= -180 or degree >= 180) {
+            return false;
+        }
+        angle = (int64_t(degree) << 31) / 180;
+        return true;
+    }
+
+    bool
+    push(const PathPrimitive &primitive)
+    {
+        modm::atomic::Lock lock;
+        return follower.push(primitive);
+    }
+
+    // Task in the control stage of the ControlExecutive
+    void
+    follow()
+    {
+        if (not follower.isRunning()) {
+            return;
+        }
+        if (FaultMonitor::isLatched()) {
+            follower.stop();
+            return;
+        }
+        const Odometry::Pose pose = Odometry::getPose();
+        const auto command = follower.update({pose.x, pose.y, pose.heading});
+        MotorControl::setSpeed(command.left, command.right);
+    }
+}
+
+void
+Mission::initialize()
+{
+    ControlExecutive::add(ControlExecutive::Stage::Control, follow);
+}
+
+bool
+Mission::execute(std::string_view line)
+{
+    while (not line.empty() and line.back() == ' ') {
+        line.remove_suffix(1);
+    }
+    if (line.empty()) {
+        return false;
+    }
+    const char command = line.front();
+    line.remove_prefix(1);
+
+    int32_t first, second;
+    switch (command)
+    {
+        case 'd':
+            if (parse(line, first) and toDistance(first, first)) {
+                return line.empty() and push(PathPrimitive::drive(first));
+            }
+            return false;
+
+        case 't':
+            if (parse(line, first) and toAngle(first, first)) {
+                return line.empty() and push(PathPrimitive::turn(first));
+            }
+            return false;
+
+        case 'a':
+            if (parse(line, first) and toDistance(first, first) and first > 0 and
+                parse(line, second) and toAngle(second, second)) {
+                return line.empty() and push(PathPrimitive::arc(first, second));
+            }
+            return false;
+
+        case 'g':
+            if (parse(line, first) and toDistance(first, first) and
+                parse(line, second) and toDistance(second, second)) {
+                return line.empty() and push(PathPrimitive::moveTo(first, second));
+            }
+            return false;
+
+        case 'r':
+        {
+            if (not line.empty() or FaultMonitor::isLatched()) {
+                return false;
+            }
+            const Odometry::Pose pose = Odometry::getPose();
+            modm::atomic::Lock lock;
+            if (not follower.isRunning())
+            {
+                started = follower.getCompleted();
+                follower.start({pose.x, pose.y, pose.heading});
+            }
+            return true;
+        }
+
+        case 's':
+            if (not line.empty()) {
+                return false;
+            }
+            stop();
+            return true;
+    }
+    return false;
+}
+
+void
+Mission::stop()
+{
+    bool running;
+    {
+        modm::atomic::Lock lock;
+        running = follower.isRunning();
+        follower.stop();
+    }
+    if (running) {
+        MotorControl::setSpeed(0, 0);
+    }
+}
+
+bool
+Mission::isRunning()
+{
+    return follower.isRunning();
+}
+
+size_t
+Mission::getQueued()
+{
+    return follower.getQueued();
+}
+
+void
+Mission::poll()
+{
+    if (reader.running and not isRunning()) {
+        MODM_LOG_INFO << "md " << (follower.getCompleted() - started) << modm::endl; // "Mission done, primitives."
+    }
+    reader.running = isRunning();
+
+    uint8_t character;
+    while (DebugUart::DebugUart::read(character))
+    {
+        if (character != '\n' and character != '\r')
+        {
+            // too long lines are dropped as a whole
+            if (reader.length < sizeof(reader.line)) {
+                reader.line[reader.length++] = character;
+            } else {
+                reader.overflow = true;
+            }
+            continue;
+        }
+        if (reader.length == 0 and not reader.overflow) {
+            continue;
+        }
+
+        const std::string_view text(reader.line, reader.length);
+        if (reader.overflow or not execute(text)) {
+            MODM_LOG_INFO << "me" << modm::endl; // "Invalid mission command."
+        } else if (text.front() == 'r') {
+            MODM_LOG_INFO << "mr" << modm::endl; // "Mission running."
+        } else if (text.front() == 's') {
+            MODM_LOG_INFO << "ms" << modm::endl; // "Mission stopped."
+        } else {
+            MODM_LOG_INFO << "mq " << follower.getQueued() << modm::endl; // "Primitives queued."
+        }
+        reader.running = isRunning();
+        reader.length = 0;
+        reader.overflow = false;
+    }
+}
+
+void
+Mission::serve()
+{
+    while (true)
+    {
+        poll();
+        modm::this_fiber::sleep_for(PollPeriod);
+    }
+}
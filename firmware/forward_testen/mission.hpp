@@ -0,0 +1,61 @@
+#ifndef MISSION_HPP
+#define MISSION_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "cordic.hpp"
+#include "path_follower.hpp"
+
+/**
+ * @brief Motion sequences uploaded over the debug UART.
+ *
+ * One command per line, all numbers are integers:
+ *
+ *     d <mm>          drive straight, negative backwards
+ *     t <deg>         turn in place, positive counterclockwise
+ *     a <mm> <deg>    arc with the radius, positive angles to the left
+ *     g <x> <y>       go straight to the point in mm of the odometry frame
+ *     r               run the queue from the current pose
+ *     s               stop and drop the queue
+ *
+ * Primitives may be queued while a mission runs. Every line is answered
+ * with "mq <queued>", "mr", "ms" or "me" if it is invalid or the queue is
+ * full, and "md <completed>" once the queue ran empty.
+ *
+ * The PathFollower is a task in the control stage of the ControlExecutive,
+ * so it steers with the pose of every control tick and the trigonometry runs
+ * on the CORDIC in the same interrupt as the Odometry.
+ */
+namespace Mission
+{
+    using Follower = PathFollower<Cordic::sincos, Cordic::atan2>;
+
+    /// Adds the follower to the control loop, call after MotorControl::initialize().
+    void initialize();
+
+    /// Executes one command line without the line ending.
+    /// @return false if the line is invalid or the queue is full
+    bool execute(std::string_view line);
+
+    /// Stops the motors and drops the queue.
+    void stop();
+
+    bool isRunning();
+
+    /// @return the number of primitives waiting in the queue
+    size_t getQueued();
+
+    /// The 64 byte receive buffer of the debug UART fills in 5.5 ms at 115200 Bd
+    static constexpr std::chrono::milliseconds PollPeriod{4};
+
+    /// Reads and answers the command lines received so far, reports a finished mission.
+    void poll();
+
+    /// Calls poll() every PollPeriod, never returns.
+    void serve();
+}
+
+#endif // MISSION_HPP
@@ -48,6 +48,31 @@ public:
 		Unknown				///< Unknown error condition
 	};
 
+	/// Bus health counters, updated by drivers that support them.
+	struct Statistics
+	{
+		/// Bin `n` counts latencies below `64us << n`, the last bin all above.
+		static constexpr size_t LatencyBins = 8;
+
+		uint32_t transactions;		///< Transactions detached by the driver
+		uint32_t addressNacks;
+		uint32_t dataNacks;
+		uint32_t arbitrationLosses;
+		uint32_t busErrors;			///< Misplaced Start or Stop conditions
+		uint32_t timeouts;			///< Stalled transactions and SCL low timeouts
+		uint32_t recoveries;		///< Bus recoveries performed
+		/// Time from attaching to detaching a transaction
+		uint32_t latency[LatencyBins];
+
+		void
+		addLatency(uint32_t us)
+		{
+			size_t bin = 0;
+			for (us >>= 6; us and bin < LatencyBins - 1; us >>= 1) bin++;
+			latency[bin]++;
+		}
+	};
+
 	enum class
 	PullUps
 	{
@@ -15,6 +15,7 @@
 #endif
 
 #include <modm/debug/logger.hpp>
+#include <algorithm>
 #include <type_traits>
 
 #define VL53L0_RF_CALL(rf) if(not RF_CALL(rf)) { RF_RETURN(false); }
@@ -23,7 +24,8 @@
 template < typename I2cMaster >
 modm::Vl53l0<I2cMaster>::Vl53l0(Data &data, uint8_t address)
 :	I2cDevice<I2cMaster, 5>{address}, data{data},
-	i2cBuffer{0,0,0,0,0,0,0}, index{0}, measurementTimeUs{DefaultMeasurementTime}
+	i2cBuffer{0,0,0,0,0,0,0}, index{0}, measurementTimeUs{DefaultMeasurementTime},
+	calibration{}
 {
 }
 
@@ -68,10 +70,15 @@ modm::Vl53l0<I2cMaster>::reset()
 
 template < typename I2cMaster >
 modm::ResumableResult<bool>
-modm::Vl53l0<I2cMaster>::initialize()
+modm::Vl53l0<I2cMaster>::initialize(const Calibration *stored)
 {
 	using namespace vl53l0_private;
 
+	// fall back to a full calibration if the stored data is unusable
+	if(stored and not stored->isValid()) {
+		stored = nullptr;
+	}
+
 	// "Disable MSRC and TCC by default"
 	// MSRC = Minimum Signal Rate Check
 	// TCC = Target Center Check
@@ -106,8 +113,9 @@ modm::Vl53l0<I2cMaster>::initialize()
 	// finish "data init" phase
 	VL53L0_RF_CALL(write(Register::SYSTEM__SEQUENCE_CONFIG, 0xFF));
 
-	// load SPAD calibration data from NVM and initialize dynamic SPAD configuration
-	VL53L0_RF_CALL(initializeSpadConfig());
+	// load SPAD calibration data from NVM or the stored calibration
+	// and initialize dynamic SPAD configuration
+	VL53L0_RF_CALL(initializeSpadConfig(stored));
 
 	VL53L0_RF_CALL(loadTuningSettings());
 
@@ -123,18 +131,40 @@ modm::Vl53l0<I2cMaster>::initialize()
 	// recalculate measurement timings
 	VL53L0_RF_CALL(setMaxMeasurementTime(this->measurementTimeUs));
 
-	// VHV calibration
-	VL53L0_RF_CALL(write(Register::SYSTEM__SEQUENCE_CONFIG, MeasurementSequenceStep::VhvCalibration));
-	if(not RF_CALL(performReferenceCalibration(Start::VhvCalibrationMode))) {
-		MODM_LOG_ERROR << "VHV calibration failed." << modm::endl;
-		RF_RETURN(false);
+	if(stored)
+	{
+		// restore VHV and phase settings instead of measuring them
+		calibration.vhvSettings = stored->vhvSettings;
+		calibration.phaseCalibration = stored->phaseCalibration;
+
+		VL53L0_RF_CALL(write(Register(0xFF), 0x01));
+		VL53L0_RF_CALL(write(Register(0xCB), calibration.vhvSettings));
+		VL53L0_RF_CALL(updateControlRegister(Register(0xEE),
+											 Control_t(calibration.phaseCalibration), Control_t(0x7F)));
+		VL53L0_RF_CALL(write(Register(0xFF), 0x00));
 	}
+	else
+	{
+		// VHV calibration
+		VL53L0_RF_CALL(write(Register::SYSTEM__SEQUENCE_CONFIG, MeasurementSequenceStep::VhvCalibration));
+		if(not RF_CALL(performReferenceCalibration(Start::VhvCalibrationMode))) {
+			MODM_LOG_ERROR << "VHV calibration failed." << modm::endl;
+			RF_RETURN(false);
+		}
 
-	// phase calibration
-	VL53L0_RF_CALL(write(Register::SYSTEM__SEQUENCE_CONFIG, MeasurementSequenceStep::PhaseCalibration));
-	if(not RF_CALL(performReferenceCalibration())) {
-		MODM_LOG_ERROR << "Phase calibration failed." << modm::endl;
-		RF_RETURN(false);
+		// phase calibration
+		VL53L0_RF_CALL(write(Register::SYSTEM__SEQUENCE_CONFIG, MeasurementSequenceStep::PhaseCalibration));
+		if(not RF_CALL(performReferenceCalibration())) {
+			MODM_LOG_ERROR << "Phase calibration failed." << modm::endl;
+			RF_RETURN(false);
+		}
+
+		// read back the calibration results for export
+		VL53L0_RF_CALL(write(Register(0xFF), 0x01));
+		VL53L0_RF_CALL(read(Register(0xCB), calibration.vhvSettings));
+		VL53L0_RF_CALL(read(Register(0xEE), calibration.phaseCalibration));
+		VL53L0_RF_CALL(write(Register(0xFF), 0x00));
+		calibration.phaseCalibration &= 0xEF;
 	}
 
 	// restore measurement sequence settings
@@ -194,10 +224,12 @@ modm::Vl53l0<I2cMaster>::readSensor()
 		return value & (InterruptStatus::NewSampleReady | InterruptStatus::OutOfWindow).value;
 	}, measurementTimeUs / 1000 * 2));
 
-	// read 16 bit range value
-	VL53L0_RF_CALL(read(Register::RESULT__RANGE_VALUE0, &i2cBuffer[1], 2));
-	data.distanceBuffer[0] = i2cBuffer[1];
-	data.distanceBuffer[1] = i2cBuffer[2];
+	// read signal rate, ambient rate and 16 bit range value in one transfer
+	VL53L0_RF_CALL(read(Register::RESULT__SIGNAL_RATE, &i2cBuffer[1], 6));
+	data.signalRateBuffer[0] = i2cBuffer[1];
+	data.signalRateBuffer[1] = i2cBuffer[2];
+	data.distanceBuffer[0] = i2cBuffer[5];
+	data.distanceBuffer[1] = i2cBuffer[6];
 
 	// clear interrupt flag
 	VL53L0_RF_CALL(write(Register::SYSTEM__INTERRUPT_CLEAR, InterruptClear::Range));
@@ -277,43 +309,51 @@ modm::Vl53l0<I2cMaster>::setDeviceAddress(uint8_t address)
 
 template < typename I2cMaster >
 modm::ResumableResult<bool>
-modm::Vl53l0<I2cMaster>::initializeSpadConfig()
+modm::Vl53l0<I2cMaster>::initializeSpadConfig(const Calibration *stored)
 {
 	RF_BEGIN();
 
-	// read number and type of SPADs to be used for calibration
-	VL53L0_RF_CALL(write(Register(0x80), 0x01));
-	VL53L0_RF_CALL(write(Register(0xFF), 0x01));
-	VL53L0_RF_CALL(write(Register(0x00), 0x00));
-	VL53L0_RF_CALL(write(Register(0xFF), 0x06));
-	VL53L0_RF_CALL(updateControlRegister(Register(0x83), Control_t(4), Control_t(0)));
-	VL53L0_RF_CALL(write(Register(0xFF), 0x07));
-	VL53L0_RF_CALL(write(Register(0x81), 0x01));
-	VL53L0_RF_CALL(write(Register(0x80), 0x01));
-
-	VL53L0_RF_CALL(write(Register(0x94), 0x6b));
-	VL53L0_RF_CALL(write(Register(0x83), 0x00));
-
-	VL53L0_RF_CALL(poll(Register(0x83), [](uint8_t value) {
-		return value != 0x00;
-	}));
-
-	VL53L0_RF_CALL(write(Register(0x83), 0x01));
-	VL53L0_RF_CALL(read(Register(0x92), i2cBuffer[1]));
-
-	spadInfo.referenceSpadCount = i2cBuffer[1] & 0x7F;
-	spadInfo.useApertureSpads = (i2cBuffer[1] & (1 << 7)) != 0;
-
-	VL53L0_RF_CALL(write(Register(0x81), 0x00));
-	VL53L0_RF_CALL(write(Register(0xFF), 0x06));
-	VL53L0_RF_CALL(updateControlRegister(Register(0x83), Control_t(0), Control_t(4)));
-	VL53L0_RF_CALL(write(Register(0xFF), 0x01));
-	VL53L0_RF_CALL(write(Register(0x00), 0x01));
-	VL53L0_RF_CALL(write(Register(0xFF), 0x00));
-	VL53L0_RF_CALL(write(Register(0x80), 0x00));
-
-	// read map of SPADs available for reference calibration
-	VL53L0_RF_CALL(read(Register::GLOBAL__CONFIG_SPAD_ENABLES_REF_0, spadInfo.map, 6));
+	if(stored)
+	{
+		spadInfo.referenceSpadCount = stored->referenceSpadCount;
+		spadInfo.useApertureSpads = stored->useApertureSpads;
+	}
+	else
+	{
+		// read number and type of SPADs to be used for calibration
+		VL53L0_RF_CALL(write(Register(0x80), 0x01));
+		VL53L0_RF_CALL(write(Register(0xFF), 0x01));
+		VL53L0_RF_CALL(write(Register(0x00), 0x00));
+		VL53L0_RF_CALL(write(Register(0xFF), 0x06));
+		VL53L0_RF_CALL(updateControlRegister(Register(0x83), Control_t(4), Control_t(0)));
+		VL53L0_RF_CALL(write(Register(0xFF), 0x07));
+		VL53L0_RF_CALL(write(Register(0x81), 0x01));
+		VL53L0_RF_CALL(write(Register(0x80), 0x01));
+
+		VL53L0_RF_CALL(write(Register(0x94), 0x6b));
+		VL53L0_RF_CALL(write(Register(0x83), 0x00));
+
+		VL53L0_RF_CALL(poll(Register(0x83), [](uint8_t value) {
+			return value != 0x00;
+		}));
+
+		VL53L0_RF_CALL(write(Register(0x83), 0x01));
+		VL53L0_RF_CALL(read(Register(0x92), i2cBuffer[1]));
+
+		spadInfo.referenceSpadCount = i2cBuffer[1] & 0x7F;
+		spadInfo.useApertureSpads = (i2cBuffer[1] & (1 << 7)) != 0;
+
+		VL53L0_RF_CALL(write(Register(0x81), 0x00));
+		VL53L0_RF_CALL(write(Register(0xFF), 0x06));
+		VL53L0_RF_CALL(updateControlRegister(Register(0x83), Control_t(0), Control_t(4)));
+		VL53L0_RF_CALL(write(Register(0xFF), 0x01));
+		VL53L0_RF_CALL(write(Register(0x00), 0x01));
+		VL53L0_RF_CALL(write(Register(0xFF), 0x00));
+		VL53L0_RF_CALL(write(Register(0x80), 0x00));
+
+		// read map of SPADs available for reference calibration
+		VL53L0_RF_CALL(read(Register::GLOBAL__CONFIG_SPAD_ENABLES_REF_0, spadInfo.map, 6));
+	}
 
 	// prepare setting SPAD config
 	VL53L0_RF_CALL(write(Register(0xFF), 0x01));
@@ -322,7 +362,12 @@ modm::Vl53l0<I2cMaster>::initializeSpadConfig()
 	VL53L0_RF_CALL(write(Register(0xFF), 0x00));
 	VL53L0_RF_CALL(write(Register::GLOBAL__CONFIG_REF_EN_START_SELECT, 0xB4));
 
-	if(not setupReferenceSpadMap(spadInfo.map, &i2cBuffer[1]))
+	if(stored)
+	{
+		// the stored map already contains the selected reference SPADs
+		std::copy_n(stored->spadMap, 6, &i2cBuffer[1]);
+	}
+	else if(not setupReferenceSpadMap(spadInfo.map, &i2cBuffer[1]))
 	{
 		MODM_LOG_ERROR << "Invalid SPAD data in non-volatile memory.\n";
 		MODM_LOG_ERROR << "A full 'SPAD management' recalibration has to be performed.\n";
@@ -332,6 +377,10 @@ modm::Vl53l0<I2cMaster>::initializeSpadConfig()
 		RF_RETURN(false);
 	}
 
+	calibration.referenceSpadCount = spadInfo.referenceSpadCount;
+	calibration.useApertureSpads = spadInfo.useApertureSpads;
+	std::copy_n(&i2cBuffer[1], 6, calibration.spadMap);
+
 	// Write SPAD config to the device. This will not be written to NVM.
 	VL53L0_RF_CALL(writeI2CBuffer(Register::GLOBAL__CONFIG_SPAD_ENABLES_REF_0, 6));
 
@@ -0,0 +1,377 @@
+/*
+ * Copyright (c) 2026, modm project
+ *
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+#	include <arm_acle.h>
+#	define MODM_FIXED_POINT_DSP 1
+#endif
+
+namespace modm
+{
+
+/**
+ * Saturating integer primitives of the fixed-point types.
+ *
+ * On Cortex-M cores with the DSP extension they compile to single QADD,
+ * QSUB, SSAT and SMLAD instructions, everywhere else and in constant
+ * expressions to portable C++ with the same results.
+ *
+ * @ingroup modm_math_fixed_point
+ */
+namespace fixed_point
+{
+
+/// Clamps a value to the range of `T`.
+template< std::signed_integral T >
+constexpr T
+saturate(int64_t value)
+{
+	if (value > std::numeric_limits<T>::max()) return std::numeric_limits<T>::max();
+	if (value < std::numeric_limits<T>::min()) return std::numeric_limits<T>::min();
+	return T(value);
+}
+
+/// Clamps a value to the range of a signed integer with `Bits` bits.
+template< int Bits >
+constexpr int32_t
+saturate(int32_t value)
+{
+	static_assert(1 <= Bits and Bits <= 32);
+#ifdef MODM_FIXED_POINT_DSP
+	if (not std::is_constant_evaluated()) {
+		return __ssat(value, Bits);
+	}
+#endif
+	if constexpr (Bits == 32) {
+		return value;
+	} else {
+		constexpr int32_t max = (int32_t(1) << (Bits - 1)) - 1;
+		return (value > max) ? max : (value < -max - 1) ? -max - 1 : value;
+	}
+}
+
+/// Saturating 32-bit addition
+constexpr int32_t
+add(int32_t a, int32_t b)
+{
+#ifdef MODM_FIXED_POINT_DSP
+	if (not std::is_constant_evaluated()) {
+		return __qadd(a, b);
+	}
+#endif
+	return saturate<int32_t>(int64_t(a) + b);
+}
+
+/// Saturating 32-bit subtraction
+constexpr int32_t
+sub(int32_t a, int32_t b)
+{
+#ifdef MODM_FIXED_POINT_DSP
+	if (not std::is_constant_evaluated()) {
+		return __qsub(a, b);
+	}
+#endif
+	return saturate<int32_t>(int64_t(a) - b);
+}
+
+/**
+ * Dual 16-bit multiply-accumulate of two packed pairs:
+ *
+ * \code
+ * accumulator + x.low * y.low + x.high * y.high
+ * \endcode
+ *
+ * The sum wraps around like the SMLAD instruction.
+ */
+constexpr int32_t
+smlad(uint32_t x, uint32_t y, int32_t accumulator)
+{
+#ifdef MODM_FIXED_POINT_DSP
+	if (not std::is_constant_evaluated()) {
+		return __smlad(x, y, accumulator);
+	}
+#endif
+	const int32_t low = int32_t(int16_t(x)) * int16_t(y);
+	const int32_t high = int32_t(int16_t(x >> 16)) * int16_t(y >> 16);
+	return int32_t(uint32_t(accumulator) + uint32_t(low) + uint32_t(high));
+}
+
+/**
+ * Dot product of two 16-bit vectors with a 64-bit accumulator.
+ *
+ * Processes two elements per SMLALD instruction when the DSP extension is
+ * available. The result has the sum of both fractional bit counts.
+ */
+constexpr int64_t
+dot(const int16_t *a, const int16_t *b, std::size_t length)
+{
+	int64_t sum{0};
+	std::size_t ii{0};
+#ifdef MODM_FIXED_POINT_DSP
+	if (not std::is_constant_evaluated())
+	{
+		for (; ii + 1 < length; ii += 2)
+		{
+			const uint32_t x = uint16_t(a[ii]) | (uint32_t(uint16_t(a[ii + 1])) << 16);
+			const uint32_t y = uint16_t(b[ii]) | (uint32_t(uint16_t(b[ii + 1])) << 16);
+			sum = __smlald(x, y, sum);
+		}
+	}
+#endif
+	for (; ii < length; ii++) {
+		sum += int32_t(a[ii]) * b[ii];
+	}
+	return sum;
+}
+
+} // namespace fixed_point
+
+/**
+ * Signed fixed-point number with `Fraction` fractional bits in a `T`.
+ *
+ * All arithmetic saturates instead of wrapping around and rounds to the
+ * nearest representable value, so the results do not depend on the target
+ * and do not need an FPU. Conversions from floating-point values are only
+ * allowed at compile time, conversions between formats are explicit:
+ *
+ * \code
+ * constexpr modm::Q15 gain = 0.75;
+ * const modm::Q31 error = modm::Q31::fromRaw(sample) - setpoint;
+ * const auto output = modm::Q16_16(error * gain);
+ * \endcode
+ *
+ * @tparam T		signed integer storage
+ * @tparam Fraction	number of fractional bits, at most the bits of `T` minus one
+ *
+ * @ingroup modm_math_fixed_point
+ */
+template< std::signed_integral T, int Fraction >
+class FixedPoint
+{
+	static_assert(sizeof(T) <= 4, "The intermediate results must fit into 64 bits!");
+	static_assert(0 <= Fraction and Fraction < int(sizeof(T) * 8),
+				  "The fractional bits must leave room for the sign!");
+
+	template< std::signed_integral, int >
+	friend class FixedPoint;
+
+public:
+	using Storage = T;
+	static constexpr int FractionalBits = Fraction;
+	static constexpr int IntegerBits = int(sizeof(T) * 8) - 1 - Fraction;
+
+	constexpr FixedPoint() = default;
+
+	/// Compile-time conversion, saturates out of range values
+	consteval FixedPoint(double value) :
+		value(fixed_point::saturate<T>(round(value * double(int64_t(1) << Fraction))))
+	{}
+
+	/// Converts from another format, rounded and saturated
+	template< std::signed_integral U, int G >
+	constexpr explicit FixedPoint(FixedPoint<U, G> other) :
+		value(fixed_point::saturate<T>(shift<Fraction - G>(other.value)))
+	{}
+
+	static constexpr FixedPoint
+	fromRaw(T raw)
+	{
+		FixedPoint result;
+		result.value = raw;
+		return result;
+	}
+
+	/// @return `numerator / denominator`, saturated, zero for a zero denominator
+	static constexpr FixedPoint
+	fromRatio(int32_t numerator, int32_t denominator)
+	{
+		if (denominator == 0) return FixedPoint();
+		return fromRaw(fixed_point::saturate<T>(divide(int64_t(numerator) << Fraction, denominator)));
+	}
+
+	static constexpr FixedPoint
+	fromInteger(int32_t integer)
+	{
+		return fromRaw(fixed_point::saturate<T>(int64_t(integer) << Fraction));
+	}
+
+	/// Runtime conversion for logging and tests, rounded and saturated
+	static constexpr FixedPoint
+	fromFloat(float value)
+	{
+		return fromRaw(fixed_point::saturate<T>(round(double(value) * double(int64_t(1) << Fraction))));
+	}
+
+	static constexpr FixedPoint
+	max()
+	{
+		return fromRaw(std::numeric_limits<T>::max());
+	}
+
+	static constexpr FixedPoint
+	min()
+	{
+		return fromRaw(std::numeric_limits<T>::min());
+	}
+
+	constexpr T
+	raw() const
+	{
+		return value;
+	}
+
+	/// @return the integer part, rounded towards negative infinity
+	constexpr int32_t
+	integer() const
+	{
+		return int32_t(value >> Fraction);
+	}
+
+	constexpr float
+	toFloat() const
+	{
+		return float(value) / float(int64_t(1) << Fraction);
+	}
+
+	/// @return `integer * this`, rounded and saturated, e.g. a compare value from a duty
+	template< std::integral I >
+	constexpr I
+	scale(I integer) const
+	{
+		const int64_t product = shift<-Fraction>(int64_t(integer) * value);
+		if constexpr (std::is_signed_v<I>) {
+			return fixed_point::saturate<I>(product);
+		} else {
+			return (product < 0) ? 0 : (uint64_t(product) > std::numeric_limits<I>::max()) ?
+					std::numeric_limits<I>::max() : I(product);
+		}
+	}
+
+	constexpr FixedPoint
+	operator-() const
+	{
+		return fromRaw(fixed_point::saturate<T>(-int64_t(value)));
+	}
+
+	constexpr FixedPoint
+	operator+(FixedPoint other) const
+	{
+		if constexpr (sizeof(T) == 4) {
+			return fromRaw(fixed_point::add(value, other.value));
+		} else {
+			return fromRaw(T(fixed_point::saturate<sizeof(T) * 8>(int32_t(value) + other.value)));
+		}
+	}
+
+	constexpr FixedPoint
+	operator-(FixedPoint other) const
+	{
+		if constexpr (sizeof(T) == 4) {
+			return fromRaw(fixed_point::sub(value, other.value));
+		} else {
+			return fromRaw(T(fixed_point::saturate<sizeof(T) * 8>(int32_t(value) - other.value)));
+		}
+	}
+
+	/// Product in the format of the left operand, rounded and saturated
+	template< std::signed_integral U, int G >
+	constexpr FixedPoint
+	operator*(FixedPoint<U, G> other) const
+	{
+		return fromRaw(fixed_point::saturate<T>(shift<-G>(int64_t(value) * other.value)));
+	}
+
+	constexpr FixedPoint
+	operator*(int32_t integer) const
+	{
+		return fromRaw(fixed_point::saturate<T>(int64_t(value) * integer));
+	}
+
+	/// Quotient, rounded and saturated, division by zero saturates towards the sign
+	constexpr FixedPoint
+	operator/(FixedPoint other) const
+	{
+		if (other.value == 0) return (value < 0) ? min() : max();
+		return fromRaw(fixed_point::saturate<T>(divide(int64_t(value) << Fraction, other.value)));
+	}
+
+	constexpr FixedPoint&
+	operator+=(FixedPoint other) { return *this = *this + other; }
+
+	constexpr FixedPoint&
+	operator-=(FixedPoint other) { return *this = *this - other; }
+
+	template< std::signed_integral U, int G >
+	constexpr FixedPoint&
+	operator*=(FixedPoint<U, G> other) { return *this = *this * other; }
+
+	constexpr FixedPoint&
+	operator/=(FixedPoint other) { return *this = *this / other; }
+
+	constexpr auto
+	operator<=>(const FixedPoint&) const = default;
+
+private:
+	/// Arithmetic shift left or right by `Bits`, right shifts round to nearest
+	template< int Bits >
+	static constexpr int64_t
+	shift(int64_t raw)
+	{
+		if constexpr (Bits >= 0) {
+			const int64_t limit = int64_t(1) << (62 - Bits);
+			if (raw >= limit) return INT64_MAX;
+			if (raw < -limit) return INT64_MIN;
+			return raw * (int64_t(1) << Bits);
+		} else {
+			return (raw + (int64_t(1) << (-Bits - 1))) >> -Bits;
+		}
+	}
+
+	/// Division rounded to nearest
+	static constexpr int64_t
+	divide(int64_t numerator, int64_t denominator)
+	{
+		const int64_t half = ((numerator < 0) == (denominator < 0)) ? denominator / 2 : -denominator / 2;
+		return (numerator + half) / denominator;
+	}
+
+	static constexpr int64_t
+	round(double value)
+	{
+		constexpr double limit = 9.2e18;
+		if (value >= limit) return INT64_MAX;
+		if (value <= -limit) return INT64_MIN;
+		return int64_t(value + ((value < 0) ? -0.5 : 0.5));
+	}
+
+	T value{0};
+};
+
+/// @ingroup modm_math_fixed_point
+/// @{
+/// Signed fraction in [-1, 1) with 16 bits
+using Q15 = FixedPoint<int16_t, 15>;
+/// Signed fraction in [-1, 1) with 32 bits
+using Q31 = FixedPoint<int32_t, 31>;
+/// Signed number in [-32768, 32768) with 16 fractional bits
+using Q16_16 = FixedPoint<int32_t, 16>;
+/// @}
+
+} // namespace modm
@@ -29,12 +29,15 @@
 #include "platform/gpio/static.hpp"
 #include "platform/gpio/unused.hpp"
 #include "platform/i2c/i2c_master_1.hpp"
+#include "platform/i2c/i2c_master_3.hpp"
 #include "platform/i2c/i2c_timing_calculator.hpp"
 #include "platform/timer/basic_base.hpp"
 #include "platform/timer/general_purpose_base.hpp"
 #include "platform/timer/timer_15.hpp"
+#include "platform/timer/timer_17.hpp"
 #include "platform/timer/timer_2.hpp"
 #include "platform/timer/timer_3.hpp"
+#include "platform/timer/timer_5.hpp"
 #include "platform/uart/uart.hpp"
 #include "platform/uart/uart_base.hpp"
 #include "platform/uart/uart_buffer.hpp"
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2026, modm project
+ *
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <modm/architecture/interface/atomic_lock.hpp>
+
+namespace modm::platform
+{
+
+/**
+ * Steady 64-bit microsecond clock from a free-running 32-bit timer.
+ *
+ * The timer counts microseconds, its update interrupt extends the counter by
+ * the number of overflows, once every 71 minutes. Reading the clock takes no
+ * lock: the overflow count is read before and after the counter, and an
+ * overflow whose interrupt has not run yet is taken from the update flag,
+ * so `now()` is correct from any context, also with interrupts disabled,
+ * for up to half a timer period.
+ *
+ * Call `handleInterrupt()` from the update vector of the timer. To make the
+ * timer the time base of `modm::Clock` and `modm::PreciseClock`, and so of
+ * the timeouts and fibers, define their `now()` with it, they are weak:
+ *
+ * @code
+ * using Clock = TimerClock<Timer5>;
+ * MODM_ISR(TIM5) { Clock::handleInterrupt(); }
+ * modm::chrono::micro_clock::time_point modm::chrono::micro_clock::now() noexcept
+ * { return time_point{duration{uint32_t(Clock::now().time_since_epoch().count())}}; }
+ * @endcode
+ *
+ * @tparam	Timer	a modm timer with a 32-bit counter, e.g. `Timer2` or `Timer5`
+ * @ingroup	modm_platform_clock
+ */
+template< class Timer >
+class TimerClock
+{
+	static_assert(sizeof(typename Timer::Value) == 4, "The timer must have a 32-bit counter!");
+
+public:
+	using duration = std::chrono::duration<uint64_t, std::micro>;
+	using rep = duration::rep;
+	using period = duration::period;
+	using time_point = std::chrono::time_point<TimerClock, duration>;
+	static constexpr bool is_steady = true;
+
+	static constexpr uint32_t Frequency = 1'000'000;
+
+	/**
+	 * Starts the timer at 1 MHz from zero and enables its update interrupt.
+	 *
+	 * The timer may be shared with input captures that use the same tick
+	 * frequency, as long as they neither reset nor reconfigure it.
+	 */
+	template< class SystemClock >
+	static void
+	initialize(uint32_t priority = 15)
+	{
+		static_assert(Timer::template getClockFrequency<SystemClock>() % Frequency == 0,
+					  "The timer clock must be a multiple of 1 MHz!");
+		Timer::enable();
+		Timer::setMode(Timer::Mode::UpCounter);
+		Timer::setPrescaler(Timer::template getClockFrequency<SystemClock>() / Frequency);
+		Timer::setOverflow(~0ul);
+		Timer::applyAndReset();
+		Timer::acknowledgeInterruptFlags(Timer::InterruptFlag::Update);
+		overflows = 0;
+
+		Timer::enableInterrupt(Timer::Interrupt::Update);
+		Timer::enableInterruptVector(true, priority);
+		Timer::start();
+	}
+
+	static time_point
+	now() noexcept
+	{
+		uint32_t high, low;
+		bool pending;
+		do
+		{
+			high = overflows;
+			low = Timer::getValue();
+			pending = bool(Timer::getInterruptFlags() & Timer::InterruptFlag::Update);
+		}
+		while (high != overflows);
+		// the counter wrapped, but the interrupt did not run yet
+		if (pending and low < (1ul << 31)) {
+			high++;
+		}
+		return time_point{duration{(uint64_t(high) << 32) | low}};
+	}
+
+	/// Counts an overflow, call from the update interrupt of the timer.
+	static void
+	handleInterrupt()
+	{
+		// a now() in a higher priority interrupt must see both or neither
+		modm::atomic::Lock lock;
+		if (Timer::getInterruptFlags() & Timer::InterruptFlag::Update)
+		{
+			Timer::acknowledgeInterruptFlags(Timer::InterruptFlag::Update);
+			overflows = overflows + 1;
+		}
+	}
+
+private:
+	static inline volatile uint32_t overflows{0};
+};
+
+}	// namespace modm::platform
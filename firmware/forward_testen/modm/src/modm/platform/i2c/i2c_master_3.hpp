@@ -0,0 +1,197 @@
+// coding: utf-8
+/*
+ * Copyright (c) 2017, Sascha Schade
+ * Copyright (c) 2017-2018, Niklas Hauser
+ * Copyright (c) 2018, 2023, Christopher Durand
+ *
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef MODM_STM32_I2C_3_HPP
+#define MODM_STM32_I2C_3_HPP
+
+#include <modm/architecture/interface/interrupt.hpp>
+#include <modm/architecture/interface/i2c_master.hpp>
+#include <modm/architecture/interface/clock.hpp>
+#include <modm/platform/gpio/connector.hpp>
+
+#include "i2c_timing_calculator.hpp"
+#include <algorithm>
+
+namespace modm
+{
+
+namespace platform
+{
+
+/**
+ * I2cMaster implementation of I2C3 module.
+ *
+ * Interrupts must be enabled.
+ *
+ * @author		Georgi Grinshpun
+ * @author		Niklas Hauser
+ * @author		Sascha Schade (strongly-typed)
+ * @ingroup		modm_platform_i2c modm_platform_i2c_3
+ */
+class I2cMaster3 : public ::modm::I2cMaster
+{
+public:
+	static constexpr size_t TransactionBufferSize = 8;
+	/// Transactions running longer are aborted by supervise()
+	static constexpr std::chrono::milliseconds TransactionTimeout{25};
+	/// Timeout of the hardware SCL low detection
+	static constexpr std::chrono::milliseconds SclLowTimeout{25};
+
+private:
+	template<class SystemClock, baudrate_t baudrate, percent_t tolerance>
+	static constexpr std::optional<uint32_t>
+	calculateTimings()
+	{
+		constexpr I2cParameters parameters = {
+			.peripheralClock = SystemClock::I2c3,
+			.targetSpeed = baudrate,
+			.tolerance = tolerance,
+			.digitalFilterLength = 0,
+			.enableAnalogFilter = true,
+			.riseTime = 0,
+			.fallTime = 0
+		};
+
+		auto calculator = I2cTimingCalculator{parameters};
+
+		std::optional<I2cMasterTimings> timings = calculator.calculateTimings();
+		if(timings) {
+			return I2cTimingCalculator::timingsToRegisterValue(timings.value());
+		} else {
+			return std::nullopt;
+		}
+	}
+
+public:
+	template<class... Signals>
+	static void
+	connect(PullUps pullups = PullUps::External, ResetDevices reset = ResetDevices::Standard)
+	{
+		using Connector = GpioConnector<Peripheral::I2c3, Signals...>;
+		using Scl = typename Connector::template GetSignal<Gpio::Signal::Scl>;
+		using Sda = typename Connector::template GetSignal<Gpio::Signal::Sda>;
+		static_assert(sizeof...(Signals) == 2 and
+					  Connector::template IsValid<Scl> and Connector::template IsValid<Sda>,
+					  "I2cMaster3::connect() requires one Scl and one Sda signal!");
+		const Gpio::InputType input =
+			(pullups == PullUps::Internal) ? Gpio::InputType::PullUp : Gpio::InputType::Floating;
+
+		Connector::disconnect();
+		Scl::configure(input);
+		Sda::configure(input);
+		Scl::setOutput(Gpio::OutputType::OpenDrain);
+		Sda::setOutput(Gpio::OutputType::OpenDrain);
+		if (reset != ResetDevices::NoReset) resetDevices<Scl>(uint32_t(reset));
+		Connector::connect();
+
+		busReset = resetBus<Connector, Scl, Sda>;
+	}
+
+	/**
+	 * Set up the I2C module for master operation.
+	 *
+	 * @param	rate
+	 *		`Standard` or `Fast`, `High` datarate is not supported
+	 */
+	template<class SystemClock, baudrate_t baudrate=kBd(100), percent_t tolerance=pct(5)>
+	static void
+	initialize(uint8_t isrPriority = 10u)
+	{
+		constexpr std::optional<uint32_t> timingRegisterValue = calculateTimings<SystemClock, baudrate, tolerance>();
+		static_assert(bool(timingRegisterValue), "Could not find a valid clock configuration for the requested baudrate");
+
+		// tTIMEOUT = (TIMEOUTA + 1) * 2048 * tI2CCLK
+		constexpr uint64_t timeoutCycles = uint64_t(SystemClock::I2c3) * SclLowTimeout.count() / 1000;
+		constexpr uint32_t timeoutRegisterValue = std::min<uint64_t>(timeoutCycles / 2048, 4096) - 1;
+
+		initializeWithPrescaler(timingRegisterValue.value(), isrPriority, timeoutRegisterValue);
+	}
+
+	static bool
+	start(I2cTransaction *transaction, ConfigurationHandler handler = nullptr);
+
+	static Error
+	getErrorState();
+
+	static void
+	reset();
+
+	/**
+	 * Checks the bus for a stalled transaction or a stuck bus.
+	 *
+	 * Counts a timeout and calls recover() if the current transaction runs
+	 * longer than `TransactionTimeout`, or if the bus is busy while idle.
+	 * Also performs the recovery scheduled by a bus error or an SCL low
+	 * timeout. `modm::I2cDevice` calls this periodically while waiting in a
+	 * fiber.
+	 *
+	 * @return `true` if the bus was recovered.
+	 */
+	static bool
+	supervise();
+
+	/**
+	 * Recovers the bus from a slave holding SDA low.
+	 *
+	 * Fails the current transaction, disables the peripheral, clocks out
+	 * nine SCL pulses followed by a STOP condition, re-enables the peripheral
+	 * and then starts the queued transactions. After a bus error or an SCL
+	 * low timeout the error interrupt holds back the queue and the next
+	 * supervise() does this.
+	 *
+	 * @warning	Takes about 100us with interrupts enabled, call it from thread
+	 *			context only.
+	 */
+	static void
+	recover();
+
+	static const Statistics&
+	getStatistics();
+
+	static void
+	resetStatistics();
+
+private:
+	static void
+	initializeWithPrescaler(uint32_t timingRegisterValue, uint8_t isrPriority = 10u,
+							uint32_t timeoutRegisterValue = 0xfff);
+
+	template<class Connector, class Scl, class Sda>
+	static void
+	resetBus()
+	{
+		Connector::disconnect();
+		Sda::set();
+		Scl::set();
+		Scl::setOutput(Gpio::OutputType::OpenDrain);
+		Sda::setOutput(Gpio::OutputType::OpenDrain);
+		resetDevices<Scl>(uint32_t(ResetDevices::Standard));
+		// STOP condition: SDA rising while SCL is high
+		Sda::reset();
+		modm::delay_us(5);
+		Sda::set();
+		modm::delay_us(5);
+		Connector::connect();
+	}
+
+	static inline void (*busReset)() = nullptr;
+
+};
+
+
+} // namespace platform
+
+} // namespace modm
+
+#endif // MODM_STM32_I2C_3_HPP
\ No newline at end of file
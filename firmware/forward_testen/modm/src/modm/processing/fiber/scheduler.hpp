@@ -17,6 +17,7 @@
 #include "task.hpp"
 #include <modm/architecture/interface/assert.hpp>
 #include <modm/platform/device.hpp>
+#include <atomic>
 namespace modm::fiber
 {
 
@@ -26,12 +27,19 @@ namespace modm::fiber
  * while the scheduler is running. Fibers returning from their function will
  * automatically unschedule themselves.
  *
+ * Fibers calling `modm::this_fiber::suspend()` are moved out of the round-robin
+ * into a separate list until `modm::fiber::resume()` is called, usually from an
+ * interrupt. If no fiber is ready to run, the scheduler sleeps with `WFI`.
+ *
  * @ingroup modm_processing_fiber
  */
 class Scheduler
 {
 	friend class Task;
 	friend void modm::this_fiber::yield();
+	friend void modm::this_fiber::suspend();
+	friend void modm::this_fiber::suspend_for(std::chrono::milliseconds);
+	friend void modm::fiber::resume(modm::fiber::id);
 	friend modm::fiber::id modm::this_fiber::get_id();
 	Scheduler(const Scheduler&) = delete;
 	Scheduler& operator=(const Scheduler&) = delete;
@@ -39,6 +47,12 @@ class Scheduler
 protected:
 	Task* last{nullptr};
 	Task* current{nullptr};
+	// suspended tasks, linked via Task::next
+	Task* suspended{nullptr};
+	// set when a suspended task may have been resumed
+	std::atomic<bool> pending{false};
+	// number of suspended tasks with a deadline
+	uint_fast8_t timed{0};
 
 	uintptr_t inline
 	get_id() const
@@ -85,6 +99,56 @@ protected:
 		return last == nullptr;
 	}
 
+	void inline
+	enqueue(Task* task)
+	{
+		if (last == nullptr)
+		{
+			task->next = task;
+			last = task;
+			return;
+		}
+		runLast(task);
+	}
+
+	/// Moves resumed and timed out tasks from the suspended list back into the run queue.
+	void inline
+	readyResumed()
+	{
+		if (not pending.load(std::memory_order_relaxed) and timed == 0) return;
+		pending.store(false, std::memory_order_relaxed);
+		const auto now = timed ? modm::chrono::milli_clock::now()
+							   : modm::chrono::milli_clock::time_point{};
+		Task** link = &suspended;
+		while (Task* task = *link)
+		{
+			// wrap-around safe comparison of the millisecond counter
+			const bool expired = task->timed and int32_t((now - task->deadline).count()) >= 0;
+			if (task->resumed.exchange(false, std::memory_order_acquire) or expired)
+			{
+				if (task->timed) { task->timed = false; timed--; }
+				*link = task->next;
+				enqueue(task);
+			}
+			else link = &task->next;
+		}
+	}
+
+	/// Sleeps until an interrupt has resumed at least one task or a deadline passed.
+	/// The SysTick interrupt wakes up the core every millisecond to check the deadlines.
+	void inline
+	waitForResumed()
+	{
+		while (readyResumed(), empty())
+		{
+			// Interrupts are masked, so a resume between the check and WFI
+			// still wakes up the core, it is then handled after enabling them.
+			__disable_irq();
+			if (not pending.load(std::memory_order_relaxed)) __WFI();
+			__enable_irq();
+		}
+	}
+
 	void inline
 	jump(Task* other)
 	{
@@ -97,6 +161,7 @@ protected:
 	yield()
 	{
 		if (current == nullptr) return;
+		readyResumed();
 		Task* next = current->next;
 		// If there's only one fiber running, we could just return here.
 		// However, we need to check the stack for overflow.
@@ -114,13 +179,44 @@ protected:
 		removeCurrent();
 		if (empty())
 		{
-			current = nullptr;
-			modm_context_end(0);
+			if (suspended == nullptr)
+			{
+				current = nullptr;
+				modm_context_end(0);
+			}
+			waitForResumed();
+			next = last->next;
 		}
 		jump(next);
 		__builtin_unreachable();
 	}
 
+	void inline
+	suspend(modm::chrono::milli_clock::duration timeout = {})
+	{
+		if (current == nullptr or isInsideInterrupt()) return;
+		Task* task = current;
+		// resumed before it could be suspended
+		if (task->resumed.exchange(false, std::memory_order_acquire)) return;
+		if (timeout.count() > 0)
+		{
+			task->deadline = modm::chrono::milli_clock::now() + timeout;
+			task->timed = true;
+			timed++;
+		}
+
+		// last->next is always the current task
+		if (task == last) last = nullptr;
+		else last->next = task->next;
+		task->next = suspended;
+		suspended = task;
+
+		waitForResumed();
+		// only this task got resumed, continue without a context switch
+		if (last->next == task) return;
+		jump(last->next);
+	}
+
 	void inline
 	add(Task* task)
 	{
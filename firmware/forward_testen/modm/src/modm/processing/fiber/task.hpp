@@ -15,6 +15,7 @@
 #include "stack.hpp"
 #include "stop_token.hpp"
 #include <modm/architecture/interface/fiber.hpp>
+#include <atomic>
 #include <type_traits>
 
 namespace modm
@@ -57,6 +58,7 @@ class Task
 	Task(const Task&) = delete;
 	Task& operator=(const Task&) = delete;
 	friend class Scheduler;
+	friend void modm::fiber::resume(modm::fiber::id);
 
 	// Make sure that Task and Fiber use a callable constructor, otherwise they
 	// may get placed in the .data section including the whole stack!!!
@@ -64,6 +66,11 @@ class Task
 	Task* next;
 	Scheduler *scheduler{nullptr};
 	stop_state stop{};
+	// set by `modm::fiber::resume()`, possibly from an interrupt
+	std::atomic<bool> resumed{false};
+	// end of a `modm::this_fiber::suspend_for()` while suspended
+	modm::chrono::milli_clock::time_point deadline{};
+	bool timed{false};
 
 public:
 	/// @param stack	A stack object that is *NOT* shared with other tasks.
@@ -0,0 +1,231 @@
+#ifndef MOTION_PROFILE_HPP
+#define MOTION_PROFILE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+/**
+ * @brief Jerk-limited velocity ramps, evaluated one control tick at a time.
+ *
+ * Turns a target velocity, or a distance to travel, into a stream of
+ * velocity setpoints with an S-curve shape: the acceleration ramps with at
+ * most `jerk` up to at most `acceleration` and back to zero, so the target
+ * is reached without overshoot and without steps in the motor current.
+ * A new target can be set at any time, the profile continues smoothly from
+ * its current state.
+ *
+ * Every update() costs the same few integer operations independent of the
+ * profile length, there is no precomputed trajectory. The state is Q16.16
+ * fixed-point per tick, so the same inputs always give the same setpoints.
+ *
+ * Velocities use any unit, e.g. rpm, the limits are in that unit per second
+ * and per second squared. Distances are velocity units times seconds.
+ */
+class MotionProfile
+{
+public:
+    struct Parameters
+    {
+        uint32_t acceleration = 4000;   ///< velocity units per s
+        uint32_t jerk = 40000;          ///< velocity units per s^2
+        uint32_t frequency = 1000;      ///< update() calls per s
+    };
+
+    MotionProfile()
+    {
+        setParameters(Parameters());
+    }
+
+    explicit MotionProfile(const Parameters &parameters)
+    {
+        setParameters(parameters);
+    }
+
+    /// Keeps the current velocity, the new limits apply from the next update().
+    void
+    setParameters(const Parameters &parameters)
+    {
+        const int64_t frequency = parameters.frequency;
+        maxAcceleration = std::max<int64_t>(1, (int64_t(parameters.acceleration) << 16) / frequency);
+        jerk = std::max<int64_t>(1, (int64_t(parameters.jerk) << 16) / (frequency * frequency));
+        ticksPerSecond = parameters.frequency;
+        acceleration = std::clamp(acceleration, -maxAcceleration, maxAcceleration);
+    }
+
+    /// Jumps to a velocity without ramp, e.g. to follow a stopped wheel.
+    void
+    reset(int32_t velocity = 0)
+    {
+        this->velocity = int64_t(velocity) << 16;
+        acceleration = 0;
+        target = velocity;
+        remaining = 0;
+        moving = false;
+    }
+
+    /// Ramps to a velocity and holds it, cancels a move.
+    void
+    setTarget(int32_t velocity)
+    {
+        target = velocity;
+        moving = false;
+    }
+
+    /**
+     * @brief Travels a distance and stops.
+     *
+     * @param distance  velocity units times seconds, the sign is the direction
+     * @param velocity  magnitude of the cruise velocity
+     */
+    void
+    moveBy(int32_t distance, int32_t velocity)
+    {
+        remaining = (int64_t(distance) * ticksPerSecond) << 16;
+        cruise = (distance < 0) ? -std::abs(velocity) : std::abs(velocity);
+        target = cruise;
+        moving = true;
+    }
+
+    /// Advances the profile by one tick.
+    /// @return the velocity setpoint
+    int32_t
+    update()
+    {
+        if (moving)
+        {
+            remaining -= velocity;
+            // brake when the rest of the way is needed to stop
+            const bool forward = cruise >= 0;
+            const int64_t way = forward ? remaining : -remaining;
+            const int64_t speed = forward ? velocity : -velocity;
+            const int64_t rising = forward ? acceleration : -acceleration;
+            if (target != 0 and way <= stoppingDistance(speed, rising) + speed) {
+                target = 0;
+            }
+            if (target == 0 and velocity == 0 and acceleration == 0) {
+                moving = false;
+            }
+        }
+
+        // all in the frame where the velocity has to increase
+        const int64_t difference = (int64_t(target) << 16) - velocity;
+        const int64_t sign = (difference < 0) ? -1 : 1;
+        const int64_t error = sign * difference;
+        const int64_t current = sign * acceleration;
+
+        // the largest acceleration after which the ramp down to zero still
+        // ends at the target, otherwise brake as hard as allowed
+        int64_t next = std::max(current - jerk, -maxAcceleration);
+        for (const int64_t candidate : {std::min(current + jerk, maxAcceleration), current})
+        {
+            if (error - candidate - rampDown(candidate) >= 0) {
+                next = candidate;
+                break;
+            }
+        }
+
+        if (error <= jerk and current <= jerk and error - current <= jerk)
+        {
+            // close enough, land exactly: the last velocity step `error` and
+            // the acceleration of zero after it are each one jerk step away
+            velocity = int64_t(target) << 16;
+            acceleration = 0;
+        }
+        else
+        {
+            acceleration = sign * next;
+            velocity += acceleration;
+        }
+        return getVelocity();
+    }
+
+    /// @return the last velocity setpoint, rounded
+    int32_t
+    getVelocity() const
+    {
+        return (velocity + (1 << 15)) >> 16;
+    }
+
+    /// @return the current acceleration in velocity units per s
+    int32_t
+    getAcceleration() const
+    {
+        return (acceleration * ticksPerSecond) >> 16;
+    }
+
+    int32_t
+    getTarget() const
+    {
+        return target;
+    }
+
+    /// @return true while a move is in progress or the target is not reached
+    bool
+    isBusy() const
+    {
+        return moving or acceleration != 0 or velocity != (int64_t(target) << 16);
+    }
+
+private:
+    /// Velocity change while the acceleration ramps to zero with the full jerk.
+    int64_t
+    rampDown(int64_t acceleration) const
+    {
+        return acceleration * std::abs(acceleration) / (2 * jerk) - acceleration / 2;
+    }
+
+    /// Distance to stop from `speed` while still accelerating with `rising`, Q16.16 per tick.
+    int64_t
+    stoppingDistance(int64_t speed, int64_t rising) const
+    {
+        int64_t distance = 0;
+        if (rising > 0)
+        {
+            // the acceleration has to ramp down first, the speed still grows
+            const int64_t peak = speed + rampDown(rising);
+            distance = (speed + peak) / 2 * (rising / jerk);
+            speed = peak;
+        }
+        if (speed <= 0) {
+            return distance;
+        }
+        // the full deceleration is reached if the speed allows it
+        const int64_t ramp = maxAcceleration * maxAcceleration / jerk;
+        if (speed >= ramp) {
+            return distance + speed * (speed / maxAcceleration + maxAcceleration / jerk) / 2;
+        }
+        // otherwise the deceleration peaks at sqrt(speed * jerk)
+        const int64_t ticks = 2 * squareRoot(speed / jerk);
+        return distance + speed * ticks / 2;
+    }
+
+    /// @return floor(sqrt(value)), bitwise
+    static constexpr int64_t
+    squareRoot(uint64_t value)
+    {
+        uint64_t root = 0;
+        for (uint64_t bit = uint64_t(1) << 62; bit; bit >>= 2)
+        {
+            if (value >= root + bit) {
+                value -= root + bit;
+                root = (root >> 1) + bit;
+            } else {
+                root >>= 1;
+            }
+        }
+        return int64_t(root);
+    }
+
+    int64_t velocity{0};        ///< Q16.16 per tick
+    int64_t acceleration{0};    ///< Q16.16 velocity per tick
+    int64_t maxAcceleration{1};
+    int64_t jerk{1};            ///< Q16.16 acceleration per tick
+    int64_t remaining{0};       ///< Q16.16 velocity ticks
+    int32_t ticksPerSecond{1000};
+    int32_t target{0};
+    int32_t cruise{0};
+    bool moving{false};
+};
+
+#endif // MOTION_PROFILE_HPP
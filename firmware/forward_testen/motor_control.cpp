@@ -0,0 +1,266 @@
+#include "motor_control.hpp"
+#include "odometry.hpp"
+#include "fault_monitor.hpp"
+#include "control_executive.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+using namespace Board;
+
+namespace
+{
+    struct Loop
+    {
+        SpeedController controller;
+        MotionProfile profile{MotionProfile::Parameters{
+                .acceleration = MotorControl::Acceleration,
+                .jerk = MotorControl::Jerk,
+                .frequency = MotorControl::ControlFrequency}};
+        volatile int32_t setpoint{0};
+        volatile int32_t speed{0};
+        uint32_t edges{0};
+        uint16_t compare{0};
+        /// direction of rotation, the level of the DIR pin
+        bool reverse{false};
+    };
+
+    Loop loops[2];
+    volatile bool enabled{false};
+
+    template<class Capture>
+    int32_t
+    measure(bool reverse)
+    {
+        constexpr uint32_t frequency = Capture::getTickFrequency();
+        // a wheel slower than MinimumSpeed has no recent edge
+        constexpr uint32_t timeout = 60 * frequency / (MotorControl::PulsesPerRevolution * MotorControl::MinimumSpeed);
+        constexpr uint32_t window = uint64_t(frequency) * MotorControl::AveragingWindow / 1000;
+
+        Capture::poll();
+        const uint32_t idle = Capture::getIdleTime();
+        if (idle > timeout) {
+            return 0;
+        }
+        // shorter average at low speeds, so the estimate does not lag
+        auto span = Capture::getSpan(MotorControl::AveragingEdges);
+        while (span.size() > 2 and span.duration() > window) {
+            span = Capture::getSpan(span.size() - 1);
+        }
+        if (span.size() < 2) {
+            return 0;
+        }
+
+        uint32_t millihertz = capture::frequency(span, frequency);
+        // while slowing down the next edge is overdue
+        if (idle > capture::period(span)) {
+            millihertz = uint64_t(frequency) * 1000 / idle;
+        }
+        const int32_t rpm = millihertz * 60 / (1000 * MotorControl::PulsesPerRevolution);
+        return reverse ? -rpm : rpm;
+    }
+
+    /// @return the signed edges since the last call
+    template<class Capture>
+    int32_t
+    travel(uint32_t &last, bool reverse)
+    {
+        const int32_t edges = Capture::getEdgeCount() - last;
+        last += edges;
+        return reverse ? -edges : edges;
+    }
+
+    /**
+     * @return the compare value of the next duty cycle
+     *
+     * FG has no direction, the wheel is assumed to turn as the DIR pin says.
+     * So DIR only follows the sign of the setpoint while the wheel almost
+     * stands, a wheel turning the other way gets zero duty, which brakes it
+     * through the windings, instead of a reversed DIR. DIR changes in a tick
+     * after one with zero duty, so the compare value in effect is zero.
+     *
+     * @tparam Mode the MotorMode of the driver of the wheel
+     */
+    template<class Mode>
+    uint16_t
+    drive(Loop &loop)
+    {
+        const int32_t speed = loop.speed;
+        if (std::abs(speed) < int32_t(MotorControl::ReversalSpeed) and
+            loop.setpoint != 0 and (loop.setpoint < 0) != loop.reverse)
+        {
+            if (loop.compare != 0) {
+                return 0;
+            }
+            loop.reverse = not loop.reverse;
+            // DIR high reverses the motor, a driving driver brakes while it changes
+            const uint8_t mode = Mode::current() & ~Mode::Dir;
+            Mode::apply(mode | (loop.reverse ? Mode::Dir : 0));
+        }
+
+        const int16_t duty = loop.reverse ? loop.controller.update(loop.setpoint, speed, -INT16_MAX, 0) :
+                                            loop.controller.update(loop.setpoint, speed, 0, INT16_MAX);
+        const uint32_t magnitude = (duty < 0) ? -int32_t(duty) : duty;
+        return (magnitude * MotorPwm::Resolution) >> 15;
+    }
+
+    // The stages of the control loop, run by the ControlExecutive
+
+    void
+    sense()
+    {
+        // FG only gives the speed, see drive() for the direction
+        loops[0].speed = measure<MotorControl::Capture1>(loops[0].reverse);
+        loops[1].speed = measure<MotorControl::Capture2>(loops[1].reverse);
+    }
+
+    void
+    estimate()
+    {
+        Odometry::update(travel<MotorControl::Capture1>(loops[0].edges, loops[0].reverse),
+                         travel<MotorControl::Capture2>(loops[1].edges, loops[1].reverse));
+    }
+
+    void
+    control()
+    {
+        if (not enabled) {
+            return;
+        }
+        loops[0].setpoint = loops[0].profile.update();
+        loops[1].setpoint = loops[1].profile.update();
+        loops[0].compare = drive<MotorMode::Driver<0>>(loops[0]);
+        loops[1].compare = drive<MotorMode::Driver<1>>(loops[1]);
+    }
+
+    void
+    actuate()
+    {
+        if (enabled) {
+            MotorPwm::setCompare(loops[0].compare, loops[1].compare);
+        }
+    }
+}
+
+void
+MotorControl::initialize()
+{
+    Capture1::initialize<SystemClock>();
+    Capture2::initialize<SystemClock>();
+    Odometry::initialize();
+
+    ControlExecutive::add(ControlExecutive::Stage::Sense, sense);
+    ControlExecutive::add(ControlExecutive::Stage::Estimate, estimate);
+    ControlExecutive::add(ControlExecutive::Stage::Control, control);
+    ControlExecutive::add(ControlExecutive::Stage::Actuate, actuate);
+    ControlExecutive::initialize<ControlFrequency>();
+}
+
+void
+MotorControl::setSpeed(int32_t left, int32_t right)
+{
+    modm::atomic::Lock lock;
+    enable();
+    loops[0].profile.setTarget(left);
+    loops[1].profile.setTarget(right);
+}
+
+void
+MotorControl::move(int32_t left, int32_t right, int32_t speed)
+{
+    modm::atomic::Lock lock;
+    enable();
+    // rpm times seconds are 1/60 revolution
+    loops[0].profile.moveBy(left * 60, speed);
+    loops[1].profile.moveBy(right * 60, speed);
+}
+
+void
+MotorControl::enable()
+{
+    // the drivers stay off until the fault is cleared
+    if (enabled or FaultMonitor::isLatched()) {
+        return;
+    }
+
+    // the ramps start from where the wheels are
+    for (Loop &loop : loops)
+    {
+        loop.controller.reset();
+        loop.profile.reset(loop.speed);
+        loop.setpoint = loop.speed;
+        // disable() zeroed the outputs
+        loop.compare = 0;
+    }
+    // awake with the brakes released, DIR as the wheels last turned
+    using Left = MotorMode::Driver<0>;
+    using Right = MotorMode::Driver<1>;
+    Left::apply(Left::Sleep | (loops[0].reverse ? Left::Dir : 0));
+    Right::apply(Right::Sleep | (loops[1].reverse ? Right::Dir : 0));
+    enabled = true;
+}
+
+void
+MotorControl::disable()
+{
+    enabled = false;
+    MotorPwm::setCompare(0, 0);
+}
+
+bool
+MotorControl::isEnabled()
+{
+    return enabled;
+}
+
+int32_t
+MotorControl::getSpeed(Wheel wheel)
+{
+    return loops[uint8_t(wheel)].speed;
+}
+
+uint32_t
+MotorControl::getEdgeCount(Wheel wheel)
+{
+    return (wheel == Wheel::Left) ? Capture1::getEdgeCount() : Capture2::getEdgeCount();
+}
+
+int32_t
+MotorControl::getSetpoint(Wheel wheel)
+{
+    return loops[uint8_t(wheel)].setpoint;
+}
+
+bool
+MotorControl::isMoving()
+{
+    modm::atomic::Lock lock;
+    return enabled and (loops[0].profile.isBusy() or loops[1].profile.isBusy());
+}
+
+SpeedController&
+MotorControl::getController(Wheel wheel)
+{
+    return loops[uint8_t(wheel)].controller;
+}
+
+MotionProfile&
+MotorControl::getProfile(Wheel wheel)
+{
+    return loops[uint8_t(wheel)].profile;
+}
+
+void
+MotorControl::setSupplyVoltage(uint16_t millivolt)
+{
+    modm::atomic::Lock lock;
+    for (Loop &loop : loops) {
+        loop.controller.setSupplyVoltage(millivolt);
+    }
+}
+
+MotorControl::Statistics
+MotorControl::getStatistics()
+{
+    const auto statistics = ControlExecutive::getStatistics();
+    return {statistics.iterations, statistics.total.cycles, statistics.total.maxCycles};
+}
@@ -0,0 +1,113 @@
+#ifndef MOTOR_CONTROL_HPP
+#define MOTOR_CONTROL_HPP
+
+#include <cstdint>
+
+#include "hardware.hpp"
+#include "capture_ring.hpp"
+#include "speed_controller.hpp"
+#include "motion_profile.hpp"
+
+/**
+ * @brief Closed-loop wheel speed control from the MCT8314Z FG outputs.
+ *
+ * The FG edges of each motor are timestamped into a ring by DMA (see
+ * CaptureRing), the speed is averaged over the latest periods and fed into
+ * one SpeedController per wheel. The setpoints are jerk-limited ramps from
+ * one MotionProfile per wheel, so speed changes do not cause current spikes
+ * or wheel slip. The loop runs as the sense, estimate, control and actuate
+ * stages of the ControlExecutive with a fixed rate of ControlFrequency and
+ * writes the duty cycles into the compare preload registers, so they take
+ * effect at the next PWM period.
+ *
+ * The signed edges of every period also drive the Odometry. As FG has no
+ * direction, DIR only changes while a wheel almost stands and a wheel
+ * turning against its setpoint is braked to a stop first.
+ *
+ * Speeds are motor revolutions per minute, positive is forward.
+ */
+namespace MotorControl
+{
+    using namespace modm::literals;
+
+    using Capture1 = CaptureRing<Board::M1_Capture>;
+    using Capture2 = CaptureRing<Board::M2_Capture>;
+
+    enum class
+    Wheel : uint8_t
+    {
+        Left,   ///< Motor 1
+        Right,  ///< Motor 2
+    };
+
+    static constexpr uint32_t ControlFrequency = 1_kHz;
+    /// FG pulses per motor revolution, depends on the pole pairs of the motor
+    static constexpr uint32_t PulsesPerRevolution = 4;
+    /// Below this speed the wheel counts as stopped
+    static constexpr uint32_t MinimumSpeed = 30; // rpm
+    /// Below this speed the DIR pin may reverse, about one FG edge per 250 ms
+    static constexpr uint32_t ReversalSpeed = 60; // rpm
+    /// The speed is averaged over at most this many FG edges ...
+    static constexpr size_t AveragingEdges = 8;
+    /// ... spanning no more than this time
+    static constexpr uint32_t AveragingWindow = 20; // ms
+    /// Limits of the setpoint ramps
+    static constexpr uint32_t Acceleration = 4000;  // rpm/s
+    static constexpr uint32_t Jerk = 40000;         // rpm/s^2
+
+    struct Statistics
+    {
+        uint32_t iterations;
+        uint32_t cycles;    ///< CPU cycles of the last iteration
+        uint32_t maxCycles;
+    };
+
+    /// Sets up the tacho capture and the control interrupt, call after Board::initialize().
+    void initialize();
+
+    /**
+     * @brief Ramps to the wheel speeds and enables the loop.
+     *
+     * Wakes the drivers and releases the brakes when the loop was disabled.
+     */
+    void setSpeed(int32_t left, int32_t right);
+
+    /**
+     * @brief Turns each wheel by a number of motor revolutions and stops.
+     *
+     * @param speed cruise speed in rpm
+     */
+    void move(int32_t left, int32_t right, int32_t speed);
+
+    /// @return true until both ramps reached their target, false when disabled
+    bool isMoving();
+
+    /// Stops the loop and sets both duty cycles to zero.
+    void disable();
+
+    bool isEnabled();
+
+    /// @return the measured speed in rpm
+    int32_t getSpeed(Wheel wheel);
+
+    /// @return the current ramp setpoint in rpm
+    int32_t getSetpoint(Wheel wheel);
+
+    /// @return the number of FG edges of a wheel, regardless of the direction
+    uint32_t getEdgeCount(Wheel wheel);
+
+    SpeedController& getController(Wheel wheel);
+
+    MotionProfile& getProfile(Wheel wheel);
+
+    /// Measured VM in mV for the feed-forward compensation, from Board::Analog::Battery if routed.
+    void setSupplyVoltage(uint16_t millivolt);
+
+    /// Cycle counts of all stages of the ControlExecutive.
+    Statistics getStatistics();
+
+    /// Starts the loop from the measured wheel speeds, no-op if running or after a fault.
+    void enable();
+}
+
+#endif // MOTOR_CONTROL_HPP
@@ -0,0 +1,228 @@
+#ifndef MOTOR_MODE_HPP
+#define MOTOR_MODE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+
+/// Sleep, Brake and Dir pin of one motor driver
+template<class SleepPin, class BrakePin, class DirPin>
+struct DriverPins
+{
+    using Sleep = SleepPin;
+    using Brake = BrakePin;
+    using Dir = DirPin;
+};
+
+/**
+ * @brief Switches the mode of all motor drivers with few, ordered port writes.
+ *
+ * A mode is the level of the Sleep, Brake and Dir pins, the same for every
+ * driver. The writes of each transition from one mode to another are
+ * computed at compile time, from the port and pin of the pin types, like the
+ * masks of `GpioSet`. The pins change in three phases:
+ *
+ *     1. Sleep low or Brake high, the drivers stop driving
+ *     2. Dir
+ *     3. Sleep high or Brake low, the drivers drive again
+ *
+ * A driver must not see DIR change while it drives, so when both modes
+ * drive in opposite directions, phase 1 also sets Brake high and phase 3
+ * releases it again. Then every phase is a write of its own. Otherwise each
+ * phase writes every port it touches once, a set and a reset of the same
+ * port are one BSRR write. The last port of a phase is also the first of
+ * the next one if they share one, then both become one write. So a pin
+ * never changes after a pin of a later phase, at most at the same time.
+ *
+ * Driver<Index> is the same switch for a single driver, e.g. to reverse
+ * one wheel while the other one keeps driving.
+ *
+ * `Output` writes the BSRR of a port, `Port` is the numeric value of the
+ * `port` of the pin types:
+ *
+ *     template<uint8_t Port> static void write(uint32_t bsrr);
+ */
+template<class Output, class... Drivers>
+class MotorModeSwitch
+{
+public:
+    /// Driver pin levels of a mode, or-ed together, the same bits as TestSequence::Pins
+    enum Pins : uint8_t
+    {
+        Sleep = 0b001,  ///< nSLEEP high, the drivers are active
+        Brake = 0b010,  ///< BRAKE high
+        Dir   = 0b100,  ///< DIR high, reverse
+    };
+
+    struct Write
+    {
+        uint8_t port;
+        uint32_t bsrr;
+    };
+
+    /// The previous mode is not known, e.g. after reset or another writer of the pins
+    static constexpr uint8_t Unknown = 0x80;
+
+    /// Brake is written in two phases at most, each phase writes a port at most once per pin
+    static constexpr size_t MaxWrites = 4 * sizeof...(Drivers);
+
+    struct Sequence
+    {
+        std::array<Write, MaxWrites> writes{};
+        size_t size{0};
+    };
+
+    /// Switches the mode of the driver at `Index` only
+    template<size_t Index>
+    using Driver = MotorModeSwitch<Output, std::tuple_element_t<Index, std::tuple<Drivers...>>>;
+
+    /// @return true if the drivers drive the motors in the mode
+    static constexpr bool
+    isDriving(uint8_t pins)
+    {
+        return (pins == Unknown) or ((pins & Sleep) and not (pins & Brake));
+    }
+
+    /// @return the port writes from a mode, or Unknown, to a mode in the order of apply()
+    static constexpr Sequence
+    sequence(uint8_t from, uint8_t to)
+    {
+        const bool reversing = isDriving(from) and isDriving(to) and
+                               ((from == Unknown) or ((from ^ to) & Dir));
+
+        std::array<Sequence, 3> phases{};
+        (add<typename Drivers::Sleep>(phases[(to & Sleep) ? 2 : 0], to & Sleep), ...);
+        if (reversing) {
+            (add<typename Drivers::Brake>(phases[0], true), ...);
+        }
+        (add<typename Drivers::Brake>(phases[(to & Brake) ? 0 : 2], to & Brake), ...);
+        (add<typename Drivers::Dir>(phases[1], to & Dir), ...);
+
+        Sequence result;
+        for (size_t phase = 0; phase < phases.size(); phase++)
+        {
+            Sequence &writes = phases[phase];
+            if (result.size and not reversing)
+            {
+                // merge the first write into the last one of the previous phase
+                Write &last = result.writes[result.size - 1];
+                if (const size_t index = find(writes, last.port); index < writes.size)
+                {
+                    last.bsrr |= writes.writes[index].bsrr;
+                    writes.writes[index] = writes.writes[--writes.size];
+                }
+            }
+            if (phase + 1 < phases.size() and not reversing)
+            {
+                // a port of the next phase last, so it can be merged
+                for (size_t index = 0; index < writes.size; index++)
+                {
+                    if (find(phases[phase + 1], writes.writes[index].port) < phases[phase + 1].size) {
+                        std::swap(writes.writes[index], writes.writes[writes.size - 1]);
+                        break;
+                    }
+                }
+            }
+            for (size_t index = 0; index < writes.size; index++) {
+                result.writes[result.size++] = writes.writes[index];
+            }
+        }
+        return result;
+    }
+
+    template<uint8_t From, uint8_t To>
+    static constexpr Sequence Writes = sequence(From, To);
+
+    template<uint8_t From, uint8_t To>
+    static void
+    apply()
+    {
+        [&]<size_t... Index>(std::index_sequence<Index...>)
+        {
+            (Output::template write<Writes<From, To>.writes[Index].port>(Writes<From, To>.writes[Index].bsrr), ...);
+        }(std::make_index_sequence<Writes<From, To>.size>());
+    }
+
+    /// Switches from an unknown mode, with the Brake while DIR changes.
+    template<uint8_t Pins>
+    static void
+    apply()
+    {
+        apply<Unknown, Pins>();
+    }
+
+    /// Dispatches to the compile time writes of the transition.
+    static void
+    apply(uint8_t from, uint8_t to)
+    {
+        static constexpr auto transitions = []<size_t... Index>(std::index_sequence<Index...>)
+        {
+            // the modes from Unknown last
+            return std::array<void (*)(), sizeof...(Index)>{
+                    apply<(Index / 8 < 8) ? uint8_t(Index / 8) : Unknown, uint8_t(Index % 8)>...};
+        }(std::make_index_sequence<9 * 8>());
+        const size_t source = (from == Unknown) ? 8 : (from & (Sleep | Brake | Dir));
+        transitions[source * 8 + (to & (Sleep | Brake | Dir))]();
+    }
+
+    /// Switches from the mode the pins are in now.
+    static void
+    apply(uint8_t pins)
+    {
+        apply(current(), pins);
+    }
+
+    /// @return the mode of the drivers from their output levels, Unknown if they differ
+    static uint8_t
+    current()
+    {
+        const uint8_t modes[] = {uint8_t((Drivers::Sleep::isSet() ? Sleep : 0) |
+                                         (Drivers::Brake::isSet() ? Brake : 0) |
+                                         (Drivers::Dir::isSet() ? Dir : 0))...};
+        for (const uint8_t mode : modes) {
+            if (mode != modes[0]) return Unknown;
+        }
+        return modes[0];
+    }
+
+private:
+    template<class Pin>
+    static constexpr bool
+    isInverted()
+    {
+        if constexpr (requires { Pin::isInverted; }) {
+            return Pin::isInverted;
+        } else {
+            return false;
+        }
+    }
+
+    template<class Pin>
+    static constexpr void
+    add(Sequence &writes, bool level)
+    {
+        const uint8_t port = uint8_t(Pin::port);
+        const uint32_t bit = (level != isInverted<Pin>()) ? (1ul << Pin::pin) : (1ul << (Pin::pin + 16));
+        size_t index = find(writes, port);
+        if (index == writes.size) {
+            writes.writes[writes.size++] = {port, 0};
+        }
+        writes.writes[index].bsrr |= bit;
+    }
+
+    /// @return the index of the write of the port, or the size without one
+    static constexpr size_t
+    find(const Sequence &writes, uint8_t port)
+    {
+        for (size_t index = 0; index < writes.size; index++) {
+            if (writes.writes[index].port == port) {
+                return index;
+            }
+        }
+        return writes.size;
+    }
+};
+
+#endif // MOTOR_MODE_HPP
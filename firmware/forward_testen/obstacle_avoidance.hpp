@@ -0,0 +1,276 @@
+#ifndef OBSTACLE_AVOIDANCE_HPP
+#define OBSTACLE_AVOIDANCE_HPP
+
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * @brief Reactive exploration behavior from the front range and the pose.
+ *
+ * A hierarchical state machine evaluated once per tick. The two superstates
+ * share their transitions, which are checked before the ones of the active
+ * state:
+ *
+ *     Forward                 obstacle within the stop distance -> Stop
+ *       Cruise                nearing an obstacle -> SlowDown
+ *       SlowDown              speed falls with the distance, clear -> Cruise
+ *     Avoid                   no way out for too long -> Recover
+ *       Stop                  wheels stopped -> TurnAway
+ *       TurnAway              turned far enough and clear -> Cruise
+ *                             a full turn without a gap -> Recover
+ *       Recover               backed off -> TurnAway the other way
+ *
+ * The approach is judged from the distance predicted a `lookahead` ahead,
+ * so a fast approach brakes earlier. Fixed-size state, no allocation and a
+ * constant number of operations per tick, the wheel speeds are returned as
+ * a command for MotorControl::setSpeed().
+ */
+class ObstacleAvoidance
+{
+public:
+    enum class
+    State : uint8_t
+    {
+        Cruise,
+        SlowDown,
+        Stop,
+        TurnAway,
+        Recover,
+    };
+
+    struct Parameters
+    {
+        int32_t cruiseSpeed = 600;          ///< rpm
+        int32_t slowSpeed = 200;            ///< rpm, at the stop distance
+        int32_t turnSpeed = 150;            ///< rpm, wheels in opposite directions
+        uint16_t slowDistance = 800;        ///< mm
+        uint16_t stopDistance = 250;        ///< mm
+        uint16_t clearDistance = 900;       ///< mm, free way to leave TurnAway
+        uint16_t lookahead = 300;           ///< ms of approach added to the distance
+        int32_t turnAngle = 0x2aaa'aaab;    ///< Q1.31 fraction of pi, 60 degree
+        int32_t recoverDistance = 150'000;  ///< um to back off
+        uint16_t stopSpeed = 30;            ///< rpm below which a wheel stands
+        uint16_t avoidTimeout = 10'000;     ///< ms in Avoid before Recover
+        uint16_t frequency = 50;            ///< update() calls per s
+    };
+
+    /// Inputs of one tick
+    struct Perception
+    {
+        bool tracking;      ///< the range filter follows a target
+        uint16_t distance;  ///< mm, filtered
+        int32_t velocity;   ///< mm/s, negative while approaching
+        int32_t x;          ///< um, from the odometry
+        int32_t y;          ///< um
+        int32_t heading;    ///< Q1.31 fraction of pi
+        int32_t left;       ///< measured wheel speeds in rpm
+        int32_t right;
+    };
+
+    struct Command
+    {
+        int32_t left;       ///< rpm
+        int32_t right;
+    };
+
+    ObstacleAvoidance() = default;
+
+    explicit ObstacleAvoidance(const Parameters &parameters) :
+        parameters(parameters)
+    {
+    }
+
+    void
+    reset()
+    {
+        enter(State::Cruise, Perception{});
+        avoiding = 0;
+        turnLeft = true;
+        recoveries = 0;
+    }
+
+    Command
+    update(const Perception &input)
+    {
+        ticks++;
+        const int32_t ahead = predict(input);
+        transition(input, ahead);
+        return command(ahead);
+    }
+
+    State
+    getState() const
+    {
+        return state;
+    }
+
+    /// @return the number of Recover maneuvers since reset()
+    uint32_t
+    getRecoveries() const
+    {
+        return recoveries;
+    }
+
+private:
+    static constexpr bool
+    isForward(State state)
+    {
+        return state == State::Cruise or state == State::SlowDown;
+    }
+
+    void
+    transition(const Perception &input, int32_t ahead)
+    {
+        // transitions of the superstates first
+        if (isForward(state))
+        {
+            if (ahead <= parameters.stopDistance) {
+                enter(State::Stop, input);
+                return;
+            }
+        }
+        else if (++avoiding > toTicks(parameters.avoidTimeout) and state != State::Recover)
+        {
+            enter(State::Recover, input);
+            return;
+        }
+
+        switch (state)
+        {
+            case State::Cruise:
+                if (ahead < parameters.slowDistance) {
+                    enter(State::SlowDown, input);
+                }
+                break;
+
+            case State::SlowDown:
+                // some hysteresis against toggling at the threshold
+                if (ahead > parameters.slowDistance + parameters.slowDistance / 8) {
+                    enter(State::Cruise, input);
+                }
+                break;
+
+            case State::Stop:
+                if (isStanding(input) or ticks > toTicks(1000)) {
+                    enter(State::TurnAway, input);
+                }
+                break;
+
+            case State::TurnAway:
+            {
+                const int32_t step = int32_t(uint32_t(input.heading) - uint32_t(lastHeading));
+                lastHeading = input.heading;
+                turned += (step < 0) ? -int64_t(step) : step;
+                if (turned >= parameters.turnAngle and isClear(input)) {
+                    enter(State::Cruise, input);
+                } else if (turned >= (int64_t(1) << 32)) {
+                    // a full turn without a gap
+                    enter(State::Recover, input);
+                }
+                break;
+            }
+
+            case State::Recover:
+            {
+                const int64_t dx = int64_t(input.x) - startX, dy = int64_t(input.y) - startY;
+                const int64_t distance = parameters.recoverDistance;
+                if (dx * dx + dy * dy >= distance * distance or ticks > toTicks(3000))
+                {
+                    // try the other side this time
+                    turnLeft = not turnLeft;
+                    recoveries++;
+                    avoiding = 0;
+                    enter(State::TurnAway, input);
+                }
+                break;
+            }
+        }
+    }
+
+    Command
+    command(int32_t ahead) const
+    {
+        switch (state)
+        {
+            case State::Cruise:
+                return {parameters.cruiseSpeed, parameters.cruiseSpeed};
+
+            case State::SlowDown:
+            {
+                const int32_t span = parameters.slowDistance - parameters.stopDistance;
+                const int32_t room = std::clamp<int32_t>(ahead - parameters.stopDistance, 0, span);
+                const int32_t speed = parameters.slowSpeed +
+                        (parameters.cruiseSpeed - parameters.slowSpeed) * room / span;
+                return {speed, speed};
+            }
+
+            case State::Stop:
+                return {0, 0};
+
+            case State::TurnAway:
+                return turnLeft ? Command{-parameters.turnSpeed, parameters.turnSpeed} :
+                                  Command{parameters.turnSpeed, -parameters.turnSpeed};
+
+            case State::Recover:
+                return {-parameters.slowSpeed, -parameters.slowSpeed};
+        }
+        return {0, 0};
+    }
+
+    void
+    enter(State next, const Perception &input)
+    {
+        if (isForward(next)) {
+            avoiding = 0;
+        }
+        state = next;
+        ticks = 0;
+        turned = 0;
+        lastHeading = input.heading;
+        startX = input.x;
+        startY = input.y;
+    }
+
+    /// @return the distance in mm expected after the lookahead, large without a target
+    int32_t
+    predict(const Perception &input) const
+    {
+        if (not input.tracking) {
+            return INT16_MAX;
+        }
+        const int32_t approach = (input.velocity < 0) ? input.velocity * parameters.lookahead / 1000 : 0;
+        return int32_t(input.distance) + approach;
+    }
+
+    bool
+    isClear(const Perception &input) const
+    {
+        return not input.tracking or input.distance >= parameters.clearDistance;
+    }
+
+    bool
+    isStanding(const Perception &input) const
+    {
+        const auto magnitude = [](int32_t value) { return (value < 0) ? -value : value; };
+        return magnitude(input.left) < parameters.stopSpeed and magnitude(input.right) < parameters.stopSpeed;
+    }
+
+    uint32_t
+    toTicks(uint32_t milliseconds) const
+    {
+        return milliseconds * parameters.frequency / 1000;
+    }
+
+    Parameters parameters{};
+    State state{State::Cruise};
+    uint32_t ticks{0};          ///< in the current state
+    uint32_t avoiding{0};       ///< ticks in the Avoid superstate
+    uint32_t recoveries{0};
+    int64_t turned{0};          ///< absolute heading change in TurnAway, Q1.31
+    int32_t lastHeading{0};
+    int32_t startX{0};
+    int32_t startY{0};
+    bool turnLeft{true};
+};
+
+#endif // OBSTACLE_AVOIDANCE_HPP
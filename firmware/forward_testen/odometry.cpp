@@ -0,0 +1,40 @@
+#include "odometry.hpp"
+#include <modm/architecture/interface/atomic_lock.hpp>
+
+namespace
+{
+    Odometry::Estimator estimator{Odometry::Geometry};
+}
+
+void
+Odometry::initialize()
+{
+    Cordic::initialize();
+}
+
+void
+Odometry::reset(const Pose &pose)
+{
+    modm::atomic::Lock lock;
+    estimator.reset(pose);
+}
+
+void
+Odometry::update(int32_t left, int32_t right)
+{
+    estimator.update(left, right);
+}
+
+void
+Odometry::correct(uint16_t measured, uint16_t predicted, uint16_t gain)
+{
+    modm::atomic::Lock lock;
+    estimator.correct(int32_t(measured) * 1000, int32_t(predicted) * 1000, gain);
+}
+
+Odometry::Pose
+Odometry::getPose()
+{
+    modm::atomic::Lock lock;
+    return estimator.getPose();
+}
@@ -0,0 +1,45 @@
+#ifndef ODOMETRY_HPP
+#define ODOMETRY_HPP
+
+#include <cstdint>
+
+#include "cordic.hpp"
+#include "differential_odometry.hpp"
+
+/**
+ * @brief Pose of the robot from the wheel tacho edges.
+ *
+ * MotorControl feeds the signed edges of every control period, the sine and
+ * cosine for the integration come from the CORDIC coprocessor. The pose
+ * starts at the origin, heading along x.
+ */
+namespace Odometry
+{
+    using Estimator = DifferentialOdometry<Cordic::sincos>;
+    using Pose = Estimator::Pose;
+
+    /// Nominal geometry, calibrate on the robot by driving a known distance and turn.
+    static constexpr Estimator::Geometry Geometry{
+        .distancePerEdge = 51'050,  // 65 mm wheel, 4 edges per revolution
+        .trackWidth = 120'000,
+    };
+
+    void initialize();
+
+    void reset(const Pose &pose = Pose());
+
+    /// Integrates the signed edges since the last call, called by MotorControl.
+    void update(int32_t left, int32_t right);
+
+    /**
+     * @brief Corrects the position from the front ToF distance to a known wall.
+     *
+     * @param measured,predicted    distances in mm
+     * @param gain                  weight of the measurement as Q15
+     */
+    void correct(uint16_t measured, uint16_t predicted, uint16_t gain = 8192);
+
+    Pose getPose();
+}
+
+#endif // ODOMETRY_HPP
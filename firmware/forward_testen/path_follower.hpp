@@ -0,0 +1,407 @@
+#ifndef PATH_FOLLOWER_HPP
+#define PATH_FOLLOWER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+/**
+ * @brief One motion of a mission, in the units of the odometry.
+ *
+ * Each primitive starts where the previous one was planned to end, not
+ * where the robot actually is, so the errors of the single motions do not
+ * add up over the mission.
+ */
+struct PathPrimitive
+{
+    enum class
+    Type : uint8_t
+    {
+        Drive,  ///< straight along the heading, `a` um, negative backwards
+        Turn,   ///< in place by `a`, Q1.31 fraction of pi, counterclockwise
+        Arc,    ///< radius `a` um by the angle `b`, positive to the left
+        MoveTo, ///< straight to the point (`a`, `b`) in um
+    };
+
+    Type type;
+    int32_t a;
+    int32_t b;
+
+    static constexpr PathPrimitive
+    drive(int32_t distance)
+    {
+        return {Type::Drive, distance, 0};
+    }
+
+    static constexpr PathPrimitive
+    turn(int32_t angle)
+    {
+        return {Type::Turn, angle, 0};
+    }
+
+    static constexpr PathPrimitive
+    arc(int32_t radius, int32_t angle)
+    {
+        return {Type::Arc, radius, angle};
+    }
+
+    static constexpr PathPrimitive
+    moveTo(int32_t x, int32_t y)
+    {
+        return {Type::MoveTo, x, y};
+    }
+};
+
+/**
+ * @brief Pure pursuit along a queue of path primitives.
+ *
+ * Every update() takes the current pose and returns the wheel speeds for
+ * this control tick: the robot steers on the circle through a point one
+ * `lookahead` ahead on the path, the wheel speeds differ by the curvature of
+ * that circle. If the point lies behind the robot, it turns in place first.
+ * Turns are a proportional heading control instead. Near the end of a
+ * primitive the speed falls linearly to `minSpeed`, the MotionProfile of
+ * the wheels smoothes the steps between the primitives.
+ *
+ * Nothing is precomputed beyond the start of the active primitive, an
+ * update() costs at most two `SinCos` and one `Atan2`, which have the
+ * signatures of `Cordic::sincos()` and `Cordic::atan2()`. The queue has a
+ * fixed capacity and no allocation.
+ */
+template<auto SinCos, auto Atan2, size_t Capacity = 16>
+class PathFollower
+{
+public:
+    struct Parameters
+    {
+        int32_t speed = 300;                ///< rpm on straights and arcs
+        int32_t turnSpeed = 150;            ///< rpm of the wheels turning in place
+        int32_t minSpeed = 40;              ///< rpm at the end of a primitive
+        int32_t trackWidth = 120'000;       ///< um
+        int32_t lookahead = 150'000;        ///< um along the path, short ones oscillate behind the jerk limit
+        int32_t approach = 150'000;         ///< um before the end to slow down in
+        int32_t turnApproach = 0x1555'5555; ///< Q1.31 to slow down in, 30 degree
+        int32_t tolerance = 5'000;          ///< um, reached the end
+        int32_t turnTolerance = 0x0800'0000;///< Q1.31, 11.25 degree, about half a heading step of the odometry
+    };
+
+    struct Pose
+    {
+        int32_t x;          ///< um
+        int32_t y;          ///< um
+        int32_t heading;    ///< Q1.31 fraction of pi, counterclockwise from x
+    };
+
+    struct Command
+    {
+        int32_t left;       ///< rpm
+        int32_t right;
+    };
+
+    PathFollower() = default;
+
+    explicit PathFollower(const Parameters &parameters) :
+        parameters(parameters)
+    {
+    }
+
+    /// @return false if the queue is full
+    bool
+    push(const PathPrimitive &primitive)
+    {
+        if (count >= Capacity) {
+            return false;
+        }
+        queue[(head + count) % Capacity] = primitive;
+        count++;
+        return true;
+    }
+
+    /// Starts with the first queued primitive from the pose.
+    void
+    start(const Pose &pose)
+    {
+        reference = pose;
+        running = next(pose);
+    }
+
+    /// Stops and drops the queue.
+    void
+    stop()
+    {
+        running = false;
+        head = 0;
+        count = 0;
+    }
+
+    Command
+    update(const Pose &pose)
+    {
+        if (not running) {
+            return {0, 0};
+        }
+        Command command;
+        while (not follow(pose, command))
+        {
+            completed++;
+            if (not next(pose)) {
+                running = false;
+                return {0, 0};
+            }
+        }
+        return command;
+    }
+
+    bool
+    isRunning() const
+    {
+        return running;
+    }
+
+    /// @return the primitives waiting after the active one
+    size_t
+    getQueued() const
+    {
+        return count;
+    }
+
+    /// @return the primitives finished since the construction
+    uint32_t
+    getCompleted() const
+    {
+        return completed;
+    }
+
+    /// @return um off the path in the last update(), positive to the left
+    int32_t
+    getError() const
+    {
+        return error;
+    }
+
+    /// @return where the active primitive is planned to end
+    Pose
+    getReference() const
+    {
+        return reference;
+    }
+
+private:
+    /// Adds angles modulo one turn, signed overflow is undefined
+    static constexpr int32_t
+    wrap(int32_t angle, int32_t delta)
+    {
+        return int32_t(uint32_t(angle) + uint32_t(delta));
+    }
+
+    /// Rotates the vector by an angle, Q1.31 factors
+    static constexpr int32_t
+    along(int32_t x, int32_t y, int32_t cos, int32_t sin)
+    {
+        return (int64_t(x) * cos + int64_t(y) * sin) >> 31;
+    }
+
+    static constexpr int32_t
+    across(int32_t x, int32_t y, int32_t cos, int32_t sin)
+    {
+        return (int64_t(y) * cos - int64_t(x) * sin) >> 31;
+    }
+
+    /// Linear from `low` at 0 to `high` at `span` remaining and beyond
+    static constexpr int32_t
+    ramp(int32_t remaining, int32_t span, int32_t high, int32_t low)
+    {
+        const int32_t room = std::clamp<int32_t>(remaining, 0, span);
+        return low + int64_t(high - low) * room / span;
+    }
+
+    /// Takes the next primitive off the queue and plans it from the reference
+    bool
+    next(const Pose &pose)
+    {
+        if (count == 0) {
+            return false;
+        }
+        active = queue[head];
+        head = (head + 1) % Capacity;
+        count--;
+
+        switch (active.type)
+        {
+            case PathPrimitive::Type::Drive:
+                line(reference.heading, active.a);
+                break;
+
+            case PathPrimitive::Type::MoveTo:
+            {
+                const int32_t dx = active.a - reference.x, dy = active.b - reference.y;
+                const int32_t heading = Atan2(dy, dx);
+                const auto [sin, cos] = SinCos(heading);
+                reference.heading = heading;
+                line(heading, along(dx, dy, cos, sin));
+                reference.x = active.a;
+                reference.y = active.b;
+                break;
+            }
+
+            case PathPrimitive::Type::Turn:
+                reference.heading = wrap(reference.heading, active.a);
+                sign = (wrap(reference.heading, -pose.heading) < 0) ? -1 : 1;
+                break;
+
+            case PathPrimitive::Type::Arc:
+            {
+                const int32_t radius = std::max<int32_t>(active.a, 1);
+                sign = (active.b < 0) ? -1 : 1;
+                // the center lies to the side of the turn
+                const auto [sin, cos] = SinCos(reference.heading);
+                centerX = reference.x - sign * int32_t((int64_t(radius) * sin) >> 31);
+                centerY = reference.y + sign * int32_t((int64_t(radius) * cos) >> 31);
+                // the lookahead as angle around the center, 2^31 / pi per radian
+                lead = sign * int32_t(std::min<int64_t>(int64_t(parameters.lookahead) * 683'565'276 / radius, 1 << 30));
+                progress = 0;
+                lastAngle = Atan2(pose.y - centerY, pose.x - centerX);
+
+                const int32_t end = wrap(wrap(reference.heading, -sign * (1 << 30)), active.b);
+                const auto point = SinCos(end);
+                reference.x = centerX + int32_t((int64_t(radius) * point.cos) >> 31);
+                reference.y = centerY + int32_t((int64_t(radius) * point.sin) >> 31);
+                reference.heading = wrap(reference.heading, active.b);
+                break;
+            }
+        }
+        return true;
+    }
+
+    /// Plans a straight line from the reference
+    void
+    line(int32_t heading, int32_t length)
+    {
+        const auto [sin, cos] = SinCos(heading);
+        startX = reference.x;
+        startY = reference.y;
+        directionSin = sin;
+        directionCos = cos;
+        this->length = length;
+        sign = (length < 0) ? -1 : 1;
+        reference.x += (int64_t(length) * cos) >> 31;
+        reference.y += (int64_t(length) * sin) >> 31;
+    }
+
+    /// @return false once the active primitive is done
+    bool
+    follow(const Pose &pose, Command &command)
+    {
+        switch (active.type)
+        {
+            case PathPrimitive::Type::Drive:
+            case PathPrimitive::Type::MoveTo:
+            {
+                const int32_t dx = pose.x - startX, dy = pose.y - startY;
+                const int32_t position = along(dx, dy, directionCos, directionSin);
+                error = across(dx, dy, directionCos, directionSin);
+                const int32_t remaining = sign * (length - position);
+                if (remaining <= parameters.tolerance) {
+                    return false;
+                }
+                // past the end the line continues, so the point never comes too close
+                const int32_t target = position + sign * parameters.lookahead;
+                command = pursue(pose,
+                                 startX + int32_t((int64_t(target) * directionCos) >> 31),
+                                 startY + int32_t((int64_t(target) * directionSin) >> 31),
+                                 sign * ramp(remaining, parameters.approach, parameters.speed, parameters.minSpeed));
+                return true;
+            }
+
+            case PathPrimitive::Type::Turn:
+            {
+                error = 0;
+                const int32_t difference = wrap(reference.heading, -pose.heading);
+                const int32_t magnitude = std::min<int64_t>(std::abs(int64_t(difference)), INT32_MAX);
+                // the heading moves in steps of the odometry, so passing the target is done as well
+                if (magnitude <= parameters.turnTolerance or (difference < 0) != (sign < 0)) {
+                    return false;
+                }
+                const int32_t speed = ramp(magnitude, parameters.turnApproach,
+                                           parameters.turnSpeed, parameters.minSpeed);
+                command = (difference > 0) ? Command{-speed, speed} : Command{speed, -speed};
+                return true;
+            }
+
+            case PathPrimitive::Type::Arc:
+            {
+                const int32_t radius = std::max<int32_t>(active.a, 1);
+                const int32_t dx = pose.x - centerX, dy = pose.y - centerY;
+                const int32_t angle = Atan2(dy, dx);
+                progress += wrap(angle, -lastAngle);
+                lastAngle = angle;
+                const int64_t total = std::abs(int64_t(active.b));
+                const int64_t left = total - sign * progress;
+                // the remaining arc in um, 2^31 / pi per radian
+                const int32_t remaining = std::min<int64_t>(left * radius / 683'565'276, INT32_MAX);
+                if (remaining <= parameters.tolerance) {
+                    return false;
+                }
+                const auto [sin, cos] = SinCos(angle);
+                error = sign * (radius - along(dx, dy, cos, sin));
+                const auto point = SinCos(wrap(angle, lead));
+                command = pursue(pose,
+                                 centerX + int32_t((int64_t(radius) * point.cos) >> 31),
+                                 centerY + int32_t((int64_t(radius) * point.sin) >> 31),
+                                 ramp(remaining, parameters.approach, parameters.speed, parameters.minSpeed));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Steers on the circle through the point at the speed of the robot center
+    Command
+    pursue(const Pose &pose, int32_t x, int32_t y, int32_t speed) const
+    {
+        const auto [sin, cos] = SinCos(pose.heading);
+        const int32_t dx = x - pose.x, dy = y - pose.y;
+        const int64_t ahead = along(dx, dy, cos, sin);
+        const int64_t aside = across(dx, dy, cos, sin);
+
+        if ((speed < 0) ? (ahead >= 0) : (ahead <= 0))
+        {
+            // the point is behind the direction of travel, turn towards it
+            const int32_t turn = ((aside >= 0) == (speed >= 0)) ? parameters.turnSpeed : -parameters.turnSpeed;
+            return {-turn, turn};
+        }
+        // half the track width times the curvature 2 y / d^2, Q16, one wheel stops at most
+        const int64_t distance = ahead * ahead + aside * aside;
+        const int64_t ratio = std::clamp<int64_t>((aside * parameters.trackWidth << 16) / distance,
+                                                  -(1 << 16), 1 << 16);
+        return {int32_t((speed * ((1 << 16) - ratio)) >> 16),
+                int32_t((speed * ((1 << 16) + ratio)) >> 16)};
+    }
+
+    Parameters parameters{};
+    PathPrimitive queue[Capacity]{};
+    size_t head{0};
+    size_t count{0};
+    bool running{false};
+    uint32_t completed{0};
+
+    PathPrimitive active{};
+    Pose reference{};           ///< planned end of the active primitive
+    int32_t sign{1};            ///< direction of travel or of the arc
+    int32_t error{0};
+    // straight lines
+    int32_t startX{0};
+    int32_t startY{0};
+    int32_t directionSin{0};
+    int32_t directionCos{0};
+    int32_t length{0};
+    // arcs
+    int32_t centerX{0};
+    int32_t centerY{0};
+    int32_t lead{0};            ///< lookahead angle around the center, Q1.31
+    int32_t lastAngle{0};
+    int64_t progress{0};        ///< angle turned around the center, Q1.31
+};
+
+#endif // PATH_FOLLOWER_HPP
@@ -0,0 +1,27 @@
+#include "hardware.hpp"
+
+#include <modm/architecture/interface/clock.hpp>
+#include <modm/architecture/interface/interrupt.hpp>
+
+// Replaces the weak SysTick clocks, so timeouts, fiber sleeps and the
+// timestamps of the logs all count on Board::TimeBase.
+
+using namespace Board;
+
+modm::chrono::milli_clock::time_point
+modm::chrono::milli_clock::now() noexcept
+{
+    // wraps after 49 days like the SysTick clock
+    return time_point{duration{uint32_t(TimeBase::now().time_since_epoch().count() / 1000)}};
+}
+
+modm::chrono::micro_clock::time_point
+modm::chrono::micro_clock::now() noexcept
+{
+    return time_point{duration{uint32_t(TimeBase::now().time_since_epoch().count())}};
+}
+
+MODM_ISR(TIM5)
+{
+    TimeBase::handleInterrupt();
+}
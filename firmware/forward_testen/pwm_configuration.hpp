@@ -0,0 +1,94 @@
+#ifndef PWM_CONFIGURATION_HPP
+#define PWM_CONFIGURATION_HPP
+
+#include <algorithm>
+#include <cstdint>
+
+#include <modm/math/algorithm/prescaler_counter.hpp>
+#include <modm/architecture/interface/peripheral.hpp>
+
+enum class
+PwmAlignment : uint8_t
+{
+    Edge,   ///< Counts up, one update per period
+    Center, ///< Counts up and down, two updates per period
+};
+
+/**
+ * @brief Compile-time prescaler and overflow selection for a PWM timer.
+ *
+ * Out of the prescalers which leave at least `MinResolution` counts per
+ * period, picks the one closest to `Frequency`, on a tie the smallest one,
+ * which gives the largest counter and therefore the finest duty resolution.
+ * Fails to compile if the result is not within `tolerance`.
+ * In center-aligned mode the counter runs up and down, so one PWM period
+ * takes twice the overflow in ticks:
+ *
+ *     edge:   f = f_timer / (prescaler * (overflow + 1))
+ *     center: f = f_timer / (prescaler * 2 * overflow)
+ *
+ * Center-aligned PWM has half the frequency at the same resolution, but the
+ * switching edges of both half bridges are symmetrical around the period
+ * center, which lowers the current ripple.
+ *
+ * @tparam Timer            a modm timer, for its clock and counter width
+ * @tparam MinResolution    minimum number of duty steps per period
+ */
+template<class Timer, class SystemClock, uint32_t Frequency, uint32_t MinResolution,
+         PwmAlignment Alignment = PwmAlignment::Center, modm::percent_t tolerance = modm::pct(1)>
+struct PwmConfiguration
+{
+    static constexpr uint32_t ClockFrequency = Timer::template getClockFrequency<SystemClock>();
+    /// The center-aligned counter reaches the overflow value itself
+    static constexpr uint32_t MaxCounter = uint32_t(typename Timer::Value(~0u)) +
+            ((Alignment == PwmAlignment::Center) ? 0 : 1);
+
+    static constexpr uint32_t CounterFrequency =
+            (Alignment == PwmAlignment::Center) ? 2 * Frequency : Frequency;
+    // Only prescalers which keep at least MinResolution counts are searched,
+    // capped to a window that stays within the constexpr evaluation limits.
+    static constexpr uint32_t MinPrescaler = std::max<uint32_t>(1,
+            (ClockFrequency + uint64_t(CounterFrequency) * MaxCounter - 1) / (uint64_t(CounterFrequency) * MaxCounter));
+    static constexpr uint32_t MaxPrescaler = std::min<uint32_t>({0xFFFF, MinPrescaler + 1023,
+            std::max<uint32_t>(MinPrescaler, ClockFrequency / (uint64_t(CounterFrequency) * MinResolution))});
+
+    static constexpr auto result = modm::PrescalerCounter::from_linear(
+            ClockFrequency, CounterFrequency, MaxCounter, MinPrescaler, MaxPrescaler);
+
+    static constexpr typename Timer::Mode Mode = (Alignment == PwmAlignment::Center) ?
+            Timer::Mode::CenterAligned1 : Timer::Mode::UpCounter;
+    /// Value for `Timer::setPrescaler()`
+    static constexpr uint16_t Prescaler = result.prescaler;
+    /// Value for `Timer::setOverflow()`
+    static constexpr typename Timer::Value Overflow =
+            (Alignment == PwmAlignment::Center) ? result.counter : result.counter - 1;
+    /// Compare value for 100% duty, the number of duty steps per period
+    static constexpr uint32_t Resolution = result.counter;
+    /// Timer update events per second, twice the PWM frequency when center-aligned
+    static constexpr uint32_t UpdateFrequency = ClockFrequency / (result.prescaler * result.counter);
+    static constexpr uint32_t PwmFrequency =
+            (Alignment == PwmAlignment::Center) ? UpdateFrequency / 2 : UpdateFrequency;
+
+    static_assert(Resolution >= MinResolution,
+                  "The PWM frequency is too high for the requested duty resolution!");
+
+    static void
+    assertFrequencyInTolerance()
+    {
+        modm::PeripheralDriver::assertBaudrateInTolerance<PwmFrequency, Frequency, tolerance>();
+    }
+
+    /// Sets the counter mode and period, call before configuring the channels.
+    static void
+    configure(typename Timer::SlaveMode slaveMode = Timer::SlaveMode::Disabled,
+              typename Timer::SlaveModeTrigger trigger = typename Timer::SlaveModeTrigger(0),
+              typename Timer::MasterMode masterMode = Timer::MasterMode::Reset)
+    {
+        assertFrequencyInTolerance();
+        Timer::setMode(Mode, slaveMode, trigger, masterMode);
+        Timer::setPrescaler(Prescaler);
+        Timer::setOverflow(Overflow);
+    }
+};
+
+#endif // PWM_CONFIGURATION_HPP
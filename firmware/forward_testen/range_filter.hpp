@@ -0,0 +1,192 @@
+#ifndef RANGE_FILTER_HPP
+#define RANGE_FILTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <modm/driver/position/vl53l0.hpp>
+
+/**
+ * @brief Streaming filter for VL53L0 range samples.
+ *
+ * Every sample passes three stages:
+ *  1. rejection of samples with a range error, an overflowing distance or a
+ *     weak return signal,
+ *  2. a sliding median over the last `MedianSize` accepted distances,
+ *  3. an alpha-beta tracker estimating distance and velocity.
+ *
+ * Rejected samples only advance the prediction. After too many of them in a
+ * row the track is dropped and restarts from the next good sample.
+ *
+ * All arithmetic is fixed point, the state is statically sized and each
+ * update takes a bounded number of steps, so it is cheap enough for the
+ * control fiber.
+ */
+template<size_t MedianSize = 5>
+class RangeFilter
+{
+    static_assert(MedianSize % 2 == 1, "The median window must have an odd size!");
+    static_assert(MedianSize <= 15, "The median window is sorted by insertion, keep it small!");
+
+public:
+    struct Parameters
+    {
+        /// Minimum return signal rate in MCPS as 9.7 fixed point (0.25 MCPS)
+        uint16_t minSignalRate = modm::vl53l0::DefaultSignalRateLimit;
+        /// Samples beyond this distance in mm are rejected
+        uint16_t maxDistance = 2000;
+        /// Position gain as Q15
+        uint16_t alpha = 16384;  // 0.5
+        /// Velocity gain as Q15, critically damped for alpha = 0.5
+        uint16_t beta = 5461;    // 0.167
+        /// Time between two samples in ms
+        uint16_t periodMs = 33;
+        /// Consecutive rejected samples after which the track is dropped
+        uint8_t maxMissed = 5;
+    };
+
+    explicit RangeFilter(const Parameters &parameters = Parameters()) :
+        parameters(parameters)
+    {
+        reset();
+    }
+
+    void
+    reset()
+    {
+        count = 0;
+        oldest = 0;
+        missed = 0;
+        tracking = false;
+        position = 0;
+        velocity = 0;
+    }
+
+    /// @return true if the sample was accepted.
+    bool
+    update(modm::vl53l0::Data &sample)
+    {
+        return update(sample.getDistance(), sample.getSignalRate(), sample.getRangeError());
+    }
+
+    /// Raw variant, e.g. for replaying recorded samples.
+    bool
+    update(uint16_t distance, uint16_t signalRate, modm::vl53l0::RangeErrorCode error)
+    {
+        if (not isPlausible(distance, signalRate, error))
+        {
+            position += velocity;
+            if (++missed > parameters.maxMissed) {
+                reset();
+            }
+            return false;
+        }
+        missed = 0;
+
+        const int32_t measured = int32_t(pushMedian(distance)) << 16;
+        if (not tracking)
+        {
+            position = measured;
+            velocity = 0;
+            tracking = true;
+            return true;
+        }
+
+        position += velocity;
+        const int32_t residual = measured - position;
+        position += (int64_t(parameters.alpha) * residual) >> 15;
+        velocity += (int64_t(parameters.beta) * residual) >> 15;
+        return true;
+    }
+
+    /// @return true while the filter follows a target.
+    bool
+    isTracking() const
+    {
+        return tracking;
+    }
+
+    /// @return the filtered distance in mm
+    uint16_t
+    getDistance() const
+    {
+        if (position <= 0) {
+            return 0;
+        }
+        return (position + (1 << 15)) >> 16;
+    }
+
+    /// @return the velocity in mm/s, positive when the target moves away
+    int32_t
+    getVelocity() const
+    {
+        return (int64_t(velocity) * 1000 / parameters.periodMs) >> 16;
+    }
+
+    /// @return the median of the accepted samples in mm
+    uint16_t
+    getMedian() const
+    {
+        return count ? sorted[count / 2] : 0;
+    }
+
+private:
+    bool
+    isPlausible(uint16_t distance, uint16_t signalRate, modm::vl53l0::RangeErrorCode error) const
+    {
+        using modm::vl53l0;
+        if (error != vl53l0::RangeErrorCode::NoError and
+            error != vl53l0::RangeErrorCode::RangeComplete) {
+            return false;
+        }
+        if ((distance & vl53l0::Data::InvalidDistance) == vl53l0::Data::InvalidDistance or
+            distance > parameters.maxDistance) {
+            return false;
+        }
+        return signalRate >= parameters.minSignalRate;
+    }
+
+    /// Adds a sample to the window and returns the new median.
+    uint16_t
+    pushMedian(uint16_t distance)
+    {
+        size_t index = count;
+        if (count == MedianSize)
+        {
+            // drop the oldest sample from the sorted window
+            index = 0;
+            while (sorted[index] != history[oldest]) {
+                index++;
+            }
+            for (; index + 1 < count; index++) {
+                sorted[index] = sorted[index + 1];
+            }
+        }
+        else {
+            count++;
+        }
+        history[oldest] = distance;
+        oldest = (oldest + 1) % MedianSize;
+
+        // insert the new sample
+        for (; index > 0 and sorted[index - 1] > distance; index--) {
+            sorted[index] = sorted[index - 1];
+        }
+        sorted[index] = distance;
+        return sorted[count / 2];
+    }
+
+    Parameters parameters;
+
+    uint16_t history[MedianSize];
+    uint16_t sorted[MedianSize];
+    size_t count;
+    size_t oldest;
+
+    int32_t position;   ///< mm as Q16.16
+    int32_t velocity;   ///< mm per sample as Q16.16
+    uint8_t missed;
+    bool tracking;
+};
+
+#endif // RANGE_FILTER_HPP
@@ -0,0 +1,52 @@
+#include "range_sensor.hpp"
+#include "flash_record.hpp"
+#include <modm/debug/logger.hpp>
+
+modm::vl53l0::Data RangeSensor::data;
+RangeSensor::Sensor RangeSensor::sensor(RangeSensor::data);
+RangeFilter<5> RangeSensor::filter;
+
+namespace
+{
+    // Bump the version whenever the layout of vl53l0::Calibration changes.
+    using CalibrationRecord = FlashRecord<modm::vl53l0::Calibration, 1>;
+}
+
+bool
+RangeSensor::initialize(bool recalibrate)
+{
+    if (not RF_CALL_BLOCKING(sensor.ping())) {
+        MODM_LOG_ERROR << "ToF sensor not found" << modm::endl;
+        return false;
+    }
+
+    modm::vl53l0::Calibration calibration;
+    if (not recalibrate and CalibrationRecord::load(calibration) and calibration.isValid())
+    {
+        if (RF_CALL_BLOCKING(sensor.initialize(&calibration))) {
+            return true;
+        }
+        // e.g. the sensor was replaced, calibrate it from scratch
+        MODM_LOG_WARNING << "ToF calibration cache rejected" << modm::endl;
+        RF_CALL_BLOCKING(sensor.reset());
+    }
+
+    if (not RF_CALL_BLOCKING(sensor.initialize())) {
+        MODM_LOG_ERROR << "ToF calibration failed" << modm::endl;
+        return false;
+    }
+
+    if (not CalibrationRecord::store(sensor.getCalibration())) {
+        MODM_LOG_WARNING << "ToF calibration not saved" << modm::endl;
+    }
+    return true;
+}
+
+bool
+RangeSensor::update()
+{
+    if (not RF_CALL_BLOCKING(sensor.readDistance())) {
+        data.reset();
+    }
+    return filter.update(data);
+}
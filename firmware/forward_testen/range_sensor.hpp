@@ -0,0 +1,37 @@
+#ifndef RANGE_SENSOR_HPP
+#define RANGE_SENSOR_HPP
+
+#include <modm/driver/position/vl53l0.hpp>
+#include "hardware.hpp"
+#include "range_filter.hpp"
+
+namespace RangeSensor
+{
+    using Sensor = modm::Vl53l0<Board::I2c::Master>;
+
+    /// Latest measurement of the front ToF sensor.
+    extern modm::vl53l0::Data data;
+    extern Sensor sensor;
+    /// Filtered distance and velocity, fed by update().
+    extern RangeFilter<5> filter;
+
+    /**
+     * @brief Initializes the front ToF sensor.
+     *
+     * Restores the reference calibration from flash if a valid record exists,
+     * otherwise (or if `recalibrate` is set) performs the full calibration and
+     * stores its results for the next boot.
+     *
+     * @return true if the sensor is ready for ranging.
+     */
+    bool initialize(bool recalibrate = false);
+
+    /**
+     * @brief Performs one measurement and feeds it into the filter.
+     *
+     * @return true if the measurement was accepted by the filter.
+     */
+    bool update();
+}
+
+#endif // RANGE_SENSOR_HPP
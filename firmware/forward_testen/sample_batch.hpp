@@ -0,0 +1,65 @@
+#ifndef SAMPLE_BATCH_HPP
+#define SAMPLE_BATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief View of one batch of interleaved ADC frames.
+ *
+ * A frame holds one conversion of every channel of the sequence, a batch
+ * holds consecutive frames, one per trigger. The view reads the buffer in
+ * place, it stays valid until the writer fills that buffer again.
+ */
+template<size_t Channels>
+class SampleBatch
+{
+public:
+    constexpr SampleBatch() = default;
+
+    constexpr SampleBatch(const volatile uint16_t *data, size_t frames, uint32_t sequence) :
+        data(data), frames(frames), sequence(sequence)
+    {
+    }
+
+    /// @return the number of frames
+    constexpr size_t
+    size() const
+    {
+        return frames;
+    }
+
+    /// @return the number of the batch since the start, gaps mean lost batches
+    constexpr uint32_t
+    getSequence() const
+    {
+        return sequence;
+    }
+
+    constexpr uint16_t
+    operator()(size_t frame, size_t channel) const
+    {
+        return data[frame * Channels + channel];
+    }
+
+    /// @return the mean of a channel over the batch, rounded
+    constexpr uint16_t
+    mean(size_t channel) const
+    {
+        if (frames == 0) {
+            return 0;
+        }
+        uint32_t sum = 0;
+        for (size_t frame = 0; frame < frames; frame++) {
+            sum += (*this)(frame, channel);
+        }
+        return (sum + frames / 2) / frames;
+    }
+
+private:
+    const volatile uint16_t *data{nullptr};
+    size_t frames{0};
+    uint32_t sequence{0};
+};
+
+#endif // SAMPLE_BATCH_HPP
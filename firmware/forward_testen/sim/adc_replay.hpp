@@ -0,0 +1,107 @@
+#ifndef SIM_ADC_REPLAY_HPP
+#define SIM_ADC_REPLAY_HPP
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+
+#include "../sample_batch.hpp"
+
+namespace sim
+{
+    /**
+     * @brief Stand-in for `Acquisition` that replays a synthetic sample stream.
+     *
+     * The generator is called for every frame and channel in order, with the
+     * frame number since the start, and fills the same double buffer layout
+     * as the DMA does, so the consumers of the batches run unchanged on the
+     * host.
+     */
+    template<size_t Channels, size_t Frames>
+    class AdcReplay
+    {
+    public:
+        using Batch = SampleBatch<Channels>;
+        using Generator = std::function<uint16_t(uint64_t frame, size_t channel)>;
+
+        explicit AdcReplay(Generator generator) :
+            generator(std::move(generator))
+        {
+        }
+
+        /// Same semantics as `Acquisition::wait()`, without blocking.
+        Batch
+        wait()
+        {
+            const uint32_t sequence = ++completed;
+            overruns += sequence - taken - 1;
+            taken = sequence;
+            return fill(sequence);
+        }
+
+        /// Produces batches nobody takes, to test the overrun handling.
+        void
+        skip(uint32_t batches)
+        {
+            for (uint32_t ii = 0; ii < batches; ii++) {
+                fill(++completed);
+            }
+        }
+
+        uint32_t
+        getOverruns() const
+        {
+            return overruns;
+        }
+
+    private:
+        Batch
+        fill(uint32_t sequence)
+        {
+            const size_t offset = (sequence & 1) ? 0 : Frames * Channels;
+            for (size_t frame = 0; frame < Frames; frame++)
+            {
+                for (size_t channel = 0; channel < Channels; channel++) {
+                    buffer[offset + frame * Channels + channel] = generator(this->frame, channel);
+                }
+                this->frame++;
+            }
+            return Batch(buffer.data() + offset, Frames, sequence);
+        }
+
+        Generator generator;
+        std::array<uint16_t, 2 * Frames * Channels> buffer{};
+        uint64_t frame{0};
+        uint32_t completed{0};
+        uint32_t taken{0};
+        uint32_t overruns{0};
+    };
+
+    /// Generators for AdcReplay, 12 bit samples.
+    namespace waveform
+    {
+        /// @param period   in frames
+        inline uint16_t
+        sine(uint64_t frame, double offset, double amplitude, double period)
+        {
+            const double value = offset + amplitude * std::sin(2 * 3.14159265358979323846 * frame / period);
+            return (value < 0) ? 0 : (value > 4095) ? 4095 : uint16_t(std::lround(value));
+        }
+
+        /// Deterministic uniform noise in [-amplitude, amplitude] around `offset`.
+        inline uint16_t
+        noise(uint64_t frame, size_t channel, uint16_t offset, uint16_t amplitude)
+        {
+            // splitmix64, seeded by frame and channel
+            uint64_t z = frame * 0x9e3779b97f4a7c15ull + channel + 1;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            z ^= z >> 31;
+            const int32_t value = int32_t(offset) + int32_t(z % (2u * amplitude + 1)) - amplitude;
+            return (value < 0) ? 0 : (value > 4095) ? 4095 : uint16_t(value);
+        }
+    }
+}
+
+#endif // SIM_ADC_REPLAY_HPP
@@ -0,0 +1,86 @@
+#ifndef SIM_CAPTURE_RING_HPP
+#define SIM_CAPTURE_RING_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "../capture_span.hpp"
+
+namespace sim
+{
+    /**
+     * @brief Host stand-in for `CaptureRing`.
+     *
+     * Same static interface as the DMA capture of the target, the edges and
+     * their timestamps come from the ring of a MotorModel, which stamps them
+     * like a capture timer with its own tick frequency.
+     *
+     * `Capture` names the model instead of the timer:
+     * @code
+     * struct Capture
+     * {
+     *     static const sim::MotorModel& motor();
+     *     static constexpr uint32_t TickFrequency = 1'000'000;  // of the model
+     * };
+     * @endcode
+     */
+    template<class Capture, size_t Size = 32>
+    class CaptureRing
+    {
+        static_assert((Size & (Size - 1)) == 0, "The ring size must be a power of two!");
+
+    public:
+        using Timestamp = uint32_t;
+        using Span = CaptureSpan<Timestamp>;
+
+        /// Counts the edges from now on, the filter does not apply to the model.
+        template<class SystemClock>
+        static void
+        initialize(uint8_t = 0)
+        {
+            first = Capture::motor().getEdgeCount();
+            edges = 0;
+            idle = 0;
+        }
+
+        static void
+        poll()
+        {
+            const auto &motor = Capture::motor();
+            edges = motor.getEdgeCount() - first;
+            idle = edges ? motor.getIdleTime() : 0;
+        }
+
+        static uint32_t
+        getEdgeCount()
+        {
+            return edges;
+        }
+
+        static uint32_t
+        getIdleTime()
+        {
+            return idle;
+        }
+
+        static Span
+        getSpan(size_t length)
+        {
+            return Capture::motor().getSpan(std::min<size_t>({length, edges, Size}));
+        }
+
+        static constexpr uint32_t
+        getTickFrequency()
+        {
+            return Capture::TickFrequency;
+        }
+
+    private:
+        static inline uint32_t first{0};
+        static inline uint32_t edges{0};
+        static inline uint32_t idle{0};
+    };
+}
+
+#endif // SIM_CAPTURE_RING_HPP
@@ -0,0 +1,207 @@
+#ifndef SIM_GPIO_HPP
+#define SIM_GPIO_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace sim
+{
+    /// Level and direction of one simulated pin.
+    struct PinState
+    {
+        bool output{false};
+        bool level{false};      ///< driven output, or the external level of an input
+        bool pullUp{false};
+        bool connected{false};  ///< something outside drives the input
+        uint32_t edges{0};      ///< level changes since the start
+        /// Called on every level change, e.g. to model the EXTI line of the pin.
+        std::function<void(bool level)> onEdge;
+    };
+
+    /**
+     * @brief Host stand-in for a `modm::platform::Gpio` pin.
+     *
+     * Same static interface as the pin classes the firmware uses, the state
+     * lives in a static PinState per pin, like a register. The host side of
+     * a test drives inputs with drive() and observes outputs with state().
+     *
+     * @tparam Port  'A', 'B', ... like the modm pin names
+     */
+    template<char Port, uint8_t Pin>
+    class Gpio
+    {
+    public:
+        enum class
+        InputType : uint8_t
+        {
+            Floating,
+            PullUp,
+            PullDown,
+        };
+
+        static constexpr char port = Port;
+        static constexpr uint8_t pin = Pin;
+
+        static void
+        setOutput()
+        {
+            pinState.output = true;
+        }
+
+        static void
+        setOutput(bool status)
+        {
+            setOutput();
+            set(status);
+        }
+
+        static void
+        setInput(InputType type = InputType::Floating)
+        {
+            pinState.output = false;
+            pinState.pullUp = type == InputType::PullUp;
+            if (not pinState.connected) {
+                change(pinState.pullUp);
+            }
+        }
+
+        static void
+        set()
+        {
+            set(true);
+        }
+
+        static void
+        set(bool status)
+        {
+            if (pinState.output) {
+                change(status);
+            }
+        }
+
+        static void
+        reset()
+        {
+            set(false);
+        }
+
+        static void
+        toggle()
+        {
+            set(not pinState.level);
+        }
+
+        static bool
+        isSet()
+        {
+            return pinState.output and pinState.level;
+        }
+
+        static bool
+        read()
+        {
+            return pinState.level;
+        }
+
+        /// Drives the pin from outside, ignored while it is an output.
+        static void
+        drive(bool level)
+        {
+            pinState.connected = true;
+            if (not pinState.output) {
+                change(level);
+            }
+        }
+
+        /// Stops driving the pin, the pull resistor defines the level again.
+        static void
+        release()
+        {
+            pinState.connected = false;
+            if (not pinState.output) {
+                change(pinState.pullUp);
+            }
+        }
+
+        static PinState &
+        state()
+        {
+            return pinState;
+        }
+
+        /// Takes the bits of the pin from a BSRR write, set wins over reset
+        /// like on the target. The caller calls notify() afterwards.
+        /// @return true if the level changed
+        static bool
+        latch(uint32_t bsrr)
+        {
+            if (not pinState.output or not (bsrr & ((1ul << Pin) | (1ul << (Pin + 16))))) {
+                return false;
+            }
+            const bool level = bsrr & (1ul << Pin);
+            if (level == pinState.level) {
+                return false;
+            }
+            pinState.level = level;
+            pinState.edges++;
+            return true;
+        }
+
+        /// Reports the level of a latch() to the edge callback.
+        static void
+        notify()
+        {
+            if (pinState.onEdge) {
+                pinState.onEdge(pinState.level);
+            }
+        }
+
+    private:
+        static void
+        change(bool level)
+        {
+            if (level == pinState.level) {
+                return;
+            }
+            pinState.level = level;
+            pinState.edges++;
+            if (pinState.onEdge) {
+                pinState.onEdge(level);
+            }
+        }
+
+        static inline PinState pinState{};
+    };
+
+    /**
+     * @brief Host stand-in for the BSRR of the ports of some sim::Gpio.
+     *
+     * A write changes all its pins at once: every level is latched before
+     * the first edge callback runs, so a callback sees the port as it is
+     * after the write. `onWrite` is called after each write, e.g. to check
+     * the pins between the writes of a sequence.
+     */
+    template<class... Gpios>
+    class GpioPort
+    {
+    public:
+        static inline std::function<void(char port, uint32_t bsrr)> onWrite;
+        static inline uint32_t writes{0};
+
+        template<uint8_t Port>
+        static void
+        write(uint32_t bsrr)
+        {
+            writes++;
+            const bool changed[] = {(Gpios::port == char(Port) and Gpios::latch(bsrr))...};
+            size_t index = 0;
+            ((changed[index++] ? Gpios::notify() : void()), ...);
+            if (onWrite) {
+                onWrite(char(Port), bsrr);
+            }
+        }
+    };
+}
+
+#endif // SIM_GPIO_HPP
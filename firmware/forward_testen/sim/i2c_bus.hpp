@@ -0,0 +1,250 @@
+#ifndef SIM_I2C_BUS_HPP
+#define SIM_I2C_BUS_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+
+/**
+ * Host-side simulation of the robot hardware.
+ *
+ * Everything in this directory is header-only and meant for programs built on
+ * the development machine, see test/CMakeLists.txt, which replaces the target
+ * specific parts of modm with test/hosted/. The firmware build never includes
+ * it.
+ */
+namespace sim
+{
+    /**
+     * @brief Model of a device on the simulated I2C bus.
+     *
+     * The bus calls the model byte by byte, the same way a real slave sees the
+     * transfer. Returning `false` from start() or write() sends a NACK.
+     */
+    class I2cDeviceModel
+    {
+    public:
+        explicit I2cDeviceModel(uint8_t address) : address(address) {}
+        virtual ~I2cDeviceModel() = default;
+
+        /// @return the 7-bit slave address
+        uint8_t
+        getAddress() const { return address; }
+
+        /// Addressed with a (repeated) start condition.
+        virtual bool
+        start(bool read) { (void) read; return true; }
+
+        virtual bool
+        write(uint8_t data) = 0;
+
+        virtual uint8_t
+        read() = 0;
+
+        virtual void
+        stop() {}
+
+        /// Time the device holds SCL low before each byte.
+        virtual std::chrono::nanoseconds
+        stretch() const { return {}; }
+
+    protected:
+        uint8_t address;
+    };
+
+    /**
+     * @brief Simulated I2C bus with bus timing and fault injection.
+     *
+     * The bus keeps its own clock, which advances by the time each transfer
+     * would take on the wire, so the bus load of a driver can be measured
+     * independently of the host speed.
+     */
+    class I2cBus
+    {
+    public:
+        enum class
+        Fault : uint8_t
+        {
+            AddressNack,     ///< The slave does not acknowledge its address
+            DataNack,        ///< The slave does not acknowledge the first data byte
+            ArbitrationLost, ///< Another master wins the bus
+            BusError,        ///< Misplaced start or stop condition
+            StuckBus,        ///< A slave holds SDA low until nine SCL pulses
+        };
+
+        /// Result of a bus operation as seen by the master.
+        enum class
+        Status : uint8_t
+        {
+            Ack,
+            Nack,
+            ArbitrationLost,
+            BusError,
+            Stuck,
+        };
+
+        void
+        attach(I2cDeviceModel &device)
+        {
+            devices.push_back(&device);
+        }
+
+        void
+        setBaudrate(uint32_t baudrate)
+        {
+            bitTime = std::chrono::nanoseconds(1'000'000'000 / baudrate);
+        }
+
+        /// Additional clock stretching before every byte, on top of the device's own.
+        void
+        setClockStretching(std::chrono::nanoseconds stretch)
+        {
+            this->stretch = stretch;
+        }
+
+        /// Fails a future transaction, `after` transactions are executed normally before.
+        void
+        injectFault(Fault fault, uint32_t after = 0)
+        {
+            faults.push_back({fault, after});
+        }
+
+        /// @return the simulated time spent on the bus
+        std::chrono::nanoseconds
+        now() const { return time; }
+
+        /// Advances the simulated time, e.g. while the master is idle.
+        void
+        advance(std::chrono::nanoseconds duration) { time += duration; }
+
+        bool
+        isStuck() const { return stuck; }
+
+        /// Clocks out nine SCL pulses followed by a stop condition.
+        void
+        clockOut()
+        {
+            time += 10 * bitTime;
+            stuck = false;
+            if (selected) selected->stop();
+            selected = nullptr;
+        }
+
+        /// Called by the master at the beginning of each transaction.
+        void
+        beginTransaction()
+        {
+            current.reset();
+            for (auto it = faults.begin(); it != faults.end(); ++it)
+            {
+                if (it->after == 0)
+                {
+                    current = it->fault;
+                    faults.erase(it);
+                    break;
+                }
+            }
+            for (PendingFault &fault : faults) {
+                if (fault.after) fault.after--;
+            }
+        }
+
+        Status
+        start(uint8_t address, bool read)
+        {
+            time += bitTime;
+            if (stuck) return Status::Stuck;
+            if (auto status = takeFault(Fault::ArbitrationLost, Status::ArbitrationLost);
+                status != Status::Ack) return status;
+            if (auto status = takeFault(Fault::BusError, Status::BusError);
+                status != Status::Ack) return status;
+
+            selected = nullptr;
+            time += 9 * bitTime;
+            for (I2cDeviceModel *device : devices)
+            {
+                if (device->getAddress() == address)
+                {
+                    time += stretch + device->stretch();
+                    if (takeFault(Fault::AddressNack, Status::Nack) == Status::Nack) return Status::Nack;
+                    if (not device->start(read)) return Status::Nack;
+                    selected = device;
+                    return Status::Ack;
+                }
+            }
+            return Status::Nack;
+        }
+
+        Status
+        write(uint8_t data)
+        {
+            if (stuck) return Status::Stuck;
+            if (not selected) return Status::Nack;
+            time += 9 * bitTime + stretch + selected->stretch();
+            if (takeFault(Fault::DataNack, Status::Nack) == Status::Nack) return Status::Nack;
+            if (takeFault(Fault::StuckBus, Status::Stuck) == Status::Stuck)
+            {
+                stuck = true;
+                return Status::Stuck;
+            }
+            return selected->write(data) ? Status::Ack : Status::Nack;
+        }
+
+        Status
+        read(uint8_t &data)
+        {
+            if (stuck) return Status::Stuck;
+            if (not selected) return Status::Nack;
+            time += 9 * bitTime + stretch + selected->stretch();
+            if (takeFault(Fault::StuckBus, Status::Stuck) == Status::Stuck)
+            {
+                stuck = true;
+                return Status::Stuck;
+            }
+            data = selected->read();
+            return Status::Ack;
+        }
+
+        void
+        stop()
+        {
+            time += bitTime;
+            if (stuck) return;
+            if (selected) selected->stop();
+            selected = nullptr;
+        }
+
+    private:
+        struct PendingFault
+        {
+            Fault fault;
+            uint32_t after;
+        };
+
+        /// @return `status` once if the fault of this transaction is of the given kind
+        Status
+        takeFault(Fault fault, Status status)
+        {
+            if (current == fault)
+            {
+                current.reset();
+                return status;
+            }
+            return Status::Ack;
+        }
+
+        std::vector<I2cDeviceModel *> devices;
+        std::deque<PendingFault> faults;
+        std::optional<Fault> current;
+
+        I2cDeviceModel *selected{nullptr};
+        std::chrono::nanoseconds bitTime{2500}; // 400 kHz
+        std::chrono::nanoseconds stretch{};
+        std::chrono::nanoseconds time{};
+        bool stuck{false};
+    };
+}
+
+#endif // SIM_I2C_BUS_HPP
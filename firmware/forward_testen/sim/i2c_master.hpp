@@ -0,0 +1,189 @@
+#ifndef SIM_I2C_MASTER_HPP
+#define SIM_I2C_MASTER_HPP
+
+#include <modm/architecture/interface/i2c_master.hpp>
+#include "i2c_bus.hpp"
+
+namespace sim
+{
+    /**
+     * @brief `modm::I2cMaster` executing transactions on a simulated bus.
+     *
+     * Drop-in replacement for `modm::platform::I2cMaster1` in host builds, so
+     * `modm::I2cDevice` based drivers run unchanged. Transactions are executed
+     * synchronously inside start(), so they have finished before the driver
+     * starts waiting. Mirrors the bus statistics and recovery interface of the
+     * target drivers.
+     *
+     * @tparam Instance distinguishes several simulated buses
+     */
+    template<uint8_t Instance = 0>
+    class I2cMaster : public ::modm::I2cMaster
+    {
+    public:
+        static constexpr size_t TransactionBufferSize = 8;
+
+        /// Connects the master to a bus, must be called before any transaction.
+        static void
+        connect(I2cBus &bus)
+        {
+            I2cMaster::bus = &bus;
+        }
+
+        static bool
+        start(modm::I2cTransaction *transaction, ConfigurationHandler handler = nullptr)
+        {
+            if (transaction == nullptr) {
+                return false;
+            }
+            if (not transaction->attaching())
+            {
+                transaction->detaching(DetachCause::FailedToAttach);
+                return false;
+            }
+            if (handler and configuration != handler) {
+                configuration = handler;
+                configuration();
+            }
+
+            const auto begin = bus->now();
+            bus->beginTransaction();
+            error = execute(*transaction);
+            switch (error)
+            {
+                case Error::AddressNack: statistics.addressNacks++; break;
+                case Error::DataNack: statistics.dataNacks++; break;
+                case Error::ArbitrationLost: statistics.arbitrationLosses++; break;
+                case Error::BusCondition: statistics.busErrors++; break;
+                case Error::BusBusy: statistics.timeouts++; break;
+                default: break;
+            }
+            statistics.transactions++;
+            statistics.addLatency(std::chrono::duration_cast<std::chrono::microseconds>(bus->now() - begin).count());
+
+            transaction->detaching(error == Error::NoError ? DetachCause::NormalStop : DetachCause::ErrorCondition);
+            transaction->notify();
+            return true;
+        }
+
+        static Error
+        getErrorState()
+        {
+            return error;
+        }
+
+        static void
+        reset()
+        {
+            error = Error::SoftwareReset;
+        }
+
+        /// Recovers the bus if a slave holds it. @return `true` if it was stuck.
+        static bool
+        supervise()
+        {
+            if (not bus->isStuck()) {
+                return false;
+            }
+            statistics.timeouts++;
+            recover();
+            return true;
+        }
+
+        static void
+        recover()
+        {
+            statistics.recoveries++;
+            bus->clockOut();
+        }
+
+        static const Statistics&
+        getStatistics()
+        {
+            return statistics;
+        }
+
+        static void
+        resetStatistics()
+        {
+            statistics = {};
+        }
+
+    private:
+        static Error
+        toError(I2cBus::Status status, Error nack)
+        {
+            switch (status)
+            {
+                case I2cBus::Status::Ack: return Error::NoError;
+                case I2cBus::Status::Nack: return nack;
+                case I2cBus::Status::ArbitrationLost: return Error::ArbitrationLost;
+                case I2cBus::Status::BusError: return Error::BusCondition;
+                case I2cBus::Status::Stuck: return Error::BusBusy;
+            }
+            return Error::Unknown;
+        }
+
+        static Error
+        execute(modm::I2cTransaction &transaction)
+        {
+            auto starting = transaction.starting();
+            while (true)
+            {
+                const bool read = (starting.next == OperationAfterStart::Read);
+                const uint8_t address = starting.address >> 1;
+                if (Error e = toError(bus->start(address, read), Error::AddressNack); e != Error::NoError)
+                {
+                    bus->stop();
+                    return e;
+                }
+
+                Operation next = static_cast<Operation>(starting.next);
+                while (next == Operation::Write or next == Operation::Read)
+                {
+                    if (next == Operation::Write)
+                    {
+                        const auto writing = transaction.writing();
+                        for (size_t ii = 0; ii < writing.length; ii++)
+                        {
+                            if (Error e = toError(bus->write(writing.buffer[ii]), Error::DataNack); e != Error::NoError)
+                            {
+                                bus->stop();
+                                return e;
+                            }
+                        }
+                        next = static_cast<Operation>(writing.next);
+                    }
+                    else
+                    {
+                        const auto reading = transaction.reading();
+                        for (size_t ii = 0; ii < reading.length; ii++)
+                        {
+                            if (Error e = toError(bus->read(reading.buffer[ii]), Error::DataNack); e != Error::NoError)
+                            {
+                                bus->stop();
+                                return e;
+                            }
+                        }
+                        next = static_cast<Operation>(reading.next);
+                    }
+                }
+
+                if (next == Operation::Stop)
+                {
+                    bus->stop();
+                    return Error::NoError;
+                }
+                // repeated start
+                starting = transaction.starting();
+            }
+        }
+
+        static inline I2cBus *bus{nullptr};
+        static inline ConfigurationHandler configuration{nullptr};
+        static inline Error error{Error::NoError};
+        static inline Statistics statistics{};
+    };
+}
+
+#endif // SIM_I2C_MASTER_HPP
@@ -0,0 +1,178 @@
+#ifndef SIM_MOTOR_MODEL_HPP
+#define SIM_MOTOR_MODEL_HPP
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+#include "../capture_span.hpp"
+
+namespace sim
+{
+    /**
+     * @brief Brushed-equivalent model of a wheel motor with its FG output.
+     *
+     * Electrical and mechanical dynamics of a DC motor driven by a PWM bridge:
+     *
+     *     L di/dt = duty * U - R i - ke w
+     *     J dw/dt = kt i - b w - load
+     *
+     * integrated with a fixed internal step. The rotor angle generates FG
+     * edges, which are timestamped with the resolution of a capture timer
+     * into a ring like `CaptureRing` does, so the speed estimation of the
+     * firmware can be reproduced exactly in closed-loop tests.
+     */
+    class MotorModel
+    {
+    public:
+        struct Parameters
+        {
+            double supply = 12.0;           ///< V
+            double resistance = 2.0;        ///< Ohm
+            double inductance = 0.5e-3;     ///< H
+            double torqueConstant = 0.018;  ///< Nm/A, also back EMF in V s/rad
+            double inertia = 4e-6;          ///< kg m^2, rotor plus reflected wheel
+            double friction = 2e-6;         ///< Nm s/rad
+            uint32_t pulsesPerRevolution = 4;
+            uint32_t tickFrequency = 1'000'000; ///< Hz, of the capture timer
+        };
+
+        MotorModel() = default;
+
+        explicit MotorModel(const Parameters &parameters) :
+            parameters(parameters)
+        {
+        }
+
+        /// Supply voltage in V, e.g. to simulate battery sag.
+        void
+        setSupply(double volt)
+        {
+            parameters.supply = volt;
+        }
+
+        /// Load torque in Nm, always opposing the rotation.
+        void
+        setLoad(double newtonMeter)
+        {
+            load = newtonMeter;
+        }
+
+        /**
+         * @brief Advances the simulation.
+         *
+         * @param duty  signed duty cycle as Q15, like SpeedController's output
+         */
+        void
+        step(int16_t duty, std::chrono::nanoseconds duration)
+        {
+            const double dt = Step.count() * 1e-9;
+            const double voltage = duty / 32768.0 * parameters.supply;
+            for (auto elapsed = std::chrono::nanoseconds{}; elapsed < duration; elapsed += Step)
+            {
+                const double emf = parameters.torqueConstant * omega;
+                current += (voltage - parameters.resistance * current - emf) / parameters.inductance * dt;
+
+                double torque = parameters.torqueConstant * current - parameters.friction * omega;
+                if (omega != 0) {
+                    torque -= std::copysign(load, omega);
+                } else if (std::abs(torque) > load) {
+                    torque -= std::copysign(load, torque);
+                } else {
+                    torque = 0;     // static friction holds the wheel
+                }
+                const double next = omega + torque / parameters.inertia * dt;
+                // friction stops the wheel but never drives it backwards
+                omega = (omega != 0 and std::signbit(next) != std::signbit(omega)) ? 0 : next;
+
+                time += Step;
+                angle += std::abs(omega) * dt;
+                const double pulse = 2 * Pi / parameters.pulsesPerRevolution;
+                while (angle >= pulse)
+                {
+                    angle -= pulse;
+                    edge();
+                }
+            }
+        }
+
+        /// @return the true motor speed in rpm
+        double
+        getSpeed() const
+        {
+            return omega * 60 / (2 * Pi);
+        }
+
+        /// @return the winding current in A
+        double
+        getCurrent() const
+        {
+            return current;
+        }
+
+        /// @return the simulated time in capture timer ticks
+        uint32_t
+        now() const
+        {
+            return toTicks(time);
+        }
+
+        /// Same semantics as `CaptureRing::getSpan()`.
+        CaptureSpan<uint32_t>
+        getSpan(size_t length) const
+        {
+            if (length > edges) length = edges;
+            if (length > RingSize) length = RingSize;
+            return CaptureSpan<uint32_t>(ring, RingSize, (edges - 1) % RingSize, length);
+        }
+
+        /// @return the ticks since the last edge
+        uint32_t
+        getIdleTime() const
+        {
+            return edges ? now() - ring[(edges - 1) % RingSize] : 0;
+        }
+
+        uint32_t
+        getEdgeCount() const
+        {
+            return edges;
+        }
+
+        uint32_t
+        getTickFrequency() const
+        {
+            return parameters.tickFrequency;
+        }
+
+    private:
+        static constexpr double Pi = 3.14159265358979323846;
+        static constexpr std::chrono::nanoseconds Step{1000};
+        static constexpr size_t RingSize = 32;
+
+        uint32_t
+        toTicks(std::chrono::nanoseconds t) const
+        {
+            return uint32_t(uint64_t(t.count()) * parameters.tickFrequency / 1'000'000'000ull);
+        }
+
+        void
+        edge()
+        {
+            ring[edges % RingSize] = now();
+            edges++;
+        }
+
+        Parameters parameters{};
+        double load{0};
+        double current{0};
+        double omega{0};    ///< rad/s
+        double angle{0};    ///< rad since the last FG edge
+        std::chrono::nanoseconds time{};
+
+        uint32_t ring[RingSize]{};
+        uint32_t edges{0};
+    };
+}
+
+#endif // SIM_MOTOR_MODEL_HPP
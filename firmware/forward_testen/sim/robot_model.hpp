@@ -0,0 +1,164 @@
+#ifndef SIM_ROBOT_MODEL_HPP
+#define SIM_ROBOT_MODEL_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "motor_model.hpp"
+
+namespace sim
+{
+    /**
+     * @brief Differential-drive robot in a rectangular arena.
+     *
+     * Two MotorModels drive the wheels directly, the pose is integrated from
+     * the true wheel speeds on exact arcs, so it is the ground truth to
+     * compare the odometry of the firmware against. The arena is an empty
+     * rectangle with the origin in its center, the range sensor looks along
+     * the heading from the center of the axle.
+     */
+    class RobotModel
+    {
+    public:
+        struct Geometry
+        {
+            double wheelDiameter = 0.065;   ///< m
+            double trackWidth = 0.120;      ///< m, between the wheel contact points
+            double sensorOffset = 0.040;    ///< m, from the axle center to the ToF sensor
+        };
+
+        struct Arena
+        {
+            double width = 2.0;     ///< m, along x
+            double height = 2.0;    ///< m, along y
+        };
+
+        struct Pose
+        {
+            double x = 0;       ///< m
+            double y = 0;       ///< m
+            double heading = 0; ///< rad, counterclockwise from x
+        };
+
+        RobotModel() = default;
+
+        RobotModel(const Geometry &geometry, const Arena &arena,
+                   const MotorModel::Parameters &motor = MotorModel::Parameters()) :
+            leftMotor(motor), rightMotor(motor), geometry(geometry), arena(arena)
+        {
+        }
+
+        void
+        setPose(const Pose &pose)
+        {
+            this->pose = pose;
+        }
+
+        /**
+         * @brief Advances the simulation.
+         *
+         * @param left,right    signed duty cycles as Q15, positive forwards
+         */
+        void
+        step(int16_t left, int16_t right, std::chrono::nanoseconds duration)
+        {
+            const double beforeLeft = leftSpeed(), beforeRight = rightSpeed();
+            leftMotor.step(left, duration);
+            rightMotor.step(right, duration);
+
+            // trapezoidal wheel speeds over the step, exact arc for the pose
+            const double dt = duration.count() * 1e-9;
+            const double vl = (beforeLeft + leftSpeed()) / 2, vr = (beforeRight + rightSpeed()) / 2;
+            const double distance = (vl + vr) / 2 * dt;
+            const double turn = (vr - vl) / geometry.trackWidth * dt;
+            const double mid = pose.heading + turn / 2;
+            const double chord = (std::abs(turn) > 1e-9) ? distance * std::sin(turn / 2) / (turn / 2) : distance;
+            pose.x += chord * std::cos(mid);
+            pose.y += chord * std::sin(mid);
+            pose.heading = std::remainder(pose.heading + turn, 2 * Pi);
+            travelled += std::abs(distance);
+        }
+
+        /**
+         * @return the distance from a range sensor to the wall in m
+         *
+         * @param bearing   rad from the heading to the sensor, which sits
+         *                  `sensorOffset` from the axle center and looks
+         *                  outwards, 0 is the front sensor
+         */
+        double
+        getRange(double bearing = 0) const
+        {
+            const double c = std::cos(pose.heading + bearing), s = std::sin(pose.heading + bearing);
+            const double x = pose.x + geometry.sensorOffset * c;
+            const double y = pose.y + geometry.sensorOffset * s;
+            double range = std::numeric_limits<double>::infinity();
+            if (c > 0) range = std::min(range, (arena.width / 2 - x) / c);
+            if (c < 0) range = std::min(range, (-arena.width / 2 - x) / c);
+            if (s > 0) range = std::min(range, (arena.height / 2 - y) / s);
+            if (s < 0) range = std::min(range, (-arena.height / 2 - y) / s);
+            return std::max(range, 0.0);
+        }
+
+        /// @return true while the robot body is inside the arena
+        bool
+        isInside() const
+        {
+            const double margin = geometry.trackWidth / 2;
+            return std::abs(pose.x) <= arena.width / 2 - margin and std::abs(pose.y) <= arena.height / 2 - margin;
+        }
+
+        const Pose &
+        getPose() const
+        {
+            return pose;
+        }
+
+        /// @return the path length driven since the start in m
+        double
+        getTravelled() const
+        {
+            return travelled;
+        }
+
+        MotorModel &
+        left()
+        {
+            return leftMotor;
+        }
+
+        MotorModel &
+        right()
+        {
+            return rightMotor;
+        }
+
+    private:
+        static constexpr double Pi = 3.14159265358979323846;
+
+        /// wheel surface speed in m/s, the motors drive the wheels directly
+        double
+        leftSpeed() const
+        {
+            return leftMotor.getSpeed() / 60 * Pi * geometry.wheelDiameter;
+        }
+
+        double
+        rightSpeed() const
+        {
+            return rightMotor.getSpeed() / 60 * Pi * geometry.wheelDiameter;
+        }
+
+        MotorModel leftMotor;
+        MotorModel rightMotor;
+        Geometry geometry;
+        Arena arena;
+        Pose pose;
+        double travelled{0};
+    };
+}
+
+#endif // SIM_ROBOT_MODEL_HPP
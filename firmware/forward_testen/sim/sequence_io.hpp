@@ -0,0 +1,58 @@
+#ifndef SIM_SEQUENCE_IO_HPP
+#define SIM_SEQUENCE_IO_HPP
+
+#include <vector>
+
+#include "sim_board.hpp"
+#include "../test_sequence.hpp"
+
+namespace sim
+{
+    /**
+     * @brief `TestSequence::run()` on the SimBoard.
+     *
+     * Sets the pins and compare values like the target does and advances
+     * the world instead of sleeping. The records are collected for the
+     * assertions of the test.
+     */
+    struct SequenceIo
+    {
+        static inline SimBoard::World *world{nullptr};
+        static inline std::vector<TestSequence::Record> records;
+
+        static void
+        apply(const TestSequence::Step &step)
+        {
+            using namespace SimBoard;
+            MotorMode::apply(step.pins);
+            const uint16_t duty = std::max(step.duty, modm::Q15()).scale(MotorPwm::Resolution);
+            MotorPwm::setCompare(duty, duty);
+        }
+
+        static void
+        wait(std::chrono::milliseconds time)
+        {
+            world->run(time);
+        }
+
+        static uint32_t
+        getEdgeCount(uint8_t motor)
+        {
+            return motor ? world->robot.right().getEdgeCount() : world->robot.left().getEdgeCount();
+        }
+
+        static bool
+        isFault(uint8_t motor)
+        {
+            return not (motor ? SimBoard::M2_Fault::read() : SimBoard::M1_Fault::read());
+        }
+
+        static void
+        report(const TestSequence::Record &record)
+        {
+            records.push_back(record);
+        }
+    };
+}
+
+#endif // SIM_SEQUENCE_IO_HPP
@@ -0,0 +1,329 @@
+#ifndef SIM_BOARD_HPP
+#define SIM_BOARD_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+#include "gpio.hpp"
+#include "uart.hpp"
+#include "i2c_bus.hpp"
+#include "i2c_master.hpp"
+#include "vl53l0_model.hpp"
+#include "robot_model.hpp"
+#include "../motor_mode.hpp"
+
+/**
+ * @brief Host stand-in for `Board` in hardware.hpp.
+ *
+ * Same names and static interfaces as the real board, backed by the models
+ * in sim/: pins are sim::Gpio, the debug UART is a sim::Uart, the ToF
+ * sensor sits on a sim::I2cBus and the motor PWM drives a sim::RobotModel.
+ * On the host hardware.hpp includes this header instead of the target
+ * board, `Board` is an alias of `SimBoard` then. The tacho capture reads
+ * the FG edges of the wheel models (see sim::CaptureRing) and the update
+ * interrupt of the motor timers calls the ControlExecutive, so MotorControl,
+ * the Odometry and the Mission run unchanged, with the host stand-ins of
+ * the executive and the FaultMonitor in test/hosted/. Other register level
+ * code, the ADC, the FMAC and the EXTI lines, stays target only, the host
+ * uses the replays in sim/ for those. led_testen is not built on the host.
+ *
+ * Time only passes in World::run(), so a mission runs as fast as the host
+ * computes it, independent of the simulated duration.
+ */
+namespace SimBoard
+{
+    /// Same frequencies as the STM32G474 at 170 MHz
+    struct SystemClock
+    {
+        static constexpr uint32_t Frequency = 170'000'000;
+        static constexpr uint32_t Apb1 = Frequency;
+        static constexpr uint32_t Apb2 = Frequency;
+        static constexpr uint32_t I2c3 = Apb1;
+        static constexpr uint32_t Usart1 = Apb2;
+        static constexpr uint32_t Timer2 = Apb1;
+        static constexpr uint32_t Timer3 = Apb1;
+    };
+
+    // ------------------- Led Pin -------------------
+    using Led_D2 = sim::Gpio<'A', 11>;
+
+    // ------------------- Motor 1 Pins (left) -------------------
+    using M1_Sleep = sim::Gpio<'A', 5>;
+    using M1_Fault = sim::Gpio<'A', 6>;
+    using M1_Tacho = sim::Gpio<'A', 7>;
+    using M1_Pwm   = sim::Gpio<'B', 0>;
+    using M1_Dir   = sim::Gpio<'B', 1>;
+    using M1_Brake = sim::Gpio<'F', 0>;
+    // ------------------- Motor 2 Pins (right) -------------------
+    using M2_Sleep = sim::Gpio<'C', 15>;
+    using M2_Fault = sim::Gpio<'F', 1>;
+    using M2_Tacho = sim::Gpio<'B', 2>;
+    using M2_Pwm   = sim::Gpio<'A', 0>;
+    using M2_Dir   = sim::Gpio<'A', 1>;
+    using M2_Brake = sim::Gpio<'A', 4>;
+
+    /// Both drivers switch modes through a model of the port writes
+    using MotorPort = sim::GpioPort<M1_Sleep, M1_Brake, M1_Dir, M2_Sleep, M2_Brake, M2_Dir>;
+    using MotorMode = MotorModeSwitch<MotorPort,
+                                      DriverPins<M1_Sleep, M1_Brake, M1_Dir>,
+                                      DriverPins<M2_Sleep, M2_Brake, M2_Dir>>;
+
+    using Wave1 = sim::Gpio<'A', 3>;
+    using Wave2 = sim::Gpio<'A', 2>;
+
+    // ------------------- Motor PWM -------------------
+    /// Compare registers of both motor timers, read by World::run().
+    struct MotorPwm
+    {
+        /// Same as the 20 kHz center-aligned configuration on the target
+        static constexpr uint16_t Resolution = 4250;
+        static constexpr uint32_t UpdateFrequency = 40'000;
+
+        static void
+        initialize()
+        {
+            setCompare(Resolution / 2, Resolution / 2);
+            release();
+        }
+
+        static void
+        setCompare(uint16_t motor1, uint16_t motor2)
+        {
+            compare[0] = motor1;
+            compare[1] = motor2;
+        }
+
+        static void
+        forceInactive()
+        {
+            forced = true;
+        }
+
+        static void
+        release()
+        {
+            forced = false;
+        }
+
+        /// @return the duty cycle of a motor output as Q15, 0 while forced inactive
+        static int16_t
+        getDuty(uint8_t motor)
+        {
+            if (forced) {
+                return 0;
+            }
+            const uint32_t value = std::min<uint32_t>(compare[motor], Resolution);
+            return int16_t(std::min<uint32_t>(value * 32768 / Resolution, 32767));
+        }
+
+    private:
+        static inline uint16_t compare[2]{};
+        static inline bool forced{false};
+    };
+
+    // ------------------- Control interrupt -------------------
+    /// The update interrupt of MotorTimer3, which runs the ControlExecutive.
+    struct MotorTimer3
+    {
+        /// Called by World::run() with every timer update, twice per PWM period
+        static inline void (*update)() {nullptr};
+    };
+
+    // ------------------- Analog -------------------
+    struct Analog
+    {
+        static constexpr uint8_t Vrefint = 18;
+        static constexpr uint8_t Temperature = 16;
+        static constexpr uint8_t Battery = 0xff;
+        static constexpr uint16_t BatteryDivider = 11;
+        static constexpr uint8_t Channels[] = {Vrefint, Temperature};
+        static constexpr size_t Frames = 20;
+    };
+
+    // ------------------- Debug UART -------------------
+    namespace DebugUart {
+        using DebugUart = sim::Uart<1>;
+
+        inline void initialize()
+        {
+            DebugUart::initialize<SystemClock, 115200>();
+        }
+    }
+
+    // ------------------- I2C (VL53L0X ToF sensor) -------------------
+    struct I2c
+    {
+        using Master = sim::I2cMaster<3>;
+
+        static void initialize()
+        {
+        }
+    };
+
+    // ------------------- Board Initialization -------------------
+    /// Same pin setup as `Board::initialize()`.
+    inline void
+    initialize()
+    {
+        M1_Fault::setInput(M1_Fault::InputType::PullUp);
+        M1_Tacho::setInput();
+
+        M2_Fault::setInput(M2_Fault::InputType::PullUp);
+        M2_Tacho::setInput();
+
+        M1_Sleep::setOutput(false);
+        M1_Dir::setOutput(false);
+        M1_Brake::setOutput(false);
+        M2_Sleep::setOutput(false);
+        M2_Dir::setOutput(false);
+        M2_Brake::setOutput(false);
+        MotorMode::apply<MotorMode::Sleep>();
+
+        MotorPwm::initialize();
+
+        Led_D2::setOutput();
+        Wave1::setOutput();
+        Wave2::setOutput();
+
+        DebugUart::initialize();
+        I2c::initialize();
+    }
+
+    /**
+     * @brief The physical world around the simulated board.
+     *
+     * Owns the models and connects them to the pins: the motor outputs set
+     * the wheel duty cycles, the wheels toggle the tacho pins and the ToF
+     * sensor measures the distance to the arena wall in front. Only one
+     * World may exist at a time, since the pins are static like registers.
+     * After each step of the models the timer updates of the step call the
+     * control interrupt.
+     */
+    class World
+    {
+    public:
+        /// Integration step, the PWM is averaged over it
+        static constexpr std::chrono::nanoseconds Step{50'000};
+
+        explicit World(const sim::RobotModel &robot = sim::RobotModel()) :
+            robot(robot)
+        {
+            instance = this;
+            bus.attach(sensor);
+            I2c::Master::connect(bus);
+            sensor.setSource([this]()
+            {
+                const double range = this->robot.getRange() * 1000;
+                if (range > 2000) {
+                    return sim::Vl53l0Model::Sample{8190, 0, sim::Vl53l0Model::RangeErrorCode::RangePhaseCheck};
+                }
+                return sim::Vl53l0Model::Sample{uint16_t(std::lround(range)), 20 << 7,
+                                                sim::Vl53l0Model::RangeErrorCode::RangeComplete};
+            });
+        }
+
+        World(const World &) = delete;
+
+        ~World()
+        {
+            instance = nullptr;
+        }
+
+        /// @return the World which exists at the moment
+        static World &
+        get()
+        {
+            return *instance;
+        }
+
+        /// Advances the simulated time, the firmware runs in between calls and in the control interrupt.
+        void
+        run(std::chrono::nanoseconds duration)
+        {
+            for (auto elapsed = std::chrono::nanoseconds{}; elapsed < duration; elapsed += Step)
+            {
+                const uint32_t left = robot.left().getEdgeCount();
+                const uint32_t right = robot.right().getEdgeCount();
+                robot.step(duty<M1_Sleep, M1_Brake, M1_Dir>(0), duty<M2_Sleep, M2_Brake, M2_Dir>(1), Step);
+                toggle<M1_Tacho>(robot.left().getEdgeCount() - left);
+                toggle<M2_Tacho>(robot.right().getEdgeCount() - right);
+                time += Step;
+                for (uint32_t update = 0; update < Updates and MotorTimer3::update; update++) {
+                    MotorTimer3::update();
+                }
+            }
+            if (bus.now() < time) {
+                bus.advance(time - bus.now());
+            }
+        }
+
+        std::chrono::nanoseconds
+        now() const
+        {
+            return time;
+        }
+
+        sim::RobotModel robot;
+        sim::I2cBus bus;
+        sim::Vl53l0Model sensor;
+
+    private:
+        static constexpr uint32_t Updates = Step.count() * MotorPwm::UpdateFrequency / 1'000'000'000;
+        static_assert(Updates * 1'000'000'000 == Step.count() * MotorPwm::UpdateFrequency,
+                      "A step must span whole timer updates!");
+
+        static inline World *instance{nullptr};
+
+        /// Signed duty cycle of one wheel from its driver pins, a braked wheel coasts.
+        template<class Sleep, class Brake, class Dir>
+        static int16_t
+        duty(uint8_t motor)
+        {
+            if (not Sleep::isSet() or Brake::isSet()) {
+                return 0;
+            }
+            const int16_t value = MotorPwm::getDuty(motor);
+            return Dir::isSet() ? -value : value;
+        }
+
+        template<class Tacho>
+        static void
+        toggle(uint32_t edges)
+        {
+            while (edges--) {
+                Tacho::drive(not Tacho::read());
+            }
+        }
+
+        std::chrono::nanoseconds time{};
+    };
+
+    // ------------------- Tacho capture -------------------
+    /// The FG edges of the wheel models, stamped with the 1 MHz of their default parameters
+    struct M1_Capture
+    {
+        static constexpr uint32_t TickFrequency = 1'000'000;
+
+        static const sim::MotorModel &
+        motor()
+        {
+            return World::get().robot.left();
+        }
+    };
+    struct M2_Capture
+    {
+        static constexpr uint32_t TickFrequency = 1'000'000;
+
+        static const sim::MotorModel &
+        motor()
+        {
+            return World::get().robot.right();
+        }
+    };
+}
+
+namespace Board = SimBoard;
+
+#endif // SIM_BOARD_HPP
@@ -0,0 +1,135 @@
+#ifndef SIM_UART_HPP
+#define SIM_UART_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+
+namespace sim
+{
+    /**
+     * @brief Host stand-in for a `modm::platform::BufferedUart`.
+     *
+     * Same static interface as the buffered UART of the target, the wire is
+     * infinitely fast: written bytes appear in transmitted() immediately and
+     * bytes passed to receive() can be read right away.
+     *
+     * @tparam Instance distinguishes several simulated UARTs
+     */
+    template<uint8_t Instance = 1>
+    class Uart
+    {
+    public:
+        template<class... Signals>
+        static void
+        connect()
+        {
+        }
+
+        template<class SystemClock, uint32_t baudrate>
+        static void
+        initialize()
+        {
+            Uart::baudrate = baudrate;
+        }
+
+        static bool
+        write(uint8_t data)
+        {
+            tx.push_back(char(data));
+            return true;
+        }
+
+        static size_t
+        write(const uint8_t *data, size_t length)
+        {
+            tx.append(reinterpret_cast<const char *>(data), length);
+            return length;
+        }
+
+        static bool
+        isWriteFinished()
+        {
+            return true;
+        }
+
+        static void
+        flushWriteBuffer()
+        {
+        }
+
+        static bool
+        read(uint8_t &data)
+        {
+            if (rx.empty()) {
+                return false;
+            }
+            data = rx.front();
+            rx.pop_front();
+            return true;
+        }
+
+        static size_t
+        read(uint8_t *data, size_t length)
+        {
+            size_t count = 0;
+            while (count < length and read(data[count])) {
+                count++;
+            }
+            return count;
+        }
+
+        static size_t
+        receiveBufferSize()
+        {
+            return rx.size();
+        }
+
+        static size_t
+        discardReceiveBuffer()
+        {
+            const size_t count = rx.size();
+            rx.clear();
+            return count;
+        }
+
+        // Host side of the wire
+
+        /// Bytes sent by the firmware since the last take().
+        static const std::string &
+        transmitted()
+        {
+            return tx;
+        }
+
+        /// @return and clears the bytes sent by the firmware
+        static std::string
+        take()
+        {
+            std::string text;
+            text.swap(tx);
+            return text;
+        }
+
+        /// Queues bytes for the firmware to read.
+        static void
+        receive(const std::string &text)
+        {
+            rx.insert(rx.end(), text.begin(), text.end());
+        }
+
+        static uint32_t
+        getBaudrate()
+        {
+            return baudrate;
+        }
+
+    private:
+        static inline std::string tx;
+        static inline std::deque<uint8_t> rx;
+        static inline uint32_t baudrate{0};
+    };
+}
+
+#endif // SIM_UART_HPP
@@ -0,0 +1,252 @@
+#ifndef SIM_VL53L0_MODEL_HPP
+#define SIM_VL53L0_MODEL_HPP
+
+#include <array>
+#include <functional>
+
+#include <modm/driver/position/vl53l0.hpp>
+#include "i2c_bus.hpp"
+
+namespace sim
+{
+    /**
+     * @brief Register model of the VL53L0 ToF sensor.
+     *
+     * Implements what `modm::Vl53l0` relies on: identification, register
+     * pages, the SPAD info handshake, reference calibration, single shot
+     * ranging, soft reset with NACKs while booting and address changes.
+     * Registers without special behaviour simply store what is written.
+     */
+    class Vl53l0Model : public I2cDeviceModel
+    {
+    public:
+        using Register = modm::vl53l0::Register;
+        using RangeErrorCode = modm::vl53l0::RangeErrorCode;
+
+        struct Sample
+        {
+            uint16_t distance;      ///< mm
+            uint16_t signalRate;    ///< MCPS as 9.7 fixed point
+            RangeErrorCode error;
+        };
+
+        /// Transfers answered with NACK after a soft reset
+        static constexpr uint8_t BootNacks = 3;
+
+        explicit Vl53l0Model(uint8_t address = 0x29) : I2cDeviceModel(address)
+        {
+            powerOn();
+        }
+
+        /// Every following measurement returns this sample.
+        void
+        setSample(const Sample &sample)
+        {
+            source = [sample]() { return sample; };
+        }
+
+        /// Measurements take their samples from `source`, e.g. to replay a recording.
+        void
+        setSource(std::function<Sample()> source)
+        {
+            this->source = std::move(source);
+        }
+
+        /// Number of status reads before a measurement completes.
+        void
+        setConversionPolls(uint8_t polls)
+        {
+            conversionPolls = polls;
+        }
+
+        /// @return a register as seen by the driver, for assertions in tests
+        uint8_t
+        peek(uint8_t reg, uint8_t page = 0) const
+        {
+            return registers[page & 0x07][reg];
+        }
+
+        /// Number of finished range measurements
+        uint32_t
+        getMeasurementCount() const
+        {
+            return measurements;
+        }
+
+        bool
+        start(bool read) override
+        {
+            if (booting)
+            {
+                booting--;
+                return false;
+            }
+            addressPhase = not read;
+            return true;
+        }
+
+        bool
+        write(uint8_t data) override
+        {
+            if (addressPhase)
+            {
+                index = data;
+                addressPhase = false;
+            }
+            else {
+                store(index++, data);
+            }
+            return true;
+        }
+
+        uint8_t
+        read() override
+        {
+            return load(index++);
+        }
+
+    private:
+        static constexpr uint8_t
+        reg(Register r)
+        {
+            return uint8_t(r);
+        }
+
+        void
+        powerOn()
+        {
+            for (auto &bank : registers) bank.fill(0);
+            page = 0;
+            inReset = false;
+            measuring = false;
+
+            auto &p0 = registers[0];
+            p0[reg(Register::IDENTIFICATION__MODEL_ID)] = modm::vl53l0::ModelID[0];
+            p0[reg(Register::IDENTIFICATION__MODEL_ID) + 1] = modm::vl53l0::ModelID[1];
+            p0[reg(Register::IDENTIFICATION__REVISION_ID)] = modm::vl53l0::RevisionID;
+            p0[reg(Register::SYSTEM__SEQUENCE_CONFIG)] = 0xFF;
+            p0[reg(Register::PRE_RANGE__CONFIG_VCSEL_PERIOD)] = 0x06;   // 14 PCLKs
+            p0[reg(Register::FINAL_RANGE__CONFIG_VCSEL_PERIOD)] = 0x04; // 10 PCLKs
+            p0[reg(Register::MSRC__CONFIG_TIMEOUT_MACROP)] = 0x0E;
+            p0[reg(Register::PRE_RANGE__CONFIG_TIMEOUT_MACROP_LO)] = 0x40;
+            p0[reg(Register::FINAL_RANGE__CONFIG_TIMEOUT_MACROP_LO)] = 0x80;
+            // reference SPADs available in NVM
+            for (uint8_t ii = 0; ii < 6; ii++) {
+                p0[reg(Register::GLOBAL__CONFIG_SPAD_ENABLES_REF_0) + ii] = 0xFF;
+            }
+
+            registers[1][0x91] = 0x3C;  // stop variable
+            registers[1][0xCB] = 0x1C;  // VHV settings
+            registers[1][0xEE] = 0x01;  // phase calibration
+            registers[7][0x92] = 0x80 | 5;  // 5 aperture reference SPADs
+        }
+
+        void
+        store(uint8_t offset, uint8_t value)
+        {
+            if (offset == 0xFF)
+            {
+                page = value & 0x07;
+                return;
+            }
+            if (page == 7 and offset == 0x83)
+            {
+                // SPAD info handshake, the info is available immediately
+                registers[7][0x83] = (value == 0x00) ? 0x10 : value;
+                return;
+            }
+            if (page != 0)
+            {
+                registers[page][offset] = value;
+                return;
+            }
+
+            switch (Register(offset))
+            {
+                case Register::SYSRANGE__START:
+                    if (value & uint8_t(modm::vl53l0::Start::StartStop))
+                    {
+                        measuring = true;
+                        pollsLeft = conversionPolls;
+                    }
+                    // the StartStop bit is cleared by the sensor
+                    registers[0][offset] = value & ~uint8_t(modm::vl53l0::Start::StartStop);
+                    return;
+                case Register::SYSTEM__INTERRUPT_CLEAR:
+                    registers[0][reg(Register::RESULT__INTERRUPT_STATUS)] = 0;
+                    return;
+                case Register::SOFT_RESET__GO2_SOFT_RESET_N:
+                    if (value == 0x00) {
+                        inReset = true;
+                    }
+                    else if (inReset)
+                    {
+                        powerOn();
+                        booting = BootNacks;
+                    }
+                    return;
+                case Register::I2C_SLAVE__DEVICE_ADDRESS:
+                    this->address = value & 0x7F;
+                    break;
+                default:
+                    break;
+            }
+            registers[0][offset] = value;
+        }
+
+        uint8_t
+        load(uint8_t offset)
+        {
+            if (offset == 0xFF) {
+                return page;
+            }
+            if (page != 0) {
+                return registers[page][offset];
+            }
+            if (inReset and offset == reg(Register::IDENTIFICATION__MODEL_ID)) {
+                return 0x00;
+            }
+            if (measuring and offset == reg(Register::RESULT__INTERRUPT_STATUS))
+            {
+                if (pollsLeft == 0) {
+                    finishMeasurement();
+                } else {
+                    pollsLeft--;
+                }
+            }
+            return registers[0][offset];
+        }
+
+        void
+        finishMeasurement()
+        {
+            measuring = false;
+            measurements++;
+            const Sample sample = source();
+
+            auto &p0 = registers[0];
+            const uint8_t result = reg(Register::RESULT__RANGE_STATUS);
+            p0[result] = (uint8_t(sample.error) << 3) | 0x01;
+            p0[result + 6] = sample.signalRate >> 8;
+            p0[result + 7] = sample.signalRate & 0xFF;
+            p0[result + 10] = sample.distance >> 8;
+            p0[result + 11] = sample.distance & 0xFF;
+            p0[reg(Register::RESULT__INTERRUPT_STATUS)] = uint8_t(modm::vl53l0::InterruptStatus::NewSampleReady);
+        }
+
+        std::array<std::array<uint8_t, 256>, 8> registers;
+        std::function<Sample()> source{[]() { return Sample{500, 2 << 7, RangeErrorCode::RangeComplete}; }};
+
+        uint32_t measurements{0};
+        uint8_t index{0};
+        uint8_t page{0};
+        uint8_t booting{0};
+        uint8_t conversionPolls{2};
+        uint8_t pollsLeft{0};
+        bool addressPhase{false};
+        bool inReset{false};
+        bool measuring{false};
+    };
+}
+
+#endif // SIM_VL53L0_MODEL_HPP
@@ -0,0 +1,260 @@
+#ifndef SOFT_MATH_HPP
+#define SOFT_MATH_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Portable implementations of the CORDIC and FMAC functions.
+ *
+ * `Cordic::` and `Fmac::` have the same interface and use the coprocessors
+ * of the STM32G4 where they exist, these are the fallbacks for other targets
+ * and the reference for tests on the host. Integer only, so the results do
+ * not depend on the compiler or the FPU.
+ *
+ * Angles are Q1.31 fractions of pi, the int32_t range is one turn. Other
+ * CORDIC values are Q1.31, filter samples and coefficients are Q1.15.
+ */
+namespace soft
+{
+    struct SinCos
+    {
+        int32_t sin;
+        int32_t cos;
+    };
+
+    namespace detail
+    {
+        /// atan(2^-i) / pi as Q1.31
+        inline constexpr int32_t Atan[31] = {
+            536870912, 316933406, 167458907, 85004756, 42667331, 21354465, 10679838,
+            5340245, 2670163, 1335087, 667544, 333772, 166886, 83443, 41722, 20861,
+            10430, 5215, 2608, 1304, 652, 326, 163, 81, 41, 20, 10, 5, 3, 1, 1};
+        /// Inverse of the CORDIC gain as Q1.31
+        inline constexpr int64_t Gain = 1304065748;
+
+        constexpr int32_t
+        saturate(int64_t value)
+        {
+            return (value > INT32_MAX) ? INT32_MAX : (value < INT32_MIN) ? INT32_MIN : int32_t(value);
+        }
+
+        constexpr int16_t
+        saturate16(int64_t value)
+        {
+            return (value > INT16_MAX) ? INT16_MAX : (value < INT16_MIN) ? INT16_MIN : int16_t(value);
+        }
+
+        struct Polar
+        {
+            int32_t angle;
+            int32_t modulus;
+        };
+
+        /// CORDIC in vectoring mode, rotates (x, y) onto the x axis.
+        constexpr Polar
+        polar(int32_t x, int32_t y)
+        {
+            int64_t vx = x, vy = y, angle = 0;
+            if (vx < 0)
+            {
+                // rotate by pi into the right half plane
+                angle = (vy >= 0) ? (int64_t(1) << 31) : -(int64_t(1) << 31);
+                vx = -vx;
+                vy = -vy;
+            }
+            for (int ii = 0; ii < 31; ii++)
+            {
+                const int64_t dx = vy >> ii, dy = vx >> ii;
+                if (vy >= 0) {
+                    vx += dx; vy -= dy; angle += Atan[ii];
+                } else {
+                    vx -= dx; vy += dy; angle -= Atan[ii];
+                }
+            }
+            return {int32_t(uint32_t(angle)), saturate((vx * Gain) >> 31)};
+        }
+    }
+
+    constexpr SinCos
+    sincos(int32_t angle)
+    {
+        // the CORDIC converges within [-pi/2, pi/2], the rest is mirrored
+        int64_t rest = angle;
+        bool mirror = false;
+        if (angle > (1 << 30) or angle < -(1 << 30))
+        {
+            rest += (angle > 0) ? -(int64_t(1) << 31) : (int64_t(1) << 31);
+            mirror = true;
+        }
+        int64_t x = detail::Gain, y = 0;
+        for (int ii = 0; ii < 31; ii++)
+        {
+            const int64_t dx = y >> ii, dy = x >> ii;
+            if (rest >= 0) {
+                x -= dx; y += dy; rest -= detail::Atan[ii];
+            } else {
+                x += dx; y -= dy; rest += detail::Atan[ii];
+            }
+        }
+        if (mirror) {
+            x = -x;
+            y = -y;
+        }
+        return {detail::saturate(y), detail::saturate(x)};
+    }
+
+    /// @return the angle of (x, y) as Q1.31 fraction of pi
+    constexpr int32_t
+    atan2(int32_t y, int32_t x)
+    {
+        return detail::polar(x, y).angle;
+    }
+
+    /// @return sqrt(x^2 + y^2), saturated to Q1.31
+    constexpr int32_t
+    hypot(int32_t x, int32_t y)
+    {
+        return detail::polar(x, y).modulus;
+    }
+
+    /// @return the square root of a non-negative Q1.31 value, 0 for negative ones
+    constexpr int32_t
+    sqrt(int32_t x)
+    {
+        if (x <= 0) {
+            return 0;
+        }
+        // sqrt(x / 2^31) * 2^31 = sqrt(x * 2^31), bitwise
+        uint64_t rest = uint64_t(x) << 31;
+        uint64_t root = 0;
+        for (uint64_t bit = uint64_t(1) << 62; bit; bit >>= 2)
+        {
+            if (rest >= root + bit) {
+                rest -= root + bit;
+                root = (root >> 1) + bit;
+            } else {
+                root >>= 1;
+            }
+        }
+        return detail::saturate(root);
+    }
+
+    /**
+     * @brief FIR filter over buffers.
+     *
+     *     y[n] = (sum b[k] x[n-k]) << gain
+     *
+     * saturated to Q1.15. The history is kept between process() calls.
+     */
+    template<size_t Taps>
+    class Fir
+    {
+        static_assert(Taps >= 1);
+
+    public:
+        /// @param gain left shift of the sum, 0 to 7
+        explicit Fir(const std::array<int16_t, Taps> &coefficients, uint8_t gain = 0) :
+            coefficients(coefficients), gain(gain)
+        {
+        }
+
+        void
+        reset()
+        {
+            history.fill(0);
+        }
+
+        /// Filters `length` samples, `input` and `output` may be the same buffer.
+        void
+        process(const int16_t *input, int16_t *output, size_t length)
+        {
+            for (size_t n = 0; n < length; n++)
+            {
+                const int16_t x = input[n];
+                int64_t sum = int32_t(coefficients[0]) * x;
+                for (size_t k = 1; k < Taps; k++) {
+                    sum += int32_t(coefficients[k]) * history[k - 1];
+                }
+                for (size_t k = Taps - 1; k > 1; k--) {
+                    history[k - 1] = history[k - 2];
+                }
+                if constexpr (Taps > 1) history[0] = x;
+                output[n] = detail::saturate16((sum << gain) >> 15);
+            }
+        }
+
+    private:
+        std::array<int16_t, Taps> coefficients;
+        /// x[n-1] first
+        std::array<int16_t, (Taps > 1) ? Taps - 1 : 1> history{};
+        uint8_t gain;
+    };
+
+    /**
+     * @brief IIR filter in direct form 1 over buffers.
+     *
+     *     y[n] = (sum b[k] x[n-k] + sum a[k] y[n-k]) << gain
+     *
+     * with k from 1 for the feedback, saturated to Q1.15. The feedback
+     * coefficients are added like the FMAC does, that is with the opposite
+     * sign of the usual transfer function notation.
+     */
+    template<size_t Feedforward, size_t Feedback>
+    class Iir
+    {
+        static_assert(Feedforward >= 1 and Feedback >= 1);
+
+    public:
+        Iir(const std::array<int16_t, Feedforward> &b, const std::array<int16_t, Feedback> &a,
+            uint8_t gain = 0) :
+            b(b), a(a), gain(gain)
+        {
+        }
+
+        void
+        reset()
+        {
+            inputs.fill(0);
+            outputs.fill(0);
+        }
+
+        void
+        process(const int16_t *input, int16_t *output, size_t length)
+        {
+            for (size_t n = 0; n < length; n++)
+            {
+                const int16_t x = input[n];
+                int64_t sum = int32_t(b[0]) * x;
+                for (size_t k = 1; k < Feedforward; k++) {
+                    sum += int32_t(b[k]) * inputs[k - 1];
+                }
+                for (size_t k = 0; k < Feedback; k++) {
+                    sum += int32_t(a[k]) * outputs[k];
+                }
+                const int16_t y = detail::saturate16((sum << gain) >> 15);
+
+                for (size_t k = Feedforward - 1; k > 1; k--) {
+                    inputs[k - 1] = inputs[k - 2];
+                }
+                if constexpr (Feedforward > 1) inputs[0] = x;
+                for (size_t k = Feedback - 1; k > 0; k--) {
+                    outputs[k] = outputs[k - 1];
+                }
+                outputs[0] = y;
+                output[n] = y;
+            }
+        }
+
+    private:
+        std::array<int16_t, Feedforward> b;
+        std::array<int16_t, Feedback> a;
+        std::array<int16_t, (Feedforward > 1) ? Feedforward - 1 : 1> inputs{};
+        /// y[n-1] first
+        std::array<int16_t, Feedback> outputs{};
+        uint8_t gain;
+    };
+}
+
+#endif // SOFT_MATH_HPP
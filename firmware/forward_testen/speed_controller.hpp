@@ -0,0 +1,142 @@
+#ifndef SPEED_CONTROLLER_HPP
+#define SPEED_CONTROLLER_HPP
+
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * @brief Fixed-point PI speed controller with feed-forward and anti-windup.
+ *
+ * Works on signed speeds and produces a signed duty cycle as Q15, where
+ * 32767 is full speed forward. The output is the sum of
+ *  - a feed-forward term proportional to the setpoint, scaled with the
+ *    supply voltage so that battery sag does not change the open-loop speed,
+ *  - the proportional term on the speed error,
+ *  - the integral of the error.
+ *
+ * The integral is only accumulated while the output is not saturated in the
+ * direction of the error (conditional integration) and is clamped to the
+ * output range, so it recovers immediately after a stall.
+ *
+ * Gains are Q16.16 in duty units (1/32768) per speed unit, the integral gain
+ * already includes the sample time.
+ */
+class SpeedController
+{
+public:
+    struct Parameters
+    {
+        int32_t kp = 2 << 16;
+        int32_t ki = 1 << 14;
+        /// Duty per speed unit at the nominal supply voltage
+        int32_t kff = 5 << 16;
+        /// Largest duty cycle as Q15
+        int16_t limit = 32767;
+        /// Supply voltage the feed-forward gain was measured at
+        uint16_t nominalSupply = 12000; // mV
+    };
+
+    SpeedController() = default;
+
+    explicit SpeedController(const Parameters &parameters) :
+        parameters(parameters)
+    {
+    }
+
+    void
+    reset()
+    {
+        integral = 0;
+        output = 0;
+    }
+
+    void
+    setParameters(const Parameters &parameters)
+    {
+        this->parameters = parameters;
+        supplyScale = 1 << 16;
+        reset();
+    }
+
+    /// Measured supply voltage in mV, ignored if 0.
+    void
+    setSupplyVoltage(uint16_t millivolt)
+    {
+        if (millivolt) {
+            supplyScale = (uint32_t(parameters.nominalSupply) << 16) / millivolt;
+        }
+    }
+
+    /**
+     * @brief Computes the next duty cycle.
+     *
+     * @param setpoint  commanded speed
+     * @param measured  measured speed, same unit and sign convention
+     * @return the duty cycle as Q15
+     */
+    int16_t
+    update(int32_t setpoint, int32_t measured)
+    {
+        return update(setpoint, measured, -parameters.limit, parameters.limit);
+    }
+
+    /**
+     * @brief Computes the next duty cycle within narrower bounds.
+     *
+     * The integral treats the bounds like the limit, e.g. `minimum = 0`
+     * while the wheel must not be driven backwards.
+     */
+    int16_t
+    update(int32_t setpoint, int32_t measured, int16_t minimum, int16_t maximum)
+    {
+        const int32_t limit = int32_t(parameters.limit) << 16;
+        const int32_t lower = std::max(int32_t(minimum) << 16, -limit);
+        const int32_t upper = std::min(int32_t(maximum) << 16, limit);
+        const int32_t error = setpoint - measured;
+
+        const int64_t feedForward = ((int64_t(parameters.kff) * setpoint) * supplyScale) >> 16;
+
+        const int64_t unsaturated = feedForward + int64_t(parameters.kp) * error + integral;
+        const bool saturatedHigh = unsaturated >= upper;
+        const bool saturatedLow = unsaturated <= lower;
+
+        if (not (saturatedHigh and error > 0) and not (saturatedLow and error < 0)) {
+            integral = clamp(integral + int64_t(parameters.ki) * error, limit);
+        }
+
+        const int64_t sum = feedForward + int64_t(parameters.kp) * error + integral;
+        output = int16_t(std::clamp<int64_t>(sum, lower, upper) >> 16);
+        return output;
+    }
+
+    /// @return the last duty cycle as Q15
+    int16_t
+    getOutput() const
+    {
+        return output;
+    }
+
+    /// @return the integral term as Q15
+    int16_t
+    getIntegral() const
+    {
+        return int16_t(integral >> 16);
+    }
+
+private:
+    static int32_t
+    clamp(int64_t value, int32_t limit)
+    {
+        if (value > limit) return limit;
+        if (value < -limit) return -limit;
+        return int32_t(value);
+    }
+
+    Parameters parameters{};
+    uint32_t supplyScale{1 << 16};  ///< nominal / actual supply as Q16.16
+
+    int32_t integral{0};    ///< Q15 duty as Q16.16
+    int16_t output{0};
+};
+
+#endif // SPEED_CONTROLLER_HPP
@@ -0,0 +1,39 @@
+#ifndef TEST_BENCHMARK_HPP
+#define TEST_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdio>
+
+/**
+ * @brief Cost per call on the host.
+ *
+ * Host numbers only compare implementations with each other, the cycles on
+ * the target come from the DWT counter of the control executive ("ce").
+ */
+namespace test
+{
+    /// Volatile sink, keeps the compiler from removing the benchmarked code
+    template<class T>
+    inline void
+    keep(const T &value)
+    {
+        asm volatile("" : : "g"(&value) : "memory");
+    }
+
+    /// Calls `function(index)` `calls` times and prints the mean time per call in ns.
+    template<class Function>
+    inline double
+    benchmark(const char *name, unsigned calls, Function &&function)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (unsigned ii = 0; ii < calls; ii++) {
+            function(ii);
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        const double perCall = elapsed.count() / calls;
+        std::printf("%-32s %9.1f ns/call\n", name, perCall);
+        return perCall;
+    }
+}
+
+#endif // TEST_BENCHMARK_HPP
@@ -0,0 +1,40 @@
+#ifndef TEST_CHECK_HPP
+#define TEST_CHECK_HPP
+
+#include <cstdio>
+
+/**
+ * @brief Minimal assertions for the host tests.
+ *
+ * A failed check prints its location and the test continues, main() returns
+ * test::result() so ctest sees the failure.
+ */
+namespace test
+{
+    inline int failures{0};
+
+    inline bool
+    check(bool condition, const char *expression, const char *file, int line)
+    {
+        if (not condition)
+        {
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+            failures++;
+        }
+        return condition;
+    }
+
+    /// @return the exit code of the test
+    inline int
+    result()
+    {
+        if (failures) {
+            std::fprintf(stderr, "%d check(s) failed\n", failures);
+        }
+        return failures ? 1 : 0;
+    }
+}
+
+#define CHECK(condition) ::test::check(bool(condition), #condition, __FILE__, __LINE__)
+
+#endif // TEST_CHECK_HPP
@@ -0,0 +1,105 @@
+#ifndef TEST_CLOSED_LOOP_HPP
+#define TEST_CLOSED_LOOP_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "differential_odometry.hpp"
+#include "motion_profile.hpp"
+#include "motor_control.hpp"
+#include "soft_math.hpp"
+#include "speed_controller.hpp"
+#include "sim/robot_model.hpp"
+
+namespace test
+{
+    /**
+     * @brief Wheel speed control and odometry around a sim::RobotModel.
+     *
+     * Stands in for MotorControl in the behavior scenarios: every 1 ms tick
+     * the setpoints pass a MotionProfile and a SpeedController per wheel,
+     * with the limits of MotorControl. The speeds are measured exactly and
+     * the signed tacho edges feed the odometry with the geometry of
+     * Odometry::Geometry.
+     */
+    class ClosedLoop
+    {
+    public:
+        using Odometry = DifferentialOdometry<soft::sincos>;
+        static constexpr std::chrono::milliseconds Period{1};
+
+        explicit ClosedLoop(sim::RobotModel &robot) :
+            robot(robot), odometry({51'050, 120'000})
+        {
+            const auto &pose = robot.getPose();
+            odometry.reset({int32_t(pose.x * 1e6), int32_t(pose.y * 1e6),
+                            int32_t(std::clamp(pose.heading / Pi, -1.0, 1.0 - 1e-9) * 2147483648.0)});
+        }
+
+        /// Wheel speed setpoints in rpm
+        void
+        setSpeed(int32_t left, int32_t right)
+        {
+            profiles[0].setTarget(left);
+            profiles[1].setTarget(right);
+        }
+
+        /// Advances the simulation by one control period.
+        void
+        tick()
+        {
+            int16_t duty[2];
+            for (int wheel = 0; wheel < 2; wheel++) {
+                duty[wheel] = controllers[wheel].update(profiles[wheel].update(), getSpeed(wheel));
+            }
+            const uint32_t before[2] = {robot.left().getEdgeCount(), robot.right().getEdgeCount()};
+            for (auto time = Step; time <= Period; time += Step) {
+                robot.step(duty[0], duty[1], Step);
+            }
+            int32_t edges[2];
+            for (int wheel = 0; wheel < 2; wheel++)
+            {
+                edges[wheel] = int32_t(motor(wheel).getEdgeCount() - before[wheel]);
+                if (motor(wheel).getSpeed() < 0) edges[wheel] = -edges[wheel];
+            }
+            odometry.update(edges[0], edges[1]);
+        }
+
+        /// @return the measured wheel speed in rpm
+        int32_t
+        getSpeed(int wheel)
+        {
+            return int32_t(std::lround(motor(wheel).getSpeed()));
+        }
+
+        Odometry::Pose
+        getPose() const
+        {
+            return odometry.getPose();
+        }
+
+        sim::RobotModel &robot;
+
+    private:
+        static constexpr double Pi = 3.14159265358979323846;
+        /// Integration step of the model, the duty cycle holds for the whole period
+        static constexpr std::chrono::microseconds Step{50};
+
+        sim::MotorModel &
+        motor(int wheel)
+        {
+            return wheel ? robot.right() : robot.left();
+        }
+
+        static constexpr MotionProfile::Parameters Limits{
+                .acceleration = MotorControl::Acceleration, .jerk = MotorControl::Jerk,
+                .frequency = MotorControl::ControlFrequency};
+
+        MotionProfile profiles[2]{MotionProfile(Limits), MotionProfile(Limits)};
+        SpeedController controllers[2];
+        Odometry odometry;
+    };
+}
+
+#endif // TEST_CLOSED_LOOP_HPP
@@ -0,0 +1,145 @@
+// GenericDeadlineTimer on a fake clock: both policies for missed deadlines,
+// the statistics and the wrap of a 16-bit timestamp
+
+#include <chrono>
+#include <cstdint>
+
+#include "check.hpp"
+#include <modm/processing/timer/periodic_timer.hpp>
+
+using namespace std::chrono_literals;
+
+/// Milliseconds set by the test, 32-bit like modm::Clock
+struct FakeClock
+{
+    using duration = std::chrono::duration<uint32_t, std::milli>;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<FakeClock, duration>;
+    static constexpr bool is_steady = true;
+
+    static inline uint32_t time{0};
+
+    static time_point
+    now()
+    {
+        return time_point{duration{time}};
+    }
+};
+
+/// Like modm::ShortDeadlineTimer, 16-bit timestamps which wrap every 65.536 s
+using ShortTimer = modm::GenericDeadlineTimer<FakeClock, std::chrono::duration<uint16_t, std::milli>>;
+using Timer = modm::GenericDeadlineTimer<FakeClock, FakeClock::duration>;
+using modm::MissedPeriods;
+
+/// Skip and CatchUp from `start` on, the same for every timestamp width
+template<class Timer>
+void
+policies(uint32_t start)
+{
+    // Skip: one expiration for several deadlines, the later ones keep their phase
+    {
+        FakeClock::time = start;
+        Timer timer(10ms);
+        FakeClock::time = start + 9;
+        CHECK(timer.execute() == 0);
+        FakeClock::time = start + 10;
+        CHECK(timer.execute() == 1);
+        CHECK(timer.execute() == 0);
+        FakeClock::time = start + 35;
+        CHECK(timer.execute() == 2);
+        CHECK(timer.execute() == 0);
+        FakeClock::time = start + 39;
+        CHECK(timer.execute() == 0);
+        FakeClock::time = start + 40;
+        CHECK(timer.execute() == 1);
+
+        const auto &statistics = timer.statistics();
+        CHECK(statistics.expirations == 3);
+        CHECK(statistics.missed == 1);
+        CHECK(statistics.minimum == 0ms);
+        CHECK(statistics.maximum == 5ms);
+        CHECK(statistics.mean() == 1ms);
+    }
+
+    // CatchUp: every deadline once, back to back, the late ones count as missed
+    {
+        FakeClock::time = start;
+        Timer timer(10ms, MissedPeriods::CatchUp);
+        FakeClock::time = start + 35;
+        CHECK(timer.execute() == 1);    // deadline 10, the one at 20 passed too
+        CHECK(timer.execute() == 1);    // deadline 20, the one at 30 passed too
+        CHECK(timer.execute() == 1);    // deadline 30, in time for 40
+        CHECK(timer.execute() == 0);
+        FakeClock::time = start + 40;
+        CHECK(timer.execute() == 1);
+
+        const auto &statistics = timer.statistics();
+        CHECK(statistics.expirations == 4);
+        CHECK(statistics.missed == 2);
+        CHECK(statistics.minimum == 0ms);
+        CHECK(statistics.maximum == 25ms);
+        CHECK(statistics.mean() == 11ms);
+
+        // served just as the next one is due counts as missed
+        FakeClock::time = start + 60;
+        CHECK(timer.execute() == 1);
+        CHECK(timer.statistics().missed == 3);
+        CHECK(timer.execute() == 1);
+        CHECK(timer.statistics().missed == 3);
+        CHECK(timer.execute() == 0);
+
+        // a restart starts a new phase and keeps the statistics
+        FakeClock::time = start + 63;
+        timer.restart();
+        FakeClock::time = start + 70;
+        CHECK(timer.execute() == 0);
+        FakeClock::time = start + 73;
+        CHECK(timer.execute() == 1);
+        CHECK(timer.statistics().expirations == 7);
+        timer.resetStatistics();
+        CHECK(timer.statistics().expirations == 0);
+        CHECK(timer.statistics().mean() == 0ms);
+    }
+}
+
+int
+main()
+{
+    policies<Timer>(1000);
+    policies<ShortTimer>(1000);
+    // the same across the wrap of the 16-bit timestamps, and of the clock itself
+    policies<ShortTimer>(65'530);
+    policies<Timer>(UINT32_MAX - 20);
+
+    // polled every millisecond over three wraps of the 16-bit timestamps: each
+    // deadline on time, none missed
+    for (const MissedPeriods policy : {MissedPeriods::Skip, MissedPeriods::CatchUp})
+    {
+        FakeClock::time = 65'000;
+        ShortTimer timer(7ms, policy);
+        uint32_t expirations = 0;
+        bool punctual = true;
+        for (uint32_t tick = 1; tick <= 3 * 65'536; tick++)
+        {
+            FakeClock::time++;
+            const size_t count = timer.execute();
+            expirations += count;
+            punctual &= (count == (tick % 7 == 0));
+        }
+        CHECK(punctual);
+        CHECK(expirations == 3 * 65'536 / 7);
+        CHECK(timer.statistics().missed == 0);
+        CHECK(timer.statistics().maximum == 0ms);
+    }
+
+    // an interval of zero expires at every poll
+    {
+        Timer timer(0ms);
+        CHECK(timer.execute() == 1);
+        CHECK(timer.execute() == 1);
+        CHECK(timer.statistics().missed == 0);
+    }
+
+    return test::result();
+}
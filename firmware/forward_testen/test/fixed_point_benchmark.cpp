@@ -0,0 +1,56 @@
+// modm::FixedPoint against float for the control and filter kernels
+
+#include "benchmark.hpp"
+
+#include <modm/math/fixed_point.hpp>
+
+#include <algorithm>
+
+using modm::Q15;
+using modm::Q16_16;
+
+int
+main()
+{
+    // 32 tap FIR
+    int16_t samples[32], taps[32];
+    float samplesFloat[32], tapsFloat[32];
+    for (int index = 0; index < 32; index++)
+    {
+        samples[index] = int16_t(index * 997);
+        taps[index] = int16_t(1024 - index * 31);
+        samplesFloat[index] = samples[index] / 32768.f;
+        tapsFloat[index] = taps[index] / 32768.f;
+    }
+    test::benchmark("fir 32 taps Q15", 1'000'000, [&](unsigned index)
+    {
+        samples[index % 32] ^= 1;
+        test::keep(modm::fixed_point::dot(samples, taps, 32));
+    });
+    test::benchmark("fir 32 taps float", 1'000'000, [&](unsigned index)
+    {
+        samplesFloat[index % 32] += 1e-6f;
+        float sum = 0;
+        for (int tap = 0; tap < 32; tap++) {
+            sum += samplesFloat[tap] * tapsFloat[tap];
+        }
+        test::keep(sum);
+    });
+
+    // PI controller step with anti-windup, like the wheel speed control
+    Q16_16 integral{}, kp = 0.8, ki = 0.05;
+    test::benchmark("pi step Q16.16", 1'000'000, [&](unsigned index)
+    {
+        const Q16_16 error = Q16_16::fromRatio(int32_t(index % 200) - 100, 100);
+        integral = std::clamp(integral + error * ki, Q16_16(-1.0), Q16_16(1.0));
+        test::keep(Q15(error * kp + integral));
+    });
+    float integralFloat = 0, kpFloat = 0.8f, kiFloat = 0.05f;
+    test::benchmark("pi step float", 1'000'000, [&](unsigned index)
+    {
+        const float error = (int32_t(index % 200) - 100) / 100.f;
+        integralFloat = std::clamp(integralFloat + error * kiFloat, -1.f, 1.f);
+        test::keep(std::clamp(error * kpFloat + integralFloat, -1.f, 1.f));
+    });
+    return 0;
+}
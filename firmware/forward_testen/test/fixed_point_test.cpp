@@ -0,0 +1,115 @@
+// modm::FixedPoint against double arithmetic
+
+#include "check.hpp"
+
+#include <modm/math/fixed_point.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using modm::Q15;
+using modm::Q31;
+using modm::Q16_16;
+namespace fixed_point = modm::fixed_point;
+
+// compile-time conversion and saturation
+static_assert(Q15(0.5).raw() == 16384);
+static_assert(Q15(1.0).raw() == 32767);
+static_assert(Q15(-1.0).raw() == -32768);
+static_assert((Q15(0.75) + Q15(0.75)) == Q15::max());
+static_assert((Q15(-0.75) - Q15(0.75)) == Q15::min());
+static_assert((Q15(0.5) * Q15(0.5)) == Q15(0.25));
+static_assert((Q31(0.5) * Q15(-0.5)) == Q31(-0.25));
+static_assert((Q15(0.25) / Q15(0.5)) == Q15(0.5));
+static_assert((Q15(0.25) / Q15()) == Q15::max());
+static_assert(-Q15::min() == Q15::max());
+static_assert(Q16_16(Q15(0.5)).raw() == 32768);
+static_assert(Q15(Q16_16(3.0)) == Q15::max());
+static_assert(Q15(Q31(0.5)).raw() == 16384);
+static_assert(Q15(0.5).scale(uint16_t(4250)) == 2125);
+static_assert(Q15::fromRatio(1, 3).raw() == 10923);
+static_assert(Q16_16::fromInteger(-3).integer() == -3);
+static_assert(fixed_point::smlad(0x00020003u, 0x00040005u, 1) == 1 + 15 + 8);
+static_assert(fixed_point::saturate<16>(40000) == 32767);
+
+/// @return the raw value of `Q` closest to `value`, saturated
+template<class Q>
+int64_t
+expected(double value)
+{
+    using T = typename Q::Storage;
+    const double raw = std::round(value * double(int64_t(1) << Q::FractionalBits));
+    return int64_t(std::clamp(raw, double(std::numeric_limits<T>::min()), double(std::numeric_limits<T>::max())));
+}
+
+/// Deterministic values covering the whole range of `Q`, including both ends
+template<class Q>
+std::vector<Q>
+values()
+{
+    using T = typename Q::Storage;
+    std::vector<Q> result{Q::min(), Q::max(), Q::fromRaw(0), Q::fromRaw(1), Q::fromRaw(-1)};
+    uint32_t seed = 1;
+    for (int index = 0; index < 200; index++)
+    {
+        seed = seed * 1664525 + 1013904223;
+        result.push_back(Q::fromRaw(T(int64_t(int32_t(seed)) >> (32 - sizeof(T) * 8))));
+    }
+    return result;
+}
+
+/// Checks all binary operations of `Q` against double, returns the largest error in LSB
+template<class Q>
+int64_t
+compare()
+{
+    int64_t worst = 0;
+    const auto operands = values<Q>();
+    for (Q a : operands)
+    {
+        for (Q b : operands)
+        {
+            const double x = a.raw() / double(int64_t(1) << Q::FractionalBits);
+            const double y = b.raw() / double(int64_t(1) << Q::FractionalBits);
+            worst = std::max(worst, std::abs((a + b).raw() - expected<Q>(x + y)));
+            worst = std::max(worst, std::abs((a - b).raw() - expected<Q>(x - y)));
+            worst = std::max(worst, std::abs((a * b).raw() - expected<Q>(x * y)));
+            if (b.raw() != 0) {
+                worst = std::max(worst, std::abs((a / b).raw() - expected<Q>(x / y)));
+            }
+        }
+    }
+    return worst;
+}
+
+int
+main()
+{
+    // sums and differences are exact, products and quotients round to the nearest LSB
+    const int64_t q15 = compare<Q15>(), q31 = compare<Q31>(), q16 = compare<Q16_16>();
+    std::printf("largest error: Q15 %lld, Q31 %lld, Q16.16 %lld LSB\n", (long long) q15, (long long) q31, (long long) q16);
+    CHECK(q15 <= 1);
+    CHECK(q31 <= 1);
+    CHECK(q16 <= 1);
+
+    // float conversions round trip
+    for (float value : {0.f, 0.3f, -0.3f, 0.99f, -1.f}) {
+        CHECK(std::abs(Q31::fromFloat(value).toFloat() - value) < 1e-7f);
+        CHECK(std::abs(Q15::fromFloat(value).toFloat() - value) <= 1.f / 32768);
+    }
+
+    // dot products are exact with Q30 results
+    int16_t a[33], b[33];
+    int64_t reference = 0;
+    for (int index = 0; index < 33; index++)
+    {
+        a[index] = int16_t(index * 1993 - 32768);
+        b[index] = int16_t(32767 - index * 2011);
+        reference += int64_t(a[index]) * b[index];
+    }
+    CHECK(fixed_point::dot(a, b, 33) == reference);
+    CHECK(fixed_point::dot(a, b, 0) == 0);
+
+    return test::result();
+}
@@ -0,0 +1,92 @@
+// Host stand-in for control_executive.cpp
+//
+// The stages run from SimBoard::MotorTimer3::update, which World::run() calls
+// at every timer update like the interrupt of the target. The simulated time
+// stands still while they run, so there are no cycles to count, no overruns
+// and no jitter: the statistics only count the iterations.
+
+#include "control_executive.hpp"
+
+#include <limits>
+
+using namespace Board;
+
+namespace
+{
+    struct StageTasks
+    {
+        ControlExecutive::Task tasks[ControlExecutive::MaxTasks]{};
+        uint8_t count{0};
+    };
+
+    StageTasks stages[ControlExecutive::Stages];
+    uint16_t divider{1};
+    uint16_t ticks{0};
+    uint32_t frequency{0};
+    uint32_t period{0};
+    ControlExecutive::Statistics statistics{};
+
+    void
+    update()
+    {
+        if (++ticks < divider) {
+            return;
+        }
+        ticks = 0;
+        for (const StageTasks &stage : stages)
+        {
+            for (size_t ii = 0; ii < stage.count; ii++) {
+                stage.tasks[ii]();
+            }
+        }
+        statistics.iterations++;
+    }
+}
+
+void
+ControlExecutive::detail::initialize(uint16_t divider, uint32_t frequency)
+{
+    ::divider = divider;
+    ::frequency = frequency;
+    period = SystemClock::Frequency / frequency;
+    ticks = 0;
+    resetStatistics();
+    MotorTimer3::update = ::update;
+}
+
+bool
+ControlExecutive::add(Stage stage, Task task)
+{
+    StageTasks &tasks = stages[uint8_t(stage)];
+    if (tasks.count >= MaxTasks) {
+        return false;
+    }
+    tasks.tasks[tasks.count++] = task;
+    return true;
+}
+
+uint32_t
+ControlExecutive::getFrequency()
+{
+    return frequency;
+}
+
+uint32_t
+ControlExecutive::getPeriod()
+{
+    return period;
+}
+
+ControlExecutive::Statistics
+ControlExecutive::getStatistics()
+{
+    return statistics;
+}
+
+void
+ControlExecutive::resetStatistics()
+{
+    statistics = {};
+    statistics.minJitter = std::numeric_limits<int32_t>::max();
+    statistics.maxJitter = std::numeric_limits<int32_t>::min();
+}
@@ -0,0 +1,97 @@
+// Host stand-in for fault_monitor.cpp
+//
+// There are no EXTI interrupts on the host. The nFAULT inputs are sampled
+// by a task in the sense stage of the ControlExecutive instead, so a fault
+// shuts the motors down within one control period, in the same order as on
+// the target. The self test has no interrupt to measure.
+
+#include "fault_monitor.hpp"
+#include "hardware.hpp"
+#include "motor_control.hpp"
+#include "control_executive.hpp"
+
+#include <modm/processing/fiber.hpp>
+
+using namespace Board;
+
+namespace
+{
+    bool latched{false};
+    FaultMonitor::Fault fault{};
+    FaultMonitor::Statistics statistics{};
+
+    uint8_t
+    readSources()
+    {
+        return (M1_Fault::read() ? 0 : FaultMonitor::Motor1) |
+               (M2_Fault::read() ? 0 : FaultMonitor::Motor2);
+    }
+
+    void
+    sample()
+    {
+        const uint8_t sources = readSources();
+        if (not sources or latched) {
+            return;
+        }
+        MotorPwm::forceInactive();
+        M1_Sleep::reset();
+        M2_Sleep::reset();
+        MotorControl::disable();
+        fault = {sources, modm::Clock::now(), 0};
+        latched = true;
+    }
+}
+
+void
+FaultMonitor::initialize()
+{
+    ControlExecutive::add(ControlExecutive::Stage::Sense, sample);
+    sample();
+}
+
+bool
+FaultMonitor::isLatched()
+{
+    return latched;
+}
+
+FaultMonitor::Fault
+FaultMonitor::getFault()
+{
+    return fault;
+}
+
+bool
+FaultMonitor::clear()
+{
+    if (readSources()) {
+        return false;
+    }
+    latched = false;
+    fault = Fault();
+    MotorPwm::setCompare(0, 0);
+    MotorPwm::release();
+    return true;
+}
+
+void
+FaultMonitor::wait()
+{
+    while (not latched) {
+        modm::this_fiber::suspend();
+    }
+}
+
+uint32_t
+FaultMonitor::selfTest()
+{
+    statistics.selfTests++;
+    return 0;
+}
+
+FaultMonitor::Statistics
+FaultMonitor::getStatistics()
+{
+    return statistics;
+}
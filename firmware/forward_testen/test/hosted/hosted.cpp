@@ -0,0 +1,92 @@
+#include <chrono>
+#include <cstdio>
+
+#include <modm/architecture/interface/clock.hpp>
+#include <modm/debug/logger.hpp>
+#include <modm/processing/fiber.hpp>
+
+// Fibers: everything runs on the calling thread, see hosted/modm/processing/fiber.hpp
+
+void
+modm::fiber::resume(modm::fiber::id)
+{
+}
+
+void
+modm::this_fiber::yield()
+{
+}
+
+modm::fiber::id
+modm::this_fiber::get_id()
+{
+    return 0;
+}
+
+void
+modm::this_fiber::suspend()
+{
+}
+
+void
+modm::this_fiber::suspend_for(std::chrono::milliseconds)
+{
+}
+
+// Clocks: the wrapping 32-bit modm clocks derived from the host's steady clock
+
+namespace
+{
+    auto
+    elapsed()
+    {
+        static const auto start = std::chrono::steady_clock::now();
+        return std::chrono::steady_clock::now() - start;
+    }
+}
+
+modm::chrono::milli_clock::time_point
+modm::chrono::milli_clock::now() noexcept
+{
+    return time_point{duration{uint32_t(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed()).count())}};
+}
+
+modm::chrono::micro_clock::time_point
+modm::chrono::micro_clock::now() noexcept
+{
+    return time_point{duration{uint32_t(std::chrono::duration_cast<std::chrono::microseconds>(elapsed()).count())}};
+}
+
+// Logger: the firmware logs to the debug UART, host tests to stderr
+
+namespace
+{
+    class Terminal : public modm::IODevice
+    {
+    public:
+        void
+        write(char c) override
+        {
+            std::fputc(c, stderr);
+        }
+
+        void
+        flush() override
+        {
+            std::fflush(stderr);
+        }
+
+        bool
+        read(char &) override
+        {
+            return false;
+        }
+    };
+
+    Terminal terminal;
+}
+
+modm::log::Logger modm::log::debug(terminal);
+modm::log::Logger modm::log::info(terminal);
+modm::log::Logger modm::log::warning(terminal);
+modm::log::Logger modm::log::error(terminal);
@@ -0,0 +1,109 @@
+#ifndef HOSTED_MODM_IO_IOSTREAM_HPP
+#define HOSTED_MODM_IO_IOSTREAM_HPP
+
+#include <charconv>
+#include <concepts>
+#include <cstdio>
+#include <string_view>
+
+#include <modm/io/iodevice.hpp>
+
+/**
+ * Hosted replacement of `modm::IOStream`.
+ *
+ * The generated stream only has the integer overloads of 32-bit ARM, where
+ * `int32_t` is `long`, and does not compile on a 64-bit host. This stream
+ * covers what drivers and the logger use: text, integers and floats.
+ */
+namespace modm
+{
+    class IOStream
+    {
+    public:
+        IOStream(IODevice &device) : device(&device) {}
+        IOStream(const IOStream &) = delete;
+
+        IOStream &
+        flush()
+        {
+            device->flush();
+            return *this;
+        }
+
+        IOStream &
+        endl()
+        {
+            device->write('\n');
+            return flush();
+        }
+
+        IOStream &
+        operator << (IOStream &(*format)(IOStream &))
+        {
+            return format(*this);
+        }
+
+        IOStream &
+        operator << (char c)
+        {
+            device->write(c);
+            return *this;
+        }
+
+        IOStream &
+        operator << (const char *s)
+        {
+            device->write(s);
+            return *this;
+        }
+
+        IOStream &
+        operator << (std::string_view sv)
+        {
+            for (char c : sv) device->write(c);
+            return *this;
+        }
+
+        IOStream &
+        operator << (bool b)
+        {
+            return *this << (b ? "true" : "false");
+        }
+
+        /// Integers are printed as numbers, including `uint8_t`.
+        template<std::integral T>
+        IOStream &
+        operator << (T value)
+        {
+            char buffer[24];
+            const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            return *this << std::string_view(buffer, result.ptr);
+        }
+
+        template<std::floating_point T>
+        IOStream &
+        operator << (T value)
+        {
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%g", double(value));
+            return *this << buffer;
+        }
+
+    private:
+        IODevice *device;
+    };
+
+    inline IOStream &
+    flush(IOStream &ios)
+    {
+        return ios.flush();
+    }
+
+    inline IOStream &
+    endl(IOStream &ios)
+    {
+        return ios.endl();
+    }
+}
+
+#endif // HOSTED_MODM_IO_IOSTREAM_HPP
@@ -0,0 +1,12 @@
+#ifndef HOSTED_MODM_PLATFORM_HPP
+#define HOSTED_MODM_PLATFORM_HPP
+
+/**
+ * Hosted replacement of the generated platform header.
+ *
+ * The host has none of the STM32G474 peripherals, so the device macros like
+ * CORDIC and FMAC stay undefined and the firmware modules which check them
+ * use their software fallbacks. Pins and timers come from the SimBoard.
+ */
+
+#endif // HOSTED_MODM_PLATFORM_HPP
@@ -0,0 +1,36 @@
+#ifndef HOSTED_MODM_PLATFORM_CORE_ATOMIC_LOCK_IMPL_HPP
+#define HOSTED_MODM_PLATFORM_CORE_ATOMIC_LOCK_IMPL_HPP
+
+#include <cstdint>
+
+/**
+ * Hosted replacement of the Cortex-M interrupt locks.
+ *
+ * The simulated interrupts run on the calling thread from SimBoard::World,
+ * never in the middle of a locked section, so the locks have nothing to do.
+ */
+namespace modm::atomic
+{
+    class Lock
+    {
+    public:
+        Lock() {}
+        ~Lock() {}
+    };
+
+    class Unlock
+    {
+    public:
+        Unlock() {}
+        ~Unlock() {}
+    };
+
+    class LockPriority
+    {
+    public:
+        explicit LockPriority(uint32_t) {}
+        ~LockPriority() {}
+    };
+}
+
+#endif // HOSTED_MODM_PLATFORM_CORE_ATOMIC_LOCK_IMPL_HPP
@@ -0,0 +1,15 @@
+#ifndef HOSTED_MODM_PROCESSING_FIBER_HPP
+#define HOSTED_MODM_PROCESSING_FIBER_HPP
+
+/**
+ * Hosted replacement of the modm fiber module.
+ *
+ * The generated modm library only contains the Cortex-M context switch, so
+ * host tests run everything on the calling thread: there is no scheduler,
+ * yield() and suspend() return immediately like they do outside of a fiber
+ * on the target. The simulated peripherals finish their transfers before
+ * the driver starts waiting, so nothing is lost by not switching.
+ */
+#include <modm/architecture/interface/fiber.hpp>
+
+#endif // HOSTED_MODM_PROCESSING_FIBER_HPP
@@ -0,0 +1,88 @@
+// Bus statistics and recovery of the I2C master with faults injected into the bus
+
+#include "check.hpp"
+#include "sim/i2c_master.hpp"
+#include "sim/vl53l0_model.hpp"
+
+using Master = sim::I2cMaster<>;
+using Fault = sim::I2cBus::Fault;
+using Error = modm::I2cMaster::Error;
+
+int
+main()
+{
+    sim::I2cBus bus;
+    sim::Vl53l0Model model;
+    bus.attach(model);
+    Master::connect(bus);
+
+    modm::vl53l0::Data data;
+    modm::Vl53l0<Master> sensor(data);
+    CHECK(sensor.initialize());
+    Master::resetStatistics();
+
+    // every fault fails one transaction, is counted and the next one works again
+    struct Case
+    {
+        Fault fault;
+        Error error;
+        uint32_t Master::Statistics::*counter;
+    };
+    const Case cases[] =
+    {
+        {Fault::AddressNack, Error::AddressNack, &Master::Statistics::addressNacks},
+        {Fault::DataNack, Error::DataNack, &Master::Statistics::dataNacks},
+        {Fault::ArbitrationLost, Error::ArbitrationLost, &Master::Statistics::arbitrationLosses},
+        {Fault::BusError, Error::BusCondition, &Master::Statistics::busErrors},
+    };
+    for (const Case &test : cases)
+    {
+        const uint32_t before = Master::getStatistics().*test.counter;
+        bus.injectFault(test.fault);
+        CHECK(not sensor.ping());
+        CHECK(Master::getErrorState() == test.error);
+        CHECK(Master::getStatistics().*test.counter == before + 1);
+        CHECK(sensor.ping());
+    }
+
+    // a fault in the middle of a measurement only fails that measurement
+    bus.injectFault(Fault::DataNack, 3);
+    CHECK(not sensor.readDistance());
+    CHECK(sensor.readDistance());
+    CHECK(data.isValid());
+
+    // a stuck bus fails every transaction until it is recovered
+    bus.injectFault(Fault::StuckBus);
+    CHECK(not sensor.ping());
+    CHECK(bus.isStuck());
+    CHECK(not sensor.ping());
+    CHECK(Master::getErrorState() == Error::BusBusy);
+    const uint32_t timeouts = Master::getStatistics().timeouts;
+    CHECK(Master::supervise());
+    CHECK(not bus.isStuck());
+    CHECK(Master::getStatistics().recoveries == 1);
+    CHECK(Master::getStatistics().timeouts == timeouts + 1);
+    CHECK(not Master::supervise());
+    CHECK(sensor.readDistance());
+    CHECK(data.isValid());
+
+    // nine clocks and a stop take 25 us at 400 kHz
+    const auto before = bus.now();
+    Master::recover();
+    CHECK(bus.now() - before == std::chrono::microseconds(25));
+
+    // every transaction has a latency, the ping at 400 kHz takes less than 64 us
+    const auto &statistics = Master::getStatistics();
+    uint32_t latencies = 0;
+    for (uint32_t count : statistics.latency) {
+        latencies += count;
+    }
+    CHECK(latencies == statistics.transactions);
+    CHECK(statistics.latency[0] > 0);
+
+    Master::resetStatistics();
+    CHECK(Master::getStatistics().transactions == 0);
+    CHECK(Master::getStatistics().recoveries == 0);
+
+    return test::result();
+}
@@ -0,0 +1,225 @@
+// Recovery of the I2C masters of the target, I2cRecovery against a fake bus:
+// which transaction fails, when the queue waits and when the bus is clocked out
+
+#include <chrono>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "check.hpp"
+#include <modm/platform/i2c/i2c_recovery.hpp>
+
+using namespace std::chrono_literals;
+using Error = modm::I2cMaster::Error;
+
+/// Transactions are numbers, the calls of the recovery are logged as letters
+struct FakeBus
+{
+    static constexpr std::chrono::microseconds TransactionTimeout{25ms};
+
+    static inline modm::I2cMaster::Statistics counters{};
+    static inline int attached{0};
+    static inline std::deque<int> queue;
+    static inline std::vector<std::pair<int, Error>> failed;
+    static inline std::chrono::microseconds elapsed{};
+    static inline bool busy{false};
+    static inline std::string log;
+
+    static modm::I2cMaster::Statistics&
+    statistics()
+    {
+        return counters;
+    }
+
+    static bool
+    isAttached()
+    {
+        return attached;
+    }
+
+    static std::chrono::microseconds
+    getAttachedTime()
+    {
+        return elapsed;
+    }
+
+    static bool
+    isBusy()
+    {
+        return busy;
+    }
+
+    static void
+    fail(Error error)
+    {
+        log += 'F';
+        if (attached) {
+            failed.push_back({attached, error});
+        }
+        attached = 0;
+    }
+
+    static void
+    disable()
+    {
+        log += 'D';
+    }
+
+    static void
+    enable()
+    {
+        log += 'E';
+    }
+
+    static void
+    startNext()
+    {
+        if (not queue.empty())
+        {
+            attach(queue.front());
+            queue.pop_front();
+        }
+    }
+
+    static void
+    attach(int transaction)
+    {
+        attached = transaction;
+        elapsed = {};
+    }
+
+    static void
+    reset()
+    {
+        counters = {};
+        attached = 0;
+        queue.clear();
+        failed.clear();
+        busy = false;
+        log.clear();
+    }
+};
+
+using Recovery = modm::platform::I2cRecovery<FakeBus>;
+using Fault = Recovery::Fault;
+
+/// Like start() of the masters: attach on a usable idle bus, queue otherwise
+void
+start(int transaction)
+{
+    if (not FakeBus::attached and not Recovery::isPending()) {
+        FakeBus::attach(transaction);
+    } else {
+        FakeBus::queue.push_back(transaction);
+    }
+}
+
+void
+clockOut()
+{
+    // nothing may be in flight while the bus is bit-banged
+    CHECK(not FakeBus::attached);
+    CHECK(Recovery::isPending());
+    FakeBus::log += 'C';
+}
+
+using Failed = std::vector<std::pair<int, Error>>;
+
+int
+main()
+{
+    // a bus error fails the transaction in flight and holds back the queue,
+    // also for transactions started meanwhile, until supervise() recovers
+    for (const Fault fault : {Fault::BusError, Fault::SclLowTimeout})
+    {
+        FakeBus::reset();
+        start(1);
+        start(2);
+        Recovery::handleFault(fault);
+        CHECK((FakeBus::failed == Failed{{1, Error::BusCondition}}));
+        CHECK(Recovery::isPending());
+        CHECK(not FakeBus::attached);
+        start(3);
+        CHECK((FakeBus::queue == std::deque<int>{2, 3}));
+        CHECK(FakeBus::log == "F");
+
+        // counted once by the interrupt, not again by supervise()
+        const auto counters = FakeBus::counters;
+        CHECK(counters.busErrors + counters.timeouts == 1);
+        CHECK((fault == Fault::BusError) == (counters.busErrors == 1));
+        CHECK(Recovery::supervise(clockOut));
+        CHECK(FakeBus::counters.busErrors == counters.busErrors);
+        CHECK(FakeBus::counters.timeouts == counters.timeouts);
+        CHECK(FakeBus::counters.recoveries == 1);
+
+        // clocked out while disabled, then the queue continues in order
+        CHECK(FakeBus::log == "FDCE");
+        CHECK(not Recovery::isPending());
+        CHECK(FakeBus::attached == 2);
+        CHECK((FakeBus::queue == std::deque<int>{3}));
+        CHECK(FakeBus::failed.size() == 1);
+        CHECK(not Recovery::supervise(clockOut));
+    }
+
+    // arbitration loss and unknown errors fail the transaction only, the bus is fine
+    for (const auto &[fault, error] : {std::pair{Fault::ArbitrationLost, Error::ArbitrationLost},
+                                      std::pair{Fault::Unknown, Error::Unknown}})
+    {
+        FakeBus::reset();
+        start(1);
+        start(2);
+        Recovery::handleFault(fault);
+        CHECK((FakeBus::failed == Failed{{1, error}}));
+        CHECK(not Recovery::isPending());
+        CHECK(FakeBus::attached == 2);
+        CHECK(FakeBus::log == "F");
+        CHECK(not Recovery::supervise(clockOut));
+        CHECK(FakeBus::counters.arbitrationLosses == (fault == Fault::ArbitrationLost));
+        CHECK(FakeBus::counters.recoveries == 0);
+    }
+
+    // a stalled transaction fails after TransactionTimeout, the queued one is replayed
+    {
+        FakeBus::reset();
+        start(1);
+        start(2);
+        FakeBus::elapsed = FakeBus::TransactionTimeout - 1us;
+        CHECK(not Recovery::supervise(clockOut));
+        CHECK(FakeBus::log.empty());
+        FakeBus::elapsed = FakeBus::TransactionTimeout;
+        CHECK(Recovery::supervise(clockOut));
+        CHECK((FakeBus::failed == Failed{{1, Error::BusCondition}}));
+        CHECK(FakeBus::counters.timeouts == 1);
+        CHECK(FakeBus::counters.recoveries == 1);
+        CHECK(FakeBus::log == "FDCE");
+        CHECK(FakeBus::attached == 2);
+        CHECK(FakeBus::elapsed == 0us);
+    }
+
+    // an idle bus which stays busy is recovered, nothing fails
+    {
+        FakeBus::reset();
+        CHECK(not Recovery::supervise(clockOut));
+        FakeBus::busy = true;
+        CHECK(Recovery::supervise(clockOut));
+        CHECK(FakeBus::failed.empty());
+        CHECK(FakeBus::counters.timeouts == 1);
+        CHECK(FakeBus::log == "DCE");
+        CHECK(not FakeBus::attached);
+    }
+
+    // without a way to clock out the bus the peripheral is still reset
+    {
+        FakeBus::reset();
+        start(1);
+        Recovery::handleFault(Fault::BusError);
+        CHECK(Recovery::supervise(nullptr));
+        CHECK(FakeBus::log == "FDE");
+        CHECK(not Recovery::isPending());
+        start(2);
+        CHECK(FakeBus::attached == 2);
+    }
+
+    return test::result();
+}
@@ -0,0 +1,166 @@
+// Missions of the firmware on the SimBoard: the command lines, and Mission,
+// MotorControl and Odometry in the control interrupt of the World, faster
+// than real time
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+#include "check.hpp"
+#include "hardware.hpp"
+#include "control_executive.hpp"
+#include "fault_monitor.hpp"
+#include "mission.hpp"
+#include "motor_control.hpp"
+#include "odometry.hpp"
+
+using namespace std::chrono_literals;
+
+constexpr double Pi = 3.14159265358979323846;
+
+/// Runs the World until the mission is done, at most `limit`.
+/// @return the simulated duration
+std::chrono::nanoseconds
+runMission(Board::World &world, std::chrono::nanoseconds limit)
+{
+    const auto start = world.now();
+    while (Mission::isRunning() and world.now() - start < limit) {
+        world.run(1ms);
+    }
+    return world.now() - start;
+}
+
+/// @return the pose of the odometry in m and rad
+sim::RobotModel::Pose
+odometry()
+{
+    const auto pose = Odometry::getPose();
+    return {pose.x * 1e-6, pose.y * 1e-6, pose.heading * Pi / 2147483648.0};
+}
+
+double
+angleError(double a, double b)
+{
+    return std::remainder(a - b, 2 * Pi);
+}
+
+/// Command lines which are refused without queueing anything
+void
+parse()
+{
+    // out of range, also beyond int32_t
+    CHECK(not Mission::execute("d 10001"));
+    CHECK(not Mission::execute("d -10001"));
+    CHECK(not Mission::execute("d 99999999999"));
+    CHECK(not Mission::execute("t 180"));
+    CHECK(not Mission::execute("t -180"));
+    CHECK(not Mission::execute("a 0 90"));
+    CHECK(not Mission::execute("a -200 90"));
+    CHECK(not Mission::execute("a 200 180"));
+    CHECK(not Mission::execute("g 0 10001"));
+    // trailing garbage, missing and surplus arguments
+    CHECK(not Mission::execute("d 100mm"));
+    CHECK(not Mission::execute("d 100 5"));
+    CHECK(not Mission::execute("t 90.5"));
+    CHECK(not Mission::execute("a 200"));
+    CHECK(not Mission::execute("g 100"));
+    CHECK(not Mission::execute("r 1"));
+    CHECK(not Mission::execute("s now"));
+    CHECK(not Mission::execute("d"));
+    CHECK(not Mission::execute("x 1"));
+    CHECK(not Mission::execute(""));
+    CHECK(not Mission::execute("   "));
+    CHECK(Mission::getQueued() == 0);
+
+    // trailing spaces are fine
+    CHECK(Mission::execute("d 100  "));
+    CHECK(Mission::execute("t -179"));
+    CHECK(Mission::execute("g -10000 10000"));
+    CHECK(Mission::getQueued() == 3);
+    CHECK(Mission::execute("s"));
+    CHECK(Mission::getQueued() == 0);
+
+    // over the UART a line longer than 32 characters is dropped as a whole,
+    // the next line is read from its start again
+    using Uart = Board::DebugUart::DebugUart;
+    Uart::receive("d 100" + std::string(40, ' ') + "\r\n");
+    Uart::receive("d 200\r\n\n");
+    Mission::poll();
+    CHECK(Mission::getQueued() == 1);
+    Uart::receive("t 9");
+    Mission::poll();
+    CHECK(Mission::getQueued() == 1);
+    Uart::receive("0\n");
+    Mission::poll();
+    CHECK(Mission::getQueued() == 2);
+    CHECK(Mission::execute("s"));
+}
+
+int
+main()
+{
+    Board::World world(sim::RobotModel({}, {4.0, 4.0}));
+    Board::initialize();
+    FaultMonitor::initialize();
+    MotorControl::initialize();
+    Mission::initialize();
+
+    parse();
+    CHECK(not Mission::isRunning());
+    CHECK(MotorControl::getSetpoint(MotorControl::Wheel::Left) == 0);
+
+    // an L with an arc to the left at the end
+    CHECK(Mission::execute("d 800"));
+    CHECK(Mission::execute("t 90"));
+    CHECK(Mission::execute("d 400"));
+    CHECK(Mission::execute("a 200 90"));
+    CHECK(Mission::execute("r"));
+    CHECK(Mission::isRunning());
+    world.run(1ms);
+    CHECK(MotorControl::isEnabled());
+    ControlExecutive::resetStatistics();
+
+    const auto wall = std::chrono::steady_clock::now();
+    const auto duration = runMission(world, 60s);
+    const double real = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall).count();
+    const double simulated = std::chrono::duration<double>(duration).count();
+    CHECK(not Mission::isRunning());
+    CHECK(simulated < 60);
+    CHECK(real < simulated);
+
+    // the robot ends near where the mission says, as close as 4 FG edges per
+    // wheel revolution (51 mm each) allow, see path_follower_test
+    const auto truth = world.robot.getPose();
+    const auto estimate = odometry();
+    std::printf("mission %.1f s in %.2f s: truth %.3f %.3f %.1f, odometry %.3f %.3f %.1f\n",
+                simulated, real, truth.x, truth.y, truth.heading * 180 / Pi,
+                estimate.x, estimate.y, estimate.heading * 180 / Pi);
+    CHECK(std::hypot(truth.x - 0.6, truth.y - 0.6) < 0.25);
+    CHECK(std::hypot(estimate.x - 0.6, estimate.y - 0.6) < 0.1);
+    CHECK(std::hypot(truth.x - estimate.x, truth.y - estimate.y) < 0.25);
+    CHECK(std::abs(angleError(truth.heading, estimate.heading)) < 20 * Pi / 180);
+    CHECK(ControlExecutive::getStatistics().iterations == uint32_t(std::lround(simulated * 1000)));
+
+    // nFAULT stops the motors and the mission within a control period
+    CHECK(Mission::execute("d 1000"));
+    CHECK(Mission::execute("r"));
+    world.run(500ms);
+    CHECK(MotorControl::getSpeed(MotorControl::Wheel::Left) > 100);
+    Board::M2_Fault::drive(false);
+    world.run(1ms);
+    CHECK(FaultMonitor::isLatched());
+    CHECK(FaultMonitor::getFault().sources == FaultMonitor::Motor2);
+    CHECK(not MotorControl::isEnabled());
+    CHECK(not Board::M1_Sleep::isSet() and not Board::M2_Sleep::isSet());
+    world.run(10ms);
+    CHECK(not Mission::isRunning());
+    world.run(1s);
+    CHECK(std::abs(world.robot.left().getSpeed()) < 1);
+    CHECK(not Mission::execute("r"));
+
+    Board::M2_Fault::release();
+    CHECK(FaultMonitor::clear());
+
+    return test::result();
+}
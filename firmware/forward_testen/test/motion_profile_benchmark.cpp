@@ -0,0 +1,27 @@
+// MotionProfile cost per control tick, while ramping and during a move
+
+#include "benchmark.hpp"
+#include "motion_profile.hpp"
+
+int
+main()
+{
+    MotionProfile profile;
+    test::benchmark("MotionProfile ramp", 1'000'000, [&](unsigned index)
+    {
+        // up and down between the limits, every tick jerks or accelerates
+        if (index % 2000 == 0) {
+            profile.setTarget((index / 2000) % 2 ? -3000 : 3000);
+        }
+        test::keep(profile.update());
+    });
+    test::benchmark("MotionProfile move", 1'000'000, [&](unsigned index)
+    {
+        // the braking check runs every tick of a move
+        if (index % 2000 == 0) {
+            profile.moveBy((index / 2000) % 2 ? -1000 : 1000, 2000);
+        }
+        test::keep(profile.update());
+    });
+    return 0;
+}
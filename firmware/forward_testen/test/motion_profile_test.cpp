@@ -0,0 +1,191 @@
+// MotionProfile ramps and moves against the limits of its parameters
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "check.hpp"
+#include "motion_profile.hpp"
+
+constexpr MotionProfile::Parameters Limits{.acceleration = 4000, .jerk = 40000, .frequency = 1000};
+
+struct Run
+{
+    int ticks;
+    int32_t minimum;        ///< velocity setpoints
+    int32_t maximum;
+    int32_t acceleration;   ///< largest magnitude in units per s
+    int32_t jerk;           ///< largest magnitude in units per s^2
+    double distance;        ///< units times s
+};
+
+/// @return every `interval`th setpoint until the profile settles
+std::vector<int32_t>
+sample(MotionProfile &profile, int interval)
+{
+    std::vector<int32_t> samples;
+    for (int tick = 1; profile.isBusy() and tick <= 20'000; tick++)
+    {
+        const int32_t velocity = profile.update();
+        if (tick % interval == 0) {
+            samples.push_back(velocity);
+        }
+    }
+    return samples;
+}
+
+/// Updates the profile until it settles
+Run
+settle(MotionProfile &profile, int limit = 20'000)
+{
+    Run run{0, INT32_MAX, INT32_MIN, 0, 0, 0};
+    int32_t acceleration = profile.getAcceleration();
+    while (profile.isBusy() and run.ticks < limit)
+    {
+        const int32_t velocity = profile.update();
+        run.ticks++;
+        run.minimum = std::min(run.minimum, velocity);
+        run.maximum = std::max(run.maximum, velocity);
+        run.distance += velocity / double(Limits.frequency);
+        run.acceleration = std::max(run.acceleration, std::abs(profile.getAcceleration()));
+        run.jerk = std::max(run.jerk, std::abs(profile.getAcceleration() - acceleration) * int32_t(Limits.frequency));
+        acceleration = profile.getAcceleration();
+    }
+    return run;
+}
+
+void
+checkLimits(const Run &run)
+{
+    CHECK(run.acceleration <= int32_t(Limits.acceleration));
+    CHECK(run.jerk <= int32_t(Limits.jerk));
+}
+
+int
+main()
+{
+    MotionProfile profile(Limits);
+
+    // ramp up: no overshoot, limits kept, exact landing
+    {
+        profile.setTarget(3000);
+        const Run run = settle(profile);
+        std::printf("ramp to 3000: %d ticks, max %d, |a| %d, |j| %d\n", run.ticks, run.maximum, run.acceleration, run.jerk);
+        checkLimits(run);
+        CHECK(run.maximum == 3000);
+        CHECK(run.minimum >= 0);
+        CHECK(profile.getVelocity() == 3000);
+        CHECK(profile.getAcceleration() == 0);
+        // 3000 / 4000 s at full acceleration plus one jerk phase of 0.1 s
+        CHECK(std::abs(run.ticks - 850) < 20);
+    }
+
+    // down to a lower target without undershoot
+    {
+        profile.setTarget(100);
+        const Run run = settle(profile);
+        checkLimits(run);
+        CHECK(run.minimum == 100);
+        CHECK(run.maximum <= 3000);
+        CHECK(profile.getVelocity() == 100);
+    }
+
+    // through zero to a negative target
+    {
+        profile.setTarget(-500);
+        const Run run = settle(profile);
+        checkLimits(run);
+        CHECK(run.minimum == -500);
+        CHECK(profile.getVelocity() == -500);
+    }
+
+    // a short step never reaches the full acceleration
+    {
+        profile.reset();
+        profile.setTarget(20);
+        const Run run = settle(profile);
+        checkLimits(run);
+        CHECK(run.maximum == 20);
+        CHECK(run.acceleration < int32_t(Limits.acceleration));
+    }
+
+    // reversal in the middle of the ramp continues smoothly
+    {
+        profile.reset();
+        profile.setTarget(3000);
+        for (int tick = 0; tick < 300; tick++) {
+            profile.update();
+        }
+        const int32_t reversed = profile.getVelocity();
+        profile.setTarget(0);
+        const Run run = settle(profile);
+        std::printf("reversal at %d: peak %d in %d ticks\n", reversed, run.maximum, run.ticks);
+        checkLimits(run);
+        CHECK(run.maximum >= reversed);
+        CHECK(run.maximum < reversed + 300);
+        CHECK(run.minimum == 0);
+    }
+
+    // moves cover the distance and stop, the discrete braking ends a little late
+    for (const int32_t distance : {1000, 60, 5, -300})
+    {
+        profile.reset();
+        profile.moveBy(distance, 2000);
+        const Run run = settle(profile);
+        std::printf("move %d: %.2f in %d ticks\n", distance, run.distance, run.ticks);
+        checkLimits(run);
+        CHECK(std::abs(run.distance - distance) <= 4);
+        CHECK(profile.getVelocity() == 0);
+        CHECK(distance < 0 ? run.maximum <= 0 : run.minimum >= 0);
+        CHECK(std::abs(distance < 0 ? run.minimum : run.maximum) <= 2000);
+    }
+
+    // short moves brake before the full deceleration, from the integer square root
+    {
+        double worst = 0;
+        bool settled = true;
+        for (int32_t distance = 1; distance <= 400; distance += 3)
+        {
+            profile.reset();
+            profile.moveBy(distance, 2000);
+            const Run run = settle(profile);
+            settled &= run.ticks < 20'000 and profile.getVelocity() == 0;
+            worst = std::max(worst, std::abs(run.distance - distance));
+        }
+        std::printf("short moves: worst %.2f\n", worst);
+        CHECK(settled);
+        CHECK(worst <= 5);
+    }
+
+    // golden profiles, any change of the setpoints is a change of the motion:
+    // the ramp jerks for 0.1 s, accelerates at 4000 and jerks down to 3000,
+    // the short move peaks at 338 without reaching the cruise velocity
+    {
+        profile.reset();
+        profile.setTarget(3000);
+        const std::vector<int32_t> ramp{51, 202, 402, 602, 802, 1002, 1202, 1402, 1602,
+                                        1802, 2002, 2202, 2402, 2602, 2802, 2951, 3000};
+        CHECK(sample(profile, 50) == ramp);
+
+        profile.reset();
+        profile.moveBy(60, 2000);
+        const std::vector<int32_t> move{8, 33, 73, 130, 199, 258, 301, 327, 338,
+                                        333, 312, 275, 221, 153, 91, 45, 15, 1};
+        CHECK(sample(profile, 20) == move);
+    }
+
+    // same inputs, same setpoints
+    {
+        MotionProfile a(Limits), b(Limits);
+        a.moveBy(777, 1500);
+        b.moveBy(777, 1500);
+        bool equal = true;
+        for (int tick = 0; tick < 2000; tick++) {
+            equal &= a.update() == b.update();
+        }
+        CHECK(equal);
+    }
+
+    return test::result();
+}
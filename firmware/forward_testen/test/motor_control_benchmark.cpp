@@ -0,0 +1,30 @@
+// Cost of the MotorControl stages per control tick, both wheels at speed
+
+#include "benchmark.hpp"
+#include "hardware.hpp"
+#include "control_executive.hpp"
+#include "fault_monitor.hpp"
+#include "motor_control.hpp"
+
+using namespace std::chrono_literals;
+
+int
+main()
+{
+    Board::World world;
+    Board::initialize();
+    FaultMonitor::initialize();
+    MotorControl::initialize();
+    MotorControl::setSpeed(3000, -1500);
+    world.run(1s);
+
+    // the timer updates of one tick without the models, the simulated time stands still
+    const uint32_t updates = Board::MotorPwm::UpdateFrequency / ControlExecutive::getFrequency();
+    test::benchmark("MotorControl tick", 100'000, [&](unsigned)
+    {
+        for (uint32_t update = 0; update < updates; update++) {
+            Board::MotorTimer3::update();
+        }
+    });
+    return 0;
+}
@@ -0,0 +1,124 @@
+// MotorControl on the SimBoard: speed tracking under load and supply sag, and
+// the direction reversal through a braked tick
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "check.hpp"
+#include "hardware.hpp"
+#include "control_executive.hpp"
+#include "fault_monitor.hpp"
+#include "motor_control.hpp"
+
+using namespace std::chrono_literals;
+using MotorControl::Wheel;
+
+struct Speeds
+{
+    double mean{0};
+    double min{1e9};
+    double max{-1e9};
+};
+
+/// @return the true speed of the left wheel over `duration`, sampled every 1 ms
+Speeds
+measure(Board::World &world, std::chrono::milliseconds duration)
+{
+    Speeds speeds;
+    for (auto time = 0ms; time < duration; time += 1ms)
+    {
+        world.run(1ms);
+        const double speed = world.robot.left().getSpeed();
+        speeds.mean += speed / duration.count();
+        speeds.min = std::min(speeds.min, speed);
+        speeds.max = std::max(speeds.max, speed);
+    }
+    return speeds;
+}
+
+int16_t
+integral()
+{
+    return MotorControl::getController(Wheel::Left).getIntegral();
+}
+
+int
+main()
+{
+    Board::World world;
+    Board::initialize();
+    FaultMonitor::initialize();
+    MotorControl::initialize();
+
+    // steady speed
+    MotorControl::setSpeed(3000, 3000);
+    world.run(1s);
+    auto speeds = measure(world, 500ms);
+    CHECK(std::abs(speeds.mean - 3000) < 15);
+    CHECK(speeds.min > 2970 and speeds.max < 3030);
+    const int16_t nominal = integral();
+
+    // a load step of 30 % of the stall torque dips and recovers
+    world.robot.left().setLoad(0.03);
+    speeds = measure(world, 100ms);
+    std::printf("load step: %.0f to %.0f rpm\n", speeds.min, speeds.max);
+    CHECK(speeds.min > 1800);
+    world.run(1s);
+    speeds = measure(world, 500ms);
+    CHECK(std::abs(speeds.mean - 3000) < 15);
+    CHECK(integral() > nominal);
+    world.robot.left().setLoad(0);
+
+    // the integral absorbs a sag from 12 V to 9 V ...
+    world.robot.left().setSupply(9.0);
+    world.robot.right().setSupply(9.0);
+    world.run(1s);
+    speeds = measure(world, 500ms);
+    CHECK(std::abs(speeds.mean - 3000) < 15);
+    const int16_t sagged = integral();
+    CHECK(sagged > nominal);
+
+    // ... which the feed-forward takes over once VM is measured
+    MotorControl::setSupplyVoltage(9000);
+    world.run(1s);
+    speeds = measure(world, 500ms);
+    std::printf("integral: %d nominal, %d at 9 V, %d compensated\n", nominal, sagged, integral());
+    CHECK(std::abs(speeds.mean - 3000) < 15);
+    CHECK(std::abs(integral() - nominal) < std::abs(sagged - nominal) / 4);
+    MotorControl::setSupplyVoltage(12000);
+    world.robot.left().setSupply(12.0);
+    world.robot.right().setSupply(12.0);
+
+    // reversal: the wheel is only driven against its rotation near standstill
+    // and DIR changes after a tick with zero duty, the compare value in effect
+    int16_t before = Board::MotorPwm::getDuty(0);
+    bool dir = Board::M1_Dir::isSet();
+    uint32_t reversals = 0;
+    MotorControl::setSpeed(-1500, -1500);
+    for (auto time = 0ns; time < 2s; time += Board::World::Step)
+    {
+        world.run(Board::World::Step);
+        const double speed = world.robot.left().getSpeed();
+        const int16_t duty = Board::MotorPwm::getDuty(0);
+        if (Board::M1_Dir::isSet() != dir)
+        {
+            CHECK(before == 0);
+            CHECK(std::abs(speed) < MotorControl::ReversalSpeed);
+            dir = not dir;
+            reversals++;
+        }
+        if (duty != 0) {
+            const double reversal = MotorControl::ReversalSpeed;
+            CHECK(dir ? speed < reversal : speed > -reversal);
+        }
+        before = duty;
+    }
+    CHECK(reversals == 1);
+    CHECK(std::abs(world.robot.left().getSpeed() + 1500) < 15);
+    CHECK(std::abs(MotorControl::getSpeed(Wheel::Left) + 1500) < 15);
+
+    return test::result();
+}
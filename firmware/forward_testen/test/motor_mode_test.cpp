@@ -0,0 +1,176 @@
+// MotorModeSwitch transitions on the GPIO model of the SimBoard, checked between the port writes
+
+#include <cstdio>
+
+#include "check.hpp"
+#include "sim/sim_board.hpp"
+
+using namespace SimBoard;
+using Mode = MotorMode;
+
+struct Driver
+{
+    bool sleep, brake, dir;
+
+    bool
+    isDriving() const
+    {
+        return sleep and not brake;
+    }
+};
+
+template<class Sleep, class Brake, class Dir>
+Driver
+driver()
+{
+    return {Sleep::isSet(), Brake::isSet(), Dir::isSet()};
+}
+
+std::array<Driver, 2>
+drivers()
+{
+    return {driver<M1_Sleep, M1_Brake, M1_Dir>(), driver<M2_Sleep, M2_Brake, M2_Dir>()};
+}
+
+void
+setPins(uint8_t pins)
+{
+    M1_Sleep::set(pins & Mode::Sleep);
+    M2_Sleep::set(pins & Mode::Sleep);
+    M1_Brake::set(pins & Mode::Brake);
+    M2_Brake::set(pins & Mode::Brake);
+    M1_Dir::set(pins & Mode::Dir);
+    M2_Dir::set(pins & Mode::Dir);
+}
+
+/// A driver never sees DIR change while it drives before and after the write
+bool safe{true};
+std::array<Driver, 2> before;
+
+void
+check(char, uint32_t)
+{
+    const auto after = drivers();
+    for (size_t motor = 0; motor < after.size(); motor++)
+    {
+        if (after[motor].dir != before[motor].dir and before[motor].isDriving() and after[motor].isDriving()) {
+            safe = false;
+        }
+    }
+    before = after;
+}
+
+/// @return the number of port writes from the pins `actual` to `to`, applied as from `from`
+uint32_t
+transition(uint8_t actual, uint8_t from, uint8_t to)
+{
+    setPins(actual);
+    before = drivers();
+    const uint32_t writes = MotorPort::writes;
+    Mode::apply(from, to);
+    return MotorPort::writes - writes;
+}
+
+bool
+isMode(uint8_t pins)
+{
+    for (const Driver &driver : drivers())
+    {
+        if (driver.sleep != bool(pins & Mode::Sleep) or driver.brake != bool(pins & Mode::Brake) or
+            driver.dir != bool(pins & Mode::Dir)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int
+main()
+{
+    M1_Sleep::setOutput(false);
+    M1_Brake::setOutput(false);
+    M1_Dir::setOutput(false);
+    M2_Sleep::setOutput(false);
+    M2_Brake::setOutput(false);
+    M2_Dir::setOutput(false);
+    MotorPort::onWrite = check;
+
+    // reversing while driving adds the Brake and keeps the phases in separate writes,
+    // waking up in the other direction does not need it
+    static_assert(Mode::sequence(0, Mode::Sleep | Mode::Dir).size <
+                  Mode::sequence(Mode::Sleep, Mode::Sleep | Mode::Dir).size);
+    static_assert(Mode::sequence(Mode::Unknown, Mode::Sleep).size ==
+                  Mode::sequence(Mode::Sleep | Mode::Dir, Mode::Sleep).size);
+
+    // every transition from a known mode
+    for (uint8_t from = 0; from < 8; from++)
+    {
+        for (uint8_t to = 0; to < 8; to++)
+        {
+            safe = true;
+            transition(from, from, to);
+            CHECK(safe);
+            CHECK(isMode(to));
+        }
+    }
+
+    // from an unknown mode, whatever the pins are
+    for (uint8_t actual = 0; actual < 8; actual++)
+    {
+        for (uint8_t to = 0; to < 8; to++)
+        {
+            safe = true;
+            transition(actual, Mode::Unknown, to);
+            CHECK(safe);
+            CHECK(isMode(to));
+        }
+    }
+
+    // apply() reads the mode from the pins, drivers in different modes are unknown
+    setPins(Mode::Sleep);
+    CHECK(Mode::current() == Mode::Sleep);
+    M2_Dir::set();
+    CHECK(Mode::current() == Mode::Unknown);
+    safe = true;
+    before = drivers();
+    Mode::apply(Mode::Sleep);
+    CHECK(safe);
+    CHECK(isMode(Mode::Sleep));
+
+    // the reversal is visible in between: both drivers braked while DIR changes
+    setPins(Mode::Sleep);
+    before = drivers();
+    bool braked = false;
+    MotorPort::onWrite = [&](char port, uint32_t bsrr)
+    {
+        check(port, bsrr);
+        const auto now = drivers();
+        braked |= now[0].brake and now[1].brake and not now[0].dir and not now[1].dir;
+    };
+    Mode::apply(Mode::Sleep | Mode::Dir);
+    CHECK(braked);
+    CHECK(safe);
+    CHECK(isMode(Mode::Sleep | Mode::Dir));
+
+    // a single driver reverses alone, the other one keeps driving
+    using Right = Mode::Driver<1>;
+    setPins(Mode::Sleep);
+    before = drivers();
+    braked = false;
+    bool untouched = true;
+    MotorPort::onWrite = [&](char port, uint32_t bsrr)
+    {
+        check(port, bsrr);
+        const auto now = drivers();
+        braked |= now[1].brake and not now[1].dir;
+        untouched &= now[0].isDriving() and not now[0].dir;
+    };
+    CHECK(Right::current() == Right::Sleep);
+    Right::apply(Right::Sleep | Right::Dir);
+    CHECK(braked);
+    CHECK(untouched);
+    CHECK(safe);
+    CHECK(M2_Dir::isSet() and M2_Sleep::isSet() and not M2_Brake::isSet());
+
+    return test::result();
+}
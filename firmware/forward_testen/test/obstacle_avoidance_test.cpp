@@ -0,0 +1,114 @@
+// ObstacleAvoidance exploring walled arenas on the robot model, like explore() in main.cpp
+
+#include <chrono>
+#include <cstdio>
+
+#include "check.hpp"
+#include "closed_loop.hpp"
+#include "obstacle_avoidance.hpp"
+#include "range_filter.hpp"
+
+using State = ObstacleAvoidance::State;
+using RangeErrorCode = modm::vl53l0::RangeErrorCode;
+
+struct Result
+{
+    uint32_t ticks[5];      ///< per state
+    uint32_t recoveries;
+    double minimumRange;    ///< m, front sensor to the wall
+    double travelled;       ///< m
+    bool inside;
+    double realTime;        ///< s to compute the scenario
+};
+
+/// Runs the behavior every 20 ms for `seconds`, ranges carry +-10 mm of noise.
+Result
+explore(sim::RobotModel robot, int seconds)
+{
+    const auto start = std::chrono::steady_clock::now();
+    test::ClosedLoop loop(robot);
+    RangeFilter<5> filter;
+    ObstacleAvoidance behavior;
+    behavior.reset();
+
+    Result result{{}, 0, 1e9, 0, true, 0};
+    uint32_t seed = 7;
+    for (int tick = 0; tick < seconds * 1000; tick++)
+    {
+        if (tick % 20 == 0)
+        {
+            seed = seed * 1664525 + 1013904223;
+            const double range = robot.getRange() * 1000 + int(seed >> 16) % 21 - 10;
+            if (range < 2000) {
+                filter.update(uint16_t(std::max(range, 0.0)), 20 << 7, RangeErrorCode::RangeComplete);
+            } else {
+                filter.update(8190, 0, RangeErrorCode::RangePhaseCheck);
+            }
+            const auto pose = loop.getPose();
+            const auto command = behavior.update({
+                    .tracking = filter.isTracking(),
+                    .distance = filter.getDistance(),
+                    .velocity = filter.getVelocity(),
+                    .x = pose.x,
+                    .y = pose.y,
+                    .heading = pose.heading,
+                    .left = loop.getSpeed(0),
+                    .right = loop.getSpeed(1)});
+            loop.setSpeed(command.left, command.right);
+            result.ticks[uint8_t(behavior.getState())]++;
+        }
+        loop.tick();
+        result.inside &= robot.isInside();
+        result.minimumRange = std::min(result.minimumRange, robot.getRange());
+    }
+    result.recoveries = behavior.getRecoveries();
+    result.travelled = robot.getTravelled();
+    result.realTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+void
+report(const char *name, const Result &result)
+{
+    std::printf("%s: cruise %u, slow %u, stop %u, turn %u, recover %u ticks, %u recoveries, "
+                "closest %.0f mm, travelled %.1f m, computed in %.2f s\n",
+                name, result.ticks[0], result.ticks[1], result.ticks[2], result.ticks[3], result.ticks[4],
+                result.recoveries, result.minimumRange * 1000, result.travelled, result.realTime);
+}
+
+int
+main()
+{
+    constexpr int Seconds = 60;
+
+    // open 3 x 2 m arena, starting diagonally
+    {
+        sim::RobotModel robot({}, {3.0, 2.0});
+        robot.setPose({0.3, -0.2, 0.7});
+        const Result result = explore(robot, Seconds);
+        report("arena", result);
+        CHECK(result.inside);
+        CHECK(result.ticks[uint8_t(State::Cruise)] > 0);
+        CHECK(result.ticks[uint8_t(State::SlowDown)] > 0);
+        CHECK(result.ticks[uint8_t(State::TurnAway)] > 0);
+        CHECK(result.minimumRange > 0.05);
+        CHECK(result.travelled > 10);
+        CHECK(result.realTime < Seconds);
+    }
+
+    // small 1.6 x 1.6 m box, starting head on towards a wall
+    {
+        sim::RobotModel robot({}, {1.6, 1.6});
+        robot.setPose({0, 0, 0});
+        const Result result = explore(robot, Seconds);
+        report("box", result);
+        CHECK(result.inside);
+        CHECK(result.ticks[uint8_t(State::Stop)] > 0);
+        CHECK(result.ticks[uint8_t(State::TurnAway)] > result.ticks[uint8_t(State::Cruise)]);
+        CHECK(result.minimumRange > 0.2);
+        CHECK(result.travelled > 10);
+        CHECK(result.realTime < Seconds);
+    }
+
+    return test::result();
+}
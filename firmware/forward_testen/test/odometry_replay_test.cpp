@@ -0,0 +1,143 @@
+// DifferentialOdometry replaying the tacho edges of a drive through the robot model
+
+#include "check.hpp"
+#include "differential_odometry.hpp"
+#include "soft_math.hpp"
+#include "sim/robot_model.hpp"
+
+#include <cmath>
+#include <vector>
+
+using namespace std::chrono_literals;
+using Odometry = DifferentialOdometry<soft::sincos>;
+
+/// Same as Odometry::Geometry and the default sim::RobotModel
+constexpr Odometry::Geometry Geometry{51'050, 120'000};
+
+constexpr double Pi = 3.14159265358979323846;
+
+struct Edges
+{
+    int16_t left;
+    int16_t right;
+};
+
+struct Segment
+{
+    int16_t left;   ///< duty as Q15
+    int16_t right;
+    std::chrono::milliseconds duration;
+};
+
+/**
+ * Drives the segments and records the signed edges of both wheels for
+ * every 1 ms control period, the sign is the direction the wheel turns in,
+ * so coasting edges count like driven ones.
+ */
+std::vector<Edges>
+record(sim::RobotModel &robot, std::initializer_list<Segment> segments)
+{
+    std::vector<Edges> recording;
+    for (const Segment &segment : segments)
+    {
+        for (auto time = 0ms; time < segment.duration; time += 1ms)
+        {
+            const uint32_t left = robot.left().getEdgeCount(), right = robot.right().getEdgeCount();
+            robot.step(segment.left, segment.right, 1ms);
+            const int16_t dl = robot.left().getEdgeCount() - left, dr = robot.right().getEdgeCount() - right;
+            recording.push_back({int16_t(robot.left().getSpeed() < 0 ? -dl : dl),
+                                 int16_t(robot.right().getSpeed() < 0 ? -dr : dr)});
+        }
+    }
+    return recording;
+}
+
+Odometry::Pose
+replay(const std::vector<Edges> &recording)
+{
+    Odometry odometry(Geometry);
+    for (const Edges &edges : recording) {
+        odometry.update(edges.left, edges.right);
+    }
+    return odometry.getPose();
+}
+
+double
+degrees(int32_t heading)
+{
+    return heading / 2147483648.0 * 180;
+}
+
+/// @return the position error in mm and the heading error in degree
+std::pair<double, double>
+compare(const Odometry::Pose &pose, const sim::RobotModel::Pose &truth)
+{
+    const double distance = std::hypot(pose.x / 1e3 - truth.x * 1e3, pose.y / 1e3 - truth.y * 1e3);
+    const double heading = std::remainder(degrees(pose.heading) - truth.heading * 180 / Pi, 360);
+    return {distance, std::abs(heading)};
+}
+
+int
+main()
+{
+    // straight ahead, forwards and back
+    {
+        sim::RobotModel robot;
+        const auto recording = record(robot, {{4000, 4000, 2000ms}, {0, 0, 1000ms}, {-4000, -4000, 1500ms}, {0, 0, 1000ms}});
+        const auto pose = replay(recording);
+        const auto [distance, heading] = compare(pose, robot.getPose());
+        std::printf("straight: %.0f mm, %.1f deg\n", distance, heading);
+        CHECK(distance < 51);
+        CHECK(heading == 0);
+    }
+
+    // a figure of turns in place, arcs and coasting
+    {
+        sim::RobotModel robot;
+        const auto recording = record(robot,
+        {
+            {4000, 4000, 1000ms}, {-3000, 3000, 300ms}, {0, 0, 500ms},
+            {3000, 5000, 1500ms}, {0, 0, 500ms}, {5000, 2500, 1200ms},
+            {-4000, -4000, 800ms}, {3000, -3000, 200ms}, {0, 0, 1000ms},
+        });
+        const auto pose = replay(recording);
+        const auto [distance, heading] = compare(pose, robot.getPose());
+        std::printf("route over %.2f m: %.0f mm, %.1f deg\n", robot.getTravelled(), distance, heading);
+        // one edge of difference between the wheels is 24 degree
+        CHECK(distance < 0.05 * robot.getTravelled() * 1e3);
+        CHECK(heading < 24);
+
+        // the replay is deterministic
+        const auto again = replay(recording);
+        CHECK(again.x == pose.x and again.y == pose.y and again.heading == pose.heading);
+    }
+
+    // a full turn in place returns to the start, 1 mm per edge on a 150 mm track
+    {
+        Odometry odometry;
+        for (int index = 0; index < 2 * 471; index++) {
+            odometry.update(index % 2 ? -1 : 0, index % 2 ? 0 : 1);
+        }
+        const auto pose = odometry.getPose();
+        CHECK(std::abs(pose.x) < 500 and std::abs(pose.y) < 500);
+        CHECK(std::abs(degrees(pose.heading)) < 0.5);
+    }
+
+    // a circle with 225 mm radius closes
+    {
+        Odometry odometry;
+        const int ticks = std::lround(2 * Pi * 225 / 1.5);
+        double far = 0;
+        for (int index = 0; index < ticks; index++)
+        {
+            odometry.update(1, 2);
+            const auto pose = odometry.getPose();
+            far = std::max(far, std::hypot(pose.x, pose.y) / 1e3);
+        }
+        const auto pose = odometry.getPose();
+        CHECK(std::abs(far - 450) < 2);
+        CHECK(std::hypot(pose.x, pose.y) < 2'000);
+    }
+
+    return test::result();
+}
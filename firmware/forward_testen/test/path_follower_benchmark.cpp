@@ -0,0 +1,50 @@
+// PathFollower cost per control tick, replaying the poses of a mission
+
+#include "benchmark.hpp"
+#include "closed_loop.hpp"
+#include "path_follower.hpp"
+
+#include <vector>
+
+using Follower = PathFollower<soft::sincos, soft::atan2>;
+
+void
+plan(Follower &follower)
+{
+    constexpr int32_t Quarter = 0x4000'0000;
+    for (int side = 0; side < 4; side++)
+    {
+        follower.push(PathPrimitive::drive(600'000));
+        follower.push(PathPrimitive::turn(Quarter));
+    }
+    follower.push(PathPrimitive::arc(300'000, Quarter));
+    follower.push(PathPrimitive::moveTo(0, 0));
+    follower.start({0, 0, 0});
+}
+
+int
+main()
+{
+    sim::RobotModel robot({}, {4.0, 4.0});
+    test::ClosedLoop loop(robot);
+    Follower follower;
+    plan(follower);
+
+    std::vector<Follower::Pose> poses;
+    while (follower.isRunning() and poses.size() < 60'000)
+    {
+        const auto pose = loop.getPose();
+        poses.push_back({pose.x, pose.y, pose.heading});
+        const auto command = follower.update(poses.back());
+        loop.setSpeed(command.left, command.right);
+        loop.tick();
+    }
+
+    Follower replay;
+    plan(replay);
+    test::benchmark("PathFollower::update()", poses.size(), [&](unsigned index)
+    {
+        test::keep(replay.update(poses[index]));
+    });
+    return 0;
+}
@@ -0,0 +1,77 @@
+// PathFollower running a mission on the robot model, tracking error against the truth
+
+#include "check.hpp"
+#include "closed_loop.hpp"
+#include "path_follower.hpp"
+
+using Follower = PathFollower<soft::sincos, soft::atan2>;
+
+constexpr int32_t
+degree(double angle)
+{
+    return int32_t(std::min(angle / 180 * 2147483648.0, 2147483647.0));
+}
+
+int
+main()
+{
+    sim::RobotModel robot({}, {4.0, 4.0});
+    test::ClosedLoop loop(robot);
+
+    // a square, two arcs, a reverse and two go-tos, ending at (500, 200) mm
+    Follower follower;
+    for (int side = 0; side < 4; side++)
+    {
+        CHECK(follower.push(PathPrimitive::drive(600'000)));
+        CHECK(follower.push(PathPrimitive::turn(degree(90))));
+    }
+    CHECK(follower.push(PathPrimitive::arc(300'000, degree(170))));
+    CHECK(follower.push(PathPrimitive::arc(200'000, -degree(120))));
+    CHECK(follower.push(PathPrimitive::drive(-300'000)));
+    CHECK(follower.push(PathPrimitive::moveTo(0, 0)));
+    CHECK(follower.push(PathPrimitive::moveTo(500'000, 200'000)));
+    CHECK(follower.getQueued() == 13);
+
+    follower.start({0, 0, 0});
+    int32_t maxError = 0;
+    int64_t sumError = 0;
+    int ticks = 0;
+    for (; follower.isRunning() and ticks < 120'000; ticks++)
+    {
+        const auto pose = loop.getPose();
+        const auto command = follower.update({pose.x, pose.y, pose.heading});
+        loop.setSpeed(command.left, command.right);
+        loop.tick();
+        if (follower.isRunning())
+        {
+            maxError = std::max(maxError, std::abs(follower.getError()));
+            sumError += std::abs(follower.getError());
+        }
+    }
+    const auto pose = loop.getPose();
+    const auto &truth = robot.getPose();
+    const double meanError = sumError / double(ticks) / 1000;
+    std::printf("mission %.1f s, cross-track max %.1f mm mean %.1f mm, "
+                "end odometry (%.0f, %.0f) truth (%.0f, %.0f) mm\n",
+                ticks / 1000.0, maxError / 1000.0, meanError,
+                pose.x / 1000.0, pose.y / 1000.0, truth.x * 1000, truth.y * 1000);
+
+    CHECK(not follower.isRunning());
+    CHECK(follower.getCompleted() == 13);
+    CHECK(maxError < 180'000);
+    CHECK(meanError < 35);
+    // a go-to ends when the robot passes the goal, the truth drifts away from
+    // the odometry with its 24 degree heading steps
+    CHECK(std::hypot(pose.x - 500'000, pose.y - 200'000) < 250'000);
+
+    // stop() ends the mission and commands standstill
+    follower.push(PathPrimitive::drive(1'000'000));
+    follower.start({pose.x, pose.y, pose.heading});
+    CHECK(follower.isRunning());
+    follower.stop();
+    CHECK(not follower.isRunning());
+    const auto command = follower.update({pose.x, pose.y, pose.heading});
+    CHECK(command.left == 0 and command.right == 0);
+
+    return test::result();
+}
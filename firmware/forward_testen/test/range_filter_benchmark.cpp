@@ -0,0 +1,26 @@
+// RangeFilter cost per sample
+
+#include "benchmark.hpp"
+#include "range_filter.hpp"
+
+int
+main()
+{
+    using RangeErrorCode = modm::vl53l0::RangeErrorCode;
+
+    RangeFilter<5> filter5;
+    test::benchmark("RangeFilter<5>::update()", 1'000'000, [&](unsigned index)
+    {
+        const uint16_t distance = 800 + (index * 37) % 41;
+        const auto error = (index % 13) ? RangeErrorCode::RangeComplete : RangeErrorCode::RangingAlgoOverflow;
+        test::keep(filter5.update(distance, 20 << 7, error));
+    });
+
+    RangeFilter<15> filter15;
+    test::benchmark("RangeFilter<15>::update()", 1'000'000, [&](unsigned index)
+    {
+        const uint16_t distance = 800 + (index * 37) % 41;
+        test::keep(filter15.update(distance, 20 << 7, RangeErrorCode::RangeComplete));
+    });
+    return 0;
+}
@@ -0,0 +1,150 @@
+// RangeFilter replaying a VL53L0 recording of an approach to a wall
+
+#include "check.hpp"
+#include "range_filter.hpp"
+
+#include <cmath>
+#include <vector>
+
+using RangeErrorCode = modm::vl53l0::RangeErrorCode;
+
+struct Sample
+{
+    uint16_t truth;         ///< mm
+    uint16_t distance;      ///< mm, as reported by the sensor
+    uint16_t signalRate;    ///< MCPS as 9.7 fixed point
+    RangeErrorCode error;
+};
+
+/**
+ * 10 s at the 33 ms sensor period: standing 1200 mm in front of a wall for
+ * 1 s, approaching it with 300 mm/s down to 300 mm and standing again. The
+ * distances carry +-12 mm of noise, every 13th sample is a range overflow,
+ * every 29th a valid looking reflection 350 mm too far and every 31st has
+ * a weak return signal.
+ *
+ * The noise comes from a fixed LCG, so every run sees the same recording.
+ */
+std::vector<Sample>
+record()
+{
+    std::vector<Sample> recording;
+    uint32_t seed = 12345;
+    for (int index = 0; index < 303; index++)
+    {
+        const int time = index * 33;
+        const int truth = std::clamp(1200 - (time - 1000) * 300 / 1000, 300, 1200);
+        seed = seed * 1664525 + 1013904223;
+        const int noise = int(seed >> 16) % 25 - 12;
+
+        Sample sample{uint16_t(truth), uint16_t(truth + noise), 20 << 7, RangeErrorCode::RangeComplete};
+        if (index % 13 == 12) {
+            sample = {uint16_t(truth), 8190, 0, RangeErrorCode::RangingAlgoOverflow};
+        }
+        else if (index % 29 == 28) {
+            sample.distance += 350;
+        }
+        else if (index % 31 == 30) {
+            sample.signalRate = 10;
+        }
+        recording.push_back(sample);
+    }
+    return recording;
+}
+
+struct Output
+{
+    uint16_t distance;
+    int32_t velocity;
+    bool accepted;
+};
+
+std::vector<Output>
+replay(const std::vector<Sample> &recording)
+{
+    RangeFilter<5> filter;
+    std::vector<Output> outputs;
+    for (const Sample &sample : recording)
+    {
+        const bool accepted = filter.update(sample.distance, sample.signalRate, sample.error);
+        outputs.push_back({filter.getDistance(), filter.getVelocity(), accepted});
+    }
+    return outputs;
+}
+
+int
+main()
+{
+    const auto recording = record();
+    const auto outputs = replay(recording);
+
+    double rawSquares = 0, filteredSquares = 0, velocity = 0;
+    int samples = 0, approaching = 0, implausible = 0, rejected = 0, maxError = 0;
+    for (size_t index = 0; index < recording.size(); index++)
+    {
+        const Sample &sample = recording[index];
+        const Output &output = outputs[index];
+        const bool plausible = sample.error == RangeErrorCode::RangeComplete and sample.signalRate >= 32;
+        CHECK(output.accepted == plausible);
+        implausible += not plausible;
+        rejected += not output.accepted;
+
+        if (index < 5) continue;    // the median window fills
+        const int rawError = sample.distance - sample.truth;
+        const int error = output.distance - sample.truth;
+        if (plausible) rawSquares += rawError * rawError;
+        filteredSquares += error * error;
+        samples++;
+
+        const int time = index * 33;
+        if (time < 1000 or time > 3300)
+        {
+            // standing, the filter settles after the start and the stop
+            if ((time > 300 and time < 1000) or time > 4500) {
+                maxError = std::max(maxError, std::abs(error));
+            }
+        }
+        else if (time > 1600) {
+            // approaching, the velocity estimate has settled
+            velocity += output.velocity;
+            approaching++;
+        }
+    }
+    velocity /= approaching;
+    const double rawRms = std::sqrt(rawSquares / samples);
+    const double filteredRms = std::sqrt(filteredSquares / samples);
+    std::printf("raw rms %.1f mm, filtered rms %.1f mm, max standing error %d mm, "
+                "mean approach %.0f mm/s, rejected %d\n",
+                rawRms, filteredRms, maxError, velocity, rejected);
+    CHECK(filteredRms < rawRms / 2);
+    CHECK(maxError <= 15);
+    CHECK(std::abs(velocity + 300) < 30);
+    CHECK(rejected == implausible);
+
+    // the same recording gives the same output
+    const auto again = replay(recording);
+    bool identical = true;
+    for (size_t index = 0; index < outputs.size(); index++) {
+        identical &= outputs[index].distance == again[index].distance and outputs[index].velocity == again[index].velocity;
+    }
+    CHECK(identical);
+
+    // a dropout coasts on the velocity, a long one drops the track
+    RangeFilter<5> filter;
+    for (int index = 0; index < 20; index++) {
+        filter.update(1000 - index * 10, 20 << 7, RangeErrorCode::RangeComplete);
+    }
+    const uint16_t before = filter.getDistance();
+    CHECK(not filter.update(8190, 0, RangeErrorCode::SigmaThresholdCheck));
+    CHECK(filter.isTracking());
+    CHECK(filter.getDistance() < before);
+    for (int index = 0; index < 5; index++) {
+        filter.update(8190, 0, RangeErrorCode::SigmaThresholdCheck);
+    }
+    CHECK(not filter.isTracking());
+    CHECK(filter.update(500, 20 << 7, RangeErrorCode::RangeComplete));
+    CHECK(filter.getDistance() == 500);
+    CHECK(filter.getVelocity() == 0);
+
+    return test::result();
+}
@@ -0,0 +1,50 @@
+// SimBoard: the ToF sensor sees the arena and the motor bring-up steps run on the models
+
+#include "check.hpp"
+#include "sim/sequence_io.hpp"
+
+#include <cmath>
+
+using namespace std::chrono_literals;
+using TestSequence::Step;
+
+int
+main()
+{
+    Board::initialize();
+    Board::World world;
+    sim::SequenceIo::world = &world;
+
+    // ToF range through the simulated I2C master, the sensor is 1 m - 40 mm from the wall
+    modm::vl53l0::Data data;
+    modm::Vl53l0<Board::I2c::Master> sensor(data);
+    CHECK(sensor.initialize());
+    CHECK(sensor.readDistance());
+    CHECK(data.isValid());
+    CHECK(std::abs(data.getDistance() - 960) <= 1);
+
+    // close to the wall
+    world.robot.setPose({0.9, 0, 0});
+    CHECK(sensor.readDistance());
+    CHECK(data.getDistance() < 100);
+
+    static constexpr Step steps[] =
+    {
+        {"sl", 0, modm::Q15(0.5), 0ms, 100ms, {.maxFrequency = 0}},
+        {"fw", TestSequence::Sleep, modm::Q15(0.5), 200ms, 200ms, {.minFrequency = 50}},
+        {"rv", TestSequence::Sleep | TestSequence::Dir, modm::Q15(0.5), 300ms, 200ms, {.minFrequency = 50}},
+        {"br", TestSequence::Sleep | TestSequence::Brake, modm::Q15(0.5), 500ms, 100ms, {.maxFrequency = 0}},
+        {"sl", 0, modm::Q15(0.5), 0ms, 100ms, {.maxFrequency = 0}},
+    };
+    const auto summary = TestSequence::run<sim::SequenceIo>(steps);
+    CHECK(summary.steps == 5);
+    CHECK(summary.failed == 0);
+    CHECK(sim::SequenceIo::records.size() == 5);
+    for (const auto &record : sim::SequenceIo::records) {
+        if (not CHECK(record.passed)) {
+            std::fprintf(stderr, "%s: %u %u Hz\n", record.code, record.frequency[0], record.frequency[1]);
+        }
+    }
+
+    return test::result();
+}
@@ -0,0 +1,148 @@
+// soft::Fir and soft::Iir, the FMAC fallback, against a double reference
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "check.hpp"
+#include "soft_math.hpp"
+
+/// y[n] = sum b[k] x[n-k] + sum a[k] y[n-k], with the Q1.15 coefficients and samples as fractions
+std::vector<double>
+reference(const std::vector<int16_t> &input, const std::vector<int16_t> &b, const std::vector<int16_t> &a,
+          int gain)
+{
+    std::vector<double> output(input.size());
+    for (size_t n = 0; n < input.size(); n++)
+    {
+        double sum = 0;
+        for (size_t k = 0; k < b.size() and k <= n; k++) {
+            sum += b[k] / 32768.0 * input[n - k];
+        }
+        for (size_t k = 0; k < a.size() and k < n; k++) {
+            sum += a[k] / 32768.0 * output[n - 1 - k];
+        }
+        output[n] = std::clamp(sum * (1 << gain), -32768.0, 32767.0);
+    }
+    return output;
+}
+
+/// Deterministic test signal: two tones, noise and a step to full scale
+std::vector<int16_t>
+signal(size_t length)
+{
+    std::vector<int16_t> samples(length);
+    uint32_t seed = 3;
+    for (size_t n = 0; n < length; n++)
+    {
+        seed = seed * 1664525 + 1013904223;
+        const double value = 9000 * std::sin(n * 0.05) + 4000 * std::sin(n * 1.3) +
+                             int(seed >> 20) % 2001 - 1000 + ((n / 200) % 2 ? 12000 : -12000);
+        samples[n] = int16_t(std::clamp(value, -32768.0, 32767.0));
+    }
+    return samples;
+}
+
+double
+maximumError(const std::vector<int16_t> &output, const std::vector<double> &expected)
+{
+    double error = 0;
+    for (size_t n = 0; n < output.size(); n++) {
+        error = std::max(error, std::abs(output[n] - expected[n]));
+    }
+    return error;
+}
+
+/// Filters in uneven chunks, in place, as the FMAC version is used
+template<class Filter>
+std::vector<int16_t>
+chunked(Filter &filter, std::vector<int16_t> samples)
+{
+    size_t chunk = 1;
+    for (size_t start = 0; start < samples.size(); start += chunk, chunk = chunk % 23 + 7)
+    {
+        const size_t length = std::min(chunk, samples.size() - start);
+        filter.process(samples.data() + start, samples.data() + start, length);
+    }
+    return samples;
+}
+
+int
+main()
+{
+    const std::vector<int16_t> input = signal(1000);
+
+    // 8-tap moving average, as used on the Vrefint samples
+    {
+        const std::array<int16_t, 8> taps{4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096};
+        soft::Fir<8> whole(taps), parts(taps);
+        std::vector<int16_t> output(input.size());
+        whole.process(input.data(), output.data(), input.size());
+        const double error = maximumError(output, reference(input, {taps.begin(), taps.end()}, {}, 0));
+        std::printf("moving average: %.2f LSB\n", error);
+        CHECK(error <= 1);
+        CHECK(chunked(parts, input) == output);
+    }
+
+    // windowed low pass with negative taps and gain
+    {
+        const std::array<int16_t, 5> taps{-1200, 5000, 8800, 5000, -1200};
+        soft::Fir<5> whole(taps, 1), parts(taps, 1);
+        std::vector<int16_t> output(input.size());
+        whole.process(input.data(), output.data(), input.size());
+        const double error = maximumError(output, reference(input, {taps.begin(), taps.end()}, {}, 1));
+        std::printf("low pass FIR: %.2f LSB\n", error);
+        CHECK(error <= 2);
+        CHECK(chunked(parts, input) == output);
+        // reset() clears the history
+        whole.reset();
+        std::vector<int16_t> again(input.size());
+        whole.process(input.data(), again.data(), input.size());
+        CHECK(again == output);
+    }
+
+    // first-order low pass, as used on the temperature samples
+    {
+        soft::Iir<2, 1> whole({2048, 0}, {30720}), parts({2048, 0}, {30720});
+        std::vector<int16_t> output(input.size());
+        whole.process(input.data(), output.data(), input.size());
+        const double error = maximumError(output, reference(input, {2048, 0}, {30720}, 0));
+        std::printf("first-order IIR: %.2f LSB\n", error);
+        // the truncated feedback accumulates to the bias of one LSB times the DC gain
+        CHECK(error <= 16);
+        CHECK(chunked(parts, input) == output);
+        // unity DC gain
+        const std::vector<int16_t> constant(400, 10000);
+        std::vector<int16_t> settled(constant.size());
+        whole.reset();
+        whole.process(constant.data(), settled.data(), constant.size());
+        CHECK(std::abs(settled.back() - 10000) <= 16);
+    }
+
+    // second-order Butterworth low pass at 0.05 fs, a[k] added like the FMAC
+    {
+        const std::array<int16_t, 3> b{329, 658, 329};
+        const std::array<int16_t, 2> a{25576, -10508};
+        soft::Iir<3, 2> whole(b, a, 1), parts(b, a, 1);
+        std::vector<int16_t> output(input.size());
+        whole.process(input.data(), output.data(), input.size());
+        // the coefficients are halved to fit Q1.15, the gain restores them
+        const double error = maximumError(output, reference(input, {b.begin(), b.end()}, {a.begin(), a.end()}, 1));
+        std::printf("biquad: %.2f LSB\n", error);
+        CHECK(error <= 16);
+        CHECK(chunked(parts, input) == output);
+    }
+
+    // saturation instead of wrap around
+    {
+        soft::Fir<2> doubling({32767, 32767});
+        const std::array<int16_t, 3> peaks{30000, 30000, -30000};
+        std::array<int16_t, 3> output;
+        doubling.process(peaks.data(), output.data(), peaks.size());
+        CHECK(output[1] == 32767);
+        CHECK(std::abs(output[2]) <= 1);
+    }
+
+    return test::result();
+}
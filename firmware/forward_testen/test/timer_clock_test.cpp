@@ -0,0 +1,106 @@
+// TimerClock::now() on a fake 32-bit timer over thousands of wraps, with the
+// update interrupt preempting the read at every possible point
+
+#include <cstdint>
+#include <cstdio>
+
+#include "check.hpp"
+#include <modm/platform/clock/timer_clock.hpp>
+
+/// Free-running counter, one microsecond passes with every register access
+struct FakeTimer
+{
+    using Value = uint32_t;
+    struct InterruptFlag
+    {
+        static constexpr uint32_t Update = 1;
+    };
+
+    /// true time in us
+    static inline uint64_t time{0};
+    static inline bool update{false};
+    /// register accesses after the wrap until the interrupt preempts
+    static inline uint32_t latency{0};
+    static inline uint32_t accesses{0};
+    static inline void (*interrupt)() {nullptr};
+    static inline bool handling{false};
+
+    static Value
+    getValue()
+    {
+        const Value value = Value(time);
+        access();
+        return value;
+    }
+
+    static uint32_t
+    getInterruptFlags()
+    {
+        const uint32_t flags = update ? InterruptFlag::Update : 0;
+        access();
+        return flags;
+    }
+
+    static void
+    acknowledgeInterruptFlags(uint32_t flags)
+    {
+        if (flags & InterruptFlag::Update) {
+            update = false;
+        }
+    }
+
+    static void
+    access()
+    {
+        if (Value(time + 1) == 0) {
+            update = true;
+            accesses = 0;
+        }
+        time++;
+        if (update and not handling and accesses++ == latency)
+        {
+            handling = true;
+            interrupt();
+            handling = false;
+        }
+    }
+};
+
+using Clock = modm::platform::TimerClock<FakeTimer>;
+
+int
+main()
+{
+    FakeTimer::interrupt = Clock::handleInterrupt;
+
+    constexpr uint32_t Wraps = 3906;
+    constexpr uint64_t Period = uint64_t(1) << 32;
+    uint64_t last = 0;
+    uint32_t wrong = 0, backwards = 0;
+    for (uint32_t wrap = 1; wrap <= Wraps; wrap++)
+    {
+        // the interrupt preempts at every access of the reads around the wrap,
+        // or is held off for a while, like with the interrupts disabled
+        FakeTimer::latency = (wrap % 64 < 48) ? wrap % 16 : 1000 + wrap;
+        FakeTimer::time = wrap * Period - 8 - wrap % 4;
+        while (FakeTimer::time < wrap * Period + 32 or FakeTimer::update)
+        {
+            const uint64_t before = FakeTimer::time;
+            const uint64_t now = Clock::now().time_since_epoch().count();
+            const uint64_t after = FakeTimer::time;
+            wrong += (now < before or now >= after);
+            backwards += (now < last);
+            last = now;
+            if (FakeTimer::time > wrap * Period + 4000) {
+                // eventually the interrupt runs
+                FakeTimer::latency = FakeTimer::accesses;
+            }
+        }
+    }
+    std::printf("%u wraps, last read at %llu us\n", Wraps, (unsigned long long)last);
+    CHECK(wrong == 0);
+    CHECK(backwards == 0);
+    CHECK(last >> 32 == Wraps);
+
+    return test::result();
+}
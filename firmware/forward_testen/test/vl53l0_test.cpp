@@ -0,0 +1,72 @@
+// modm::Vl53l0 against the register model of sim/vl53l0_model.hpp
+
+#include "check.hpp"
+#include "sim/i2c_master.hpp"
+#include "sim/vl53l0_model.hpp"
+
+using Master = sim::I2cMaster<>;
+using Sample = sim::Vl53l0Model::Sample;
+using RangeErrorCode = sim::Vl53l0Model::RangeErrorCode;
+
+int
+main()
+{
+    sim::I2cBus bus;
+    sim::Vl53l0Model model;
+    bus.attach(model);
+    Master::connect(bus);
+
+    modm::vl53l0::Data data;
+    modm::Vl53l0<Master> sensor(data);
+
+    // full initialization with reference SPAD discovery and calibration
+    CHECK(sensor.ping());
+    CHECK(sensor.initialize());
+    const auto calibration = sensor.getCalibration();
+    CHECK(calibration.isValid());
+    CHECK(calibration.referenceSpadCount == 5);
+    CHECK(calibration.useApertureSpads == 1);
+    CHECK(calibration.vhvSettings == model.peek(0xCB, 1));
+    CHECK(calibration.phaseCalibration == model.peek(0xEE, 1));
+    const uint32_t fullTransactions = Master::getStatistics().transactions;
+
+    // single shot measurements
+    const uint32_t measurements = model.getMeasurementCount();
+    model.setSample(Sample{742, 15 << 7, RangeErrorCode::RangeComplete});
+    CHECK(sensor.readDistance());
+    CHECK(data.isValid());
+    CHECK(data.getDistance() == 742);
+    CHECK(data.getSignalRate() == (15 << 7));
+    CHECK(model.getMeasurementCount() == measurements + 1);
+
+    model.setSample(Sample{8190, 0, RangeErrorCode::RangePhaseCheck});
+    CHECK(sensor.readDistance());
+    CHECK(not data.isValid());
+    CHECK(data.getRangeError() == RangeErrorCode::RangePhaseCheck);
+
+    // a slow conversion is polled until it completes
+    model.setConversionPolls(5);
+    model.setSample(Sample{120, 40 << 7, RangeErrorCode::RangeComplete});
+    CHECK(sensor.readDistance());
+    CHECK(data.getDistance() == 120);
+
+    // soft reset, the sensor NACKs while booting
+    CHECK(sensor.reset());
+    CHECK(sensor.ping());
+
+    // the stored calibration skips the reference measurements
+    Master::resetStatistics();
+    CHECK(sensor.initialize(&calibration));
+    CHECK(Master::getStatistics().transactions < fullTransactions);
+    CHECK(model.peek(0xCB, 1) == calibration.vhvSettings);
+    model.setSample(Sample{300, 10 << 7, RangeErrorCode::RangeComplete});
+    CHECK(sensor.readDistance());
+    CHECK(data.getDistance() == 300);
+
+    // the sensor answers on its new address
+    CHECK(sensor.setDeviceAddress(0x30));
+    CHECK(model.getAddress() == 0x30);
+    CHECK(sensor.ping());
+
+    return test::result();
+}
@@ -0,0 +1,111 @@
+// WallFollower along the wall of an arena on the robot model, with a side ranging sensor
+
+#include <cmath>
+#include <cstdio>
+
+#include "check.hpp"
+#include "closed_loop.hpp"
+#include "range_filter.hpp"
+#include "soft_math.hpp"
+#include "wall_follower.hpp"
+
+using Follower = WallFollower<soft::sincos, soft::atan2>;
+using RangeErrorCode = modm::vl53l0::RangeErrorCode;
+constexpr double Pi = 3.14159265358979323846;
+
+struct Scenario
+{
+    const char *name;
+    double tilt;        ///< rad, initial heading against the wall
+    double start;       ///< m, from the center line towards the wall
+    int dropRate;       ///< 1 in n samples invalid, 0 for none
+    bool burst;         ///< 8 samples in a row invalid after 1.5 s
+    Follower::Side side;
+};
+
+struct Result
+{
+    Follower::State state;
+    double rms;         ///< mm of the robot center from the set distance after settling
+    double worst;
+    bool inside;
+};
+
+/// Drives along the 4 m wall of a 4 x 2 m arena, one sample every 33 ms
+Result
+follow(const Scenario &scenario)
+{
+    const bool left = scenario.side == Follower::Side::Left;
+    sim::RobotModel robot({}, {4.0, 2.0});
+    robot.setPose({-1.7, left ? scenario.start : -scenario.start, scenario.tilt});
+    test::ClosedLoop loop(robot);
+    RangeFilter<5> filter({.maxDistance = 1200});
+    Follower follower({.side = scenario.side});
+    follower.reset();
+
+    Result result{Follower::State::Lost, 0, 0, true};
+    double squares = 0;
+    int samples = 0;
+    uint32_t seed = 11;
+    for (int tick = 0; robot.getPose().x < 1.4 and tick < 20'000; tick++)
+    {
+        if (tick % 33 == 0)
+        {
+            seed = seed * 1664525 + 1013904223;
+            const double range = robot.getRange(left ? Pi / 2 : -Pi / 2) * 1000 + int(seed >> 16) % 7 - 3;
+            const bool dropped = (scenario.dropRate and (seed >> 8) % scenario.dropRate == 0) or
+                                 (scenario.burst and tick > 1500 and tick < 1500 + 33 * 8);
+            if (dropped or range > 1200) {
+                filter.update(8190, 0, RangeErrorCode::RangePhaseCheck);
+            } else {
+                filter.update(uint16_t(range), 20 << 7, RangeErrorCode::RangeComplete);
+            }
+            const auto command = follower.update({
+                    .tracking = filter.isTracking(),
+                    .distance = filter.getDistance(),
+                    .left = loop.getSpeed(0),
+                    .right = loop.getSpeed(1)});
+            loop.setSpeed(command.left, command.right);
+
+            if (tick > 2000)
+            {
+                const double error = (1.0 - std::abs(robot.getPose().y)) * 1000 - 200;
+                squares += error * error;
+                samples++;
+                result.worst = std::max(result.worst, std::abs(error));
+            }
+        }
+        loop.tick();
+        result.inside &= robot.isInside();
+    }
+    result.state = follower.getState();
+    result.rms = std::sqrt(squares / std::max(samples, 1));
+    return result;
+}
+
+int
+main()
+{
+    constexpr Scenario scenarios[] = {
+        {"parallel",             0.0, 0.80,  0, false, Follower::Side::Right},
+        {"towards the wall",     0.2, 0.60,  0, false, Follower::Side::Right},
+        {"away, dropouts",      -0.2, 0.75,  5, false, Follower::Side::Right},
+        {"burst",                0.0, 0.80, 10, true,  Follower::Side::Right},
+        {"left, burst",          0.15, 0.70, 10, true,  Follower::Side::Left},
+        {"left, far away",      -0.3, 0.50, 10, false, Follower::Side::Left},
+        {"steep, burst",         0.3, 0.85,  0, true,  Follower::Side::Right},
+    };
+
+    for (const auto &scenario : scenarios)
+    {
+        const Result result = follow(scenario);
+        std::printf("%-20s state %u, rms %.1f mm, worst %.1f mm\n",
+                    scenario.name, unsigned(result.state), result.rms, result.worst);
+        CHECK(result.state == Follower::State::Following);
+        CHECK(result.inside);
+        CHECK(result.rms < 10);
+        CHECK(result.worst < 25);
+    }
+
+    return test::result();
+}
@@ -0,0 +1,119 @@
+#ifndef TEST_SEQUENCE_HPP
+#define TEST_SEQUENCE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#include <modm/math/fixed_point.hpp>
+
+/**
+ * @brief Table-driven bring-up tests of the motor drivers.
+ *
+ * A sequence is a table of Steps: the driver pins and duty cycle of both
+ * motors, how long to hold them and what to observe meanwhile. run() applies
+ * one step after the other, counts the FG edges of both motors while the
+ * step holds and reports one Record per step. It only waits through `Io`,
+ * so on the target the calling fiber sleeps and everything else keeps
+ * running, on the host the simulation advances instead.
+ *
+ * `Io` connects the runner to a board:
+ *
+ *     static void apply(const Step &step);             // pins and duty of both motors
+ *     static void wait(std::chrono::milliseconds time);
+ *     static uint32_t getEdgeCount(uint8_t motor);     // FG edges since the start
+ *     static bool isFault(uint8_t motor);              // nFAULT asserted
+ *     static void report(const Record &record);
+ */
+namespace TestSequence
+{
+    /// Driver pin levels of a step, or-ed together
+    enum Pins : uint8_t
+    {
+        Sleep = 0b001,  ///< nSLEEP high, the driver is active
+        Brake = 0b010,  ///< BRAKE high
+        Dir   = 0b100,  ///< DIR high, reverse
+    };
+
+    enum class
+    Fault : uint8_t
+    {
+        Any,    ///< not checked
+        Clear,
+        Set,
+    };
+
+    /// Observations which pass a step, frequencies are FG edges per second
+    struct Expect
+    {
+        uint16_t minFrequency = 0;
+        uint16_t maxFrequency = std::numeric_limits<uint16_t>::max();
+        Fault fault = Fault::Any;
+    };
+
+    struct Step
+    {
+        const char *code;   ///< two letter log code
+        uint8_t pins;
+        modm::Q15 duty;
+        std::chrono::milliseconds settle;   ///< before the observation starts
+        std::chrono::milliseconds duration; ///< of the observation
+        Expect expect{};
+    };
+
+    struct Record
+    {
+        uint8_t index;
+        const char *code;
+        uint16_t frequency[2];  ///< FG edges per second of motor 1 and 2
+        uint8_t faults;         ///< bit 0 motor 1, bit 1 motor 2
+        bool passed;
+    };
+
+    struct Summary
+    {
+        uint8_t steps;
+        uint8_t failed;
+    };
+
+    /// Runs the steps in order and reports every result, failures do not stop the sequence.
+    template<class Io>
+    Summary
+    run(std::span<const Step> steps)
+    {
+        Summary summary{0, 0};
+        for (const Step &step : steps)
+        {
+            Io::apply(step);
+            Io::wait(step.settle);
+
+            const uint32_t start[2] = {Io::getEdgeCount(0), Io::getEdgeCount(1)};
+            Io::wait(step.duration);
+
+            Record record{summary.steps, step.code, {}, 0, true};
+            for (uint8_t motor = 0; motor < 2; motor++)
+            {
+                const uint32_t edges = Io::getEdgeCount(motor) - start[motor];
+                const uint32_t frequency = step.duration.count() ?
+                        uint64_t(edges) * 1000 / step.duration.count() : 0;
+                record.frequency[motor] = (frequency > 0xffff) ? 0xffff : frequency;
+                const bool fault = Io::isFault(motor);
+                record.faults |= fault << motor;
+
+                record.passed &= record.frequency[motor] >= step.expect.minFrequency and
+                                 record.frequency[motor] <= step.expect.maxFrequency;
+                if (step.expect.fault != Fault::Any) {
+                    record.passed &= fault == (step.expect.fault == Fault::Set);
+                }
+            }
+            Io::report(record);
+
+            summary.steps++;
+            summary.failed += not record.passed;
+        }
+        return summary;
+    }
+}
+
+#endif // TEST_SEQUENCE_HPP
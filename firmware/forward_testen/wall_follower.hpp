@@ -0,0 +1,192 @@
+#ifndef WALL_FOLLOWER_HPP
+#define WALL_FOLLOWER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+/**
+ * @brief Keeps a set distance to a wall beside the robot.
+ *
+ * Evaluated once per sample of a ToF sensor looking sideways, through a
+ * RangeFilter, which rejects the samples with a RangeErrorCode and keeps the
+ * track over a few of them. The angle between the heading and the wall is
+ * integrated from the measured wheel speeds and corrected by successive
+ * samples: the change of the wall distance over the `baseline` driven in
+ * between is the mean angle over it. The range and this angle give the
+ * distance of the robot center to the wall, a PD controller steers on it
+ * with the angle as derivative.
+ *
+ * While the filter lost the wall, the robot drives on straight for up to
+ * `coast` and then stops until the wall is back, every update() returns a
+ * command in a constant number of steps. `SinCos` and `Atan2` have the
+ * signatures of `Cordic::sincos()` and `Cordic::atan2()`.
+ */
+template<auto SinCos, auto Atan2>
+class WallFollower
+{
+public:
+    enum class
+    Side : uint8_t
+    {
+        Left,
+        Right,
+    };
+
+    enum class
+    State : uint8_t
+    {
+        Following,
+        Coasting,   ///< wall lost, straight on
+        Lost,       ///< standing until the wall is back
+    };
+
+    struct Parameters
+    {
+        Side side = Side::Right;
+        uint16_t distance = 200;                ///< mm from the robot center to the wall
+        uint16_t sensorOffset = 40;             ///< mm from the robot center to the sensor
+        int32_t speed = 200;                    ///< rpm
+        int32_t kp = 1 << 16;                   ///< rpm of steering per mm of error, Q16
+        int32_t kd = 200;                       ///< rpm of steering per unit slope of the wall
+        int32_t maxSteer = 60;                  ///< rpm
+        int32_t distancePerRevolution = 204'200;///< um of travel per wheel revolution
+        int32_t trackWidth = 120'000;           ///< um
+        int32_t baseline = 50'000;              ///< um of travel between two samples of the slope
+        uint16_t correction = 4096;             ///< weight of a slope sample on the angle, Q15
+        int32_t coast = 300'000;                ///< um to drive on without the wall
+        uint16_t frequency = 30;                ///< update() calls per s
+    };
+
+    /// Inputs of one sample
+    struct Perception
+    {
+        bool tracking;      ///< the range filter follows the wall
+        uint16_t distance;  ///< mm, filtered, from the sensor to the wall
+        int32_t left;       ///< measured wheel speeds in rpm
+        int32_t right;
+    };
+
+    struct Command
+    {
+        int32_t left;       ///< rpm
+        int32_t right;
+    };
+
+    WallFollower() = default;
+
+    explicit WallFollower(const Parameters &parameters) :
+        parameters(parameters)
+    {
+    }
+
+    void
+    reset()
+    {
+        state = State::Lost;
+        angle = 0;
+        error = 0;
+        travelled = 0;
+    }
+
+    Command
+    update(const Perception &input)
+    {
+        // path of the robot center and its turn away from the wall since the last update
+        const int64_t rpm = (int64_t(input.left) + input.right) / 2;
+        const int32_t step = rpm * parameters.distancePerRevolution / (60 * parameters.frequency);
+        const int64_t difference = (parameters.side == Side::Right) ?
+                (int64_t(input.right) - input.left) : (int64_t(input.left) - input.right);
+        // 2^31 / pi per radian
+        const int32_t turn = difference * parameters.distancePerRevolution * 683'565'276 /
+                             (int64_t(60) * parameters.frequency * parameters.trackWidth);
+
+        if (not input.tracking)
+        {
+            if (state == State::Following) {
+                state = State::Coasting;
+                travelled = 0;
+            }
+            if (state == State::Coasting)
+            {
+                travelled += std::abs(step);
+                if (travelled >= parameters.coast) {
+                    state = State::Lost;
+                }
+            }
+            return (state == State::Coasting) ? Command{parameters.speed, parameters.speed} : Command{0, 0};
+        }
+
+        const bool found = (state != State::Following);
+        if (found) {
+            // the angle is unknown until the end of the first baseline
+            state = State::Following;
+            angle = 0;
+        } else {
+            angle = int32_t(uint32_t(angle) + uint32_t(turn));
+        }
+        const int32_t wall = ((int64_t(input.distance) + parameters.sensorOffset) * SinCos(angle).cos) >> 31;
+
+        if (found) {
+            anchor(wall);
+        }
+        else if ((travelled += step) >= parameters.baseline or travelled <= -parameters.baseline)
+        {
+            // the slope of the wall distance over the path is the mean angle over the baseline,
+            // it corrects the angle integrated from the wheel speeds
+            const int32_t measured = Atan2((wall - anchorWall) * 1000, travelled);
+            const int32_t mean = anchorAngle + (int32_t(uint32_t(angle) - uint32_t(anchorAngle)) / 2);
+            angle += (int64_t(int32_t(uint32_t(measured) - uint32_t(mean))) * parameters.correction) >> 15;
+            anchor(wall);
+        }
+
+        error = wall - parameters.distance;
+        const int32_t slope = SinCos(angle).sin;
+        const int32_t steer = std::clamp<int32_t>(((int64_t(parameters.kp) * error) >> 16) +
+                                                  ((int64_t(parameters.kd) * slope) >> 31),
+                                                  -parameters.maxSteer, parameters.maxSteer);
+        // turn towards the wall while too far or moving away
+        return (parameters.side == Side::Right) ?
+                Command{parameters.speed + steer, parameters.speed - steer} :
+                Command{parameters.speed - steer, parameters.speed + steer};
+    }
+
+    State
+    getState() const
+    {
+        return state;
+    }
+
+    /// @return mm of the robot center too far from the wall
+    int32_t
+    getError() const
+    {
+        return error;
+    }
+
+    /// @return the estimated angle from the wall to the heading, Q1.31 fraction of pi
+    int32_t
+    getAngle() const
+    {
+        return angle;
+    }
+
+private:
+    void
+    anchor(int32_t wall)
+    {
+        anchorWall = wall;
+        anchorAngle = angle;
+        travelled = 0;
+    }
+
+    Parameters parameters{};
+    State state{State::Lost};
+    int32_t angle{0};           ///< slope of the wall, Q1.31
+    int32_t error{0};
+    int32_t travelled{0};       ///< um since the anchor or the loss of the wall
+    int32_t anchorWall{0};      ///< mm at the start of the baseline
+    int32_t anchorAngle{0};
+};
+
+#endif // WALL_FOLLOWER_HPP
@@ -13,7 +13,7 @@
 
 #include <modm/platform.hpp>
 #include <modm/architecture/interface/clock.hpp>
-#include <modm/platform/i2c/i2c_master_1.hpp>
+#include <modm/platform/i2c/i2c_master_3.hpp>
 #include <modm/platform/uart/uart_hal_1.hpp>
 
 using namespace modm::platform;
@@ -122,18 +122,19 @@ namespace Board
 
 	using Led_D2 = GpioA11; //update the pin here
 
-//	struct I2c
-//	{
-//		using Sda = GpioB5;
-//		using Scl = GpioA8;
-//		using Master = I2cMaster1;
-//
-//		static void initialize()
-//		{
-//			Master::connect<Sda::Sda, Scl::Scl>();
-//			Master::initialize<SystemClock, 400_kBd>();
-//		}
-//	};
+	// PB5/PA8 only route to I2C3, not I2C1
+	struct I2c
+	{
+		using Sda = GpioB5;
+		using Scl = GpioA8;
+		using Master = I2cMaster3;
+
+		static void initialize()
+		{
+			Master::connect<Sda::Sda, Scl::Scl>();
+			Master::initialize<SystemClock, 400_kBd>();
+		}
+	};
 
 
 	namespace DebugUart 
@@ -28,10 +28,27 @@ modm_faststack modm::Fiber<> fiber_blink([](){
     }
 });
 
+modm::vl53l0::Data distanceData;
+modm::Vl53l0<Board::I2c::Master> distanceSensor(distanceData);
+
+//Driver calls block this fiber only, it is suspended while the I2C interrupt does the transfer.
+modm_faststack modm::Fiber<2048> fiber_range([](){
+    if (not distanceSensor.initialize()) {
+        MODM_LOG_ERROR << "ToF init failed" << modm::endl;
+        return;
+    }
+    while (1) {
+        if (distanceSensor.readDistance() and distanceData.isValid()) {
+            MODM_LOG_INFO << "Distance " << distanceData.getDistance() << " mm" << modm::endl;
+        }
+        modm::this_fiber::sleep_for(100ms);
+    }
+});
+
 int main()
 {
     Board::initialize(); // Initialize system clock and GPIO pins.
-//    Board::I2c::initialize(); // Initialize I2C peripheral.
+    Board::I2c::initialize(); // Initialize I2C peripheral.
     Board::DebugUart::initialize(); // Initialize UART for debugging.
 
     modm::fiber::Scheduler::run(); // Run the fiber scheduler (manages fibers).
@@ -24,6 +24,12 @@ namespace modm::fiber
 /// @ingroup modm_architecture_fiber
 using id = uintptr_t;
 
+/// Resumes a fiber waiting in `modm::this_fiber::suspend()`.
+/// @note This function can be called from an interrupt.
+/// @ingroup modm_architecture_fiber
+void
+resume(id fiber);
+
 } // namespace modm::fiber
 
 namespace modm::this_fiber
@@ -53,6 +59,26 @@ yield();
 modm::fiber::id
 get_id();
 
+/**
+ * Suspends the current fiber until it is resumed with `modm::fiber::resume()`.
+ *
+ * A suspended fiber is removed from the scheduler and consumes no CPU time.
+ * If no other fiber is ready to run, the CPU sleeps until an interrupt resumes
+ * one. This function may return spuriously, so call it in a loop that checks
+ * the wake-up condition. Outside of a fiber it returns immediately.
+ */
+void
+suspend();
+
+/**
+ * Suspends the current fiber like `suspend()`, but for at most `timeout`.
+ *
+ * The deadline is checked with millisecond resolution. Outside of a fiber it
+ * returns immediately.
+ */
+void
+suspend_for(std::chrono::milliseconds timeout);
+
 /// Yields the current fiber until `bool condition()` returns true.
 /// @warning If `bool condition()` is true on first call, no yield is performed!
 template< class Function >
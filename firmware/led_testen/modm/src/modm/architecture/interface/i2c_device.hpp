@@ -17,6 +17,15 @@
 #include "i2c_transaction.hpp"
 #include <modm/processing/resumable.hpp>
 
+/// @cond
+#ifdef MODM_RESUMABLE_IS_FIBER
+// suspend the fiber until the I2C interrupt has finished the transaction
+#	define MODM_I2C_DEVICE_WAIT_FOR_TRANSACTION() waitForTransaction()
+#else
+#	define MODM_I2C_DEVICE_WAIT_FOR_TRANSACTION() RF_WAIT_WHILE( isTransactionRunning() )
+#endif
+/// @endcond
+
 namespace modm
 {
 
@@ -75,7 +84,7 @@ public:
 
 		RF_WAIT_UNTIL( transaction.configurePing() and startTransaction() );
 
-		RF_WAIT_WHILE( isTransactionRunning() );
+		MODM_I2C_DEVICE_WAIT_FOR_TRANSACTION();
 
 		RF_END_RETURN( wasTransactionSuccessful() );
 	}
@@ -89,7 +98,7 @@ public:
 
 		RF_WAIT_UNTIL( startWriteRead(writeBuffer, writeSize, readBuffer, readSize) );
 
-		RF_WAIT_WHILE( isTransactionRunning() );
+		MODM_I2C_DEVICE_WAIT_FOR_TRANSACTION();
 
 		RF_END_RETURN( wasTransactionSuccessful() );
 	}
@@ -102,7 +111,7 @@ public:
 
 		RF_WAIT_UNTIL( startWrite(buffer, size) );
 
-		RF_WAIT_WHILE( isTransactionRunning() );
+		MODM_I2C_DEVICE_WAIT_FOR_TRANSACTION();
 
 		RF_END_RETURN( wasTransactionSuccessful() );
 	}
@@ -115,7 +124,7 @@ public:
 
 		RF_WAIT_UNTIL( startRead(buffer, size) );
 
-		RF_WAIT_WHILE( isTransactionRunning() );
+		MODM_I2C_DEVICE_WAIT_FOR_TRANSACTION();
 
 		RF_END_RETURN( wasTransactionSuccessful() );
 	}
@@ -175,6 +184,21 @@ protected:
 		return (transaction.getState() != modm::I2c::TransactionState::Error);
 	}
 
+	/// Blocks the calling fiber until the transaction has finished.
+	/// Masters with bus supervision are checked periodically while waiting,
+	/// so a stalled bus gets recovered instead of blocking forever.
+	void inline
+	waitForTransaction()
+	{
+		if constexpr (requires { I2cMaster::supervise(); })
+		{
+			while (not transaction.waitFor(std::chrono::milliseconds(10))) {
+				I2cMaster::supervise();
+			}
+		}
+		else transaction.wait();
+	}
+
 	/// Starts our own transaction and waits until finished.
 	modm::ResumableResult<bool>
 	runTransaction()
@@ -183,7 +207,7 @@ protected:
 
 		RF_WAIT_UNTIL( startTransaction() );
 
-		RF_WAIT_WHILE( isTransactionRunning() );
+		MODM_I2C_DEVICE_WAIT_FOR_TRANSACTION();
 
 		RF_END_RETURN( wasTransactionSuccessful() );
 	}
@@ -13,6 +13,7 @@
 #define MODM_INTERFACE_I2C_TRANSACTION_HPP
 
 #include "i2c.hpp"
+#include "fiber.hpp"
 
 namespace modm
 {
@@ -117,6 +118,49 @@ public:
 		return (state == TransactionState::Busy);
 	}
 
+	/**
+	 * Blocks the calling fiber while the transaction is busy.
+	 *
+	 * The fiber is suspended and resumed by the I2cMaster via `notify()`
+	 * once the transaction is detached, so waiting costs no CPU time.
+	 * Outside of a fiber this falls back to polling.
+	 */
+	void
+	wait()
+	{
+		waiter = modm::this_fiber::get_id();
+		while (isBusy()) modm::this_fiber::suspend();
+		waiter = 0;
+	}
+
+	/**
+	 * Blocks the calling fiber like `wait()`, but for at most `timeout`.
+	 *
+	 * @return `true` if the transaction has finished, `false` on timeout.
+	 */
+	bool
+	waitFor(std::chrono::milliseconds timeout)
+	{
+		const auto start = modm::chrono::milli_clock::now();
+		waiter = modm::this_fiber::get_id();
+		while (isBusy())
+		{
+			const auto elapsed = modm::chrono::milli_clock::now() - start;
+			if (elapsed >= timeout) break;
+			modm::this_fiber::suspend_for(timeout - elapsed);
+		}
+		waiter = 0;
+		return not isBusy();
+	}
+
+	/// Resumes the fiber waiting in `wait()`, if any.
+	/// Called by the I2cMaster after `detaching()`, usually from its interrupt.
+	void
+	notify()
+	{
+		if (const modm::fiber::id fiber = waiter) modm::fiber::resume(fiber);
+	}
+
 	/**
 	 * Initializes the adapter to only send the address without payload.
 	 *
@@ -223,6 +267,7 @@ public:
 protected:
 	uint8_t address;
 	volatile TransactionState state;
+	volatile modm::fiber::id waiter{0};
 };
 
 /**
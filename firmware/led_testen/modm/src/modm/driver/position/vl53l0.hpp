@@ -63,6 +63,7 @@ public:
 
 		RESULT__INTERRUPT_STATUS = 0x13,
 		RESULT__RANGE_STATUS = 0x14,
+		RESULT__SIGNAL_RATE = (0x14+6),
 		RESULT__RANGE_VALUE0 = (0x14+10),
 		RESULT__RANGE_VALUE1 = (0x14+11),
 		RESULT__CORE_PAGE = 0x01,
@@ -314,17 +315,55 @@ public:
 		inline RangeErrorCode
 		getRangeError() { return error; }
 
+		/// @return the return signal rate in MCPS as unsigned 9.7 fixed point
+		inline uint16_t
+		getSignalRate()
+		{
+			return (static_cast<uint16_t>(signalRateBuffer[0]) << 8) + signalRateBuffer[1];
+		}
+
 		inline void
 		reset()
 		{
 			distanceBuffer[0] = (InvalidDistance & 0xFF00) >> 8;
 			distanceBuffer[1] = InvalidDistance & 0xFF;
+			signalRateBuffer[0] = 0;
+			signalRateBuffer[1] = 0;
 			error = RangeErrorCode::NoError;
 		}
 	private:
 		uint8_t distanceBuffer[2];
+		uint8_t signalRateBuffer[2];
 		RangeErrorCode error;
 	};
+
+	/// Reference calibration results of a sensor.
+	///
+	/// Read it with `getCalibration()` after a full initialization and pass it
+	/// to `initialize()` on later boots to skip the reference SPAD discovery
+	/// and the VHV and phase calibration.
+	struct modm_packed
+	Calibration
+	{
+		/// Enabled reference SPADs, written to GLOBAL__CONFIG_SPAD_ENABLES_REF_0..5
+		uint8_t spadMap[6];
+		uint8_t referenceSpadCount;
+		uint8_t useApertureSpads;
+		/// VHV setting found by the VHV calibration
+		uint8_t vhvSettings;
+		/// Phase setting found by the phase calibration
+		uint8_t phaseCalibration;
+
+		/// @return `false` if the data cannot stem from a successful calibration
+		inline bool
+		isValid() const
+		{
+			if(useApertureSpads > 1 or referenceSpadCount == 0) {
+				return false;
+			}
+			return referenceSpadCount <= (useApertureSpads ? 32 : 12);
+		}
+	};
 }; // struct vl53l0
 
 // Output operators
@@ -334,6 +373,9 @@ operator << (IOStream& os, const vl53l0::RangeErrorCode& c);
 /**
  * The class is build for single-shot measurements.
  *
+ * With `modm:processing:fiber` all functions are plain blocking calls. A fiber
+ * waiting for an I2C transfer is suspended until the I2C interrupt resumes it.
+ *
  * @author	Christopher Durand
  * @ingroup modm_driver_vl53l0
  */
@@ -353,8 +395,19 @@ public:
 	modm::ResumableResult<bool>
 	reset();
 
+	/// Initializes the sensor.
+	///
+	/// With valid `calibration` data the reference SPAD map and the VHV and
+	/// phase settings are restored from it instead of being measured, which
+	/// saves most of the initialization time. Otherwise a full calibration is
+	/// performed, its results are available from `getCalibration()` afterwards.
 	modm::ResumableResult<bool>
-	initialize();
+	initialize(const Calibration *calibration = nullptr);
+
+	/// Reference calibration results of the last successful initialization.
+	inline const Calibration&
+	getCalibration() const
+	{ return calibration; }
 
 	/// Set a new I2C address (< 128) for this device.
 	/// The address is not permanent and must be set again after every device boot.
@@ -467,7 +520,7 @@ private:
 
 	// SPAD = "single photon avalanche diode"
 	modm::ResumableResult<bool>
-	initializeSpadConfig();
+	initializeSpadConfig(const Calibration *stored);
 
 	modm::ResumableResult<bool>
 	performReferenceCalibration(Start_t modeFlags = Start_t(0));
@@ -519,6 +572,9 @@ private:
 
 	uint32_t measurementTimeUs;
 
+	// Results of the last reference calibration, kept for export
+	Calibration calibration;
+
 	// Use a union to save memory
 	// spadInfo will only be used by initializeSpadConfig() during initialization
 	union
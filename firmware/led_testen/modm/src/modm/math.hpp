@@ -17,6 +17,7 @@
 #include "math/algorithm/prescaler.hpp"
 #include "math/algorithm/prescaler_counter.hpp"
 #include "math/algorithm/range.hpp"
+#include "math/fixed_point.hpp"
 #include "math/tolerance.hpp"
 #include "math/units.hpp"
 #include "math/utils.hpp"
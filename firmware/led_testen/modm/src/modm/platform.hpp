@@ -29,6 +29,7 @@
 #include "platform/gpio/static.hpp"
 #include "platform/gpio/unused.hpp"
 #include "platform/i2c/i2c_master_1.hpp"
+#include "platform/i2c/i2c_master_3.hpp"
 #include "platform/i2c/i2c_timing_calculator.hpp"
 #include "platform/timer/basic_base.hpp"
 #include "platform/timer/general_purpose_base.hpp"
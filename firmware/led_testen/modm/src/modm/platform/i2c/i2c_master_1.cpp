@@ -47,10 +47,12 @@
 #endif
 
 #include "i2c_master_1.hpp"
+#include "i2c_recovery.hpp"
 #include <modm/architecture/interface/accessor.hpp>
 #include <modm/architecture/driver/atomic/queue.hpp>
 #include <modm/architecture/interface/atomic_lock.hpp>
 #include <modm/architecture/interface/interrupt.hpp>
+#include <modm/architecture/interface/clock.hpp>
 #include <modm/container.hpp>
 #include <modm/platform/clock/rcc.hpp>
 
@@ -79,6 +81,10 @@ namespace
 	static modm::I2cTransaction *transaction(nullptr);
 	static modm::I2cMaster::Error error(modm::I2cMaster::Error::NoError);
 
+	// bus health
+	static modm::I2cMaster::Statistics statistics{};
+	static modm::chrono::micro_clock::time_point attached;
+
 	// buffer management
 	static modm::I2cTransaction::Starting starting(0, modm::I2c::OperationAfterStart::Stop);
 	static modm::I2cTransaction::Writing writing(nullptr, 0, modm::I2c::OperationAfterWrite::Stop);
@@ -236,6 +242,27 @@ namespace
 		error = modm::I2cMaster::Error::NoError;
 	}
 
+	static inline void
+	attachTransaction(modm::I2cTransaction *next)
+	{
+		::transaction = next;
+		attached = modm::chrono::micro_clock::now();
+	}
+
+	static inline void
+	detachTransaction(modm::I2c::DetachCause cause)
+	{
+		if (transaction)
+		{
+			statistics.transactions++;
+			statistics.addLatency((modm::chrono::micro_clock::now() - attached).count());
+			transaction->detaching(cause);
+			// resume a fiber waiting for this transaction
+			transaction->notify();
+			transaction = nullptr;
+		}
+	}
+
 	static inline void
 	callNextTransaction()
 	{
@@ -255,66 +282,131 @@ namespace
 			}
 
 			DEBUG_STREAM("\n###\n");
-			::transaction = next.transaction;
+			attachTransaction(next.transaction);
 			// start the transaction
 			callStarting();
 		}
 	}
 
+	// the peripheral as seen by the bus recovery
+	struct Bus
+	{
+		static constexpr std::chrono::microseconds TransactionTimeout{modm::platform::I2cMaster1::TransactionTimeout};
+
+		static modm::I2cMaster::Statistics&
+		statistics()
+		{
+			return ::statistics;
+		}
+
+		static bool
+		isAttached()
+		{
+			return modm::accessor::asVolatile(::transaction);
+		}
+
+		static std::chrono::microseconds
+		getAttachedTime()
+		{
+			return modm::chrono::micro_clock::now() - attached;
+		}
+
+		static bool
+		isBusy()
+		{
+			return I2C1->ISR & I2C_ISR_BUSY;
+		}
+
+		static void
+		fail(modm::I2cMaster::Error cause)
+		{
+			error = cause;
+			detachTransaction(modm::I2c::DetachCause::ErrorCondition);
+
+			// Clear flags and interrupts
+			writing.length = 0;
+			reading.length = 0;
+
+			DEBUG_STREAM("disable interrupts");
+			I2C1->CR1 &= ~(
+				I2C_CR1_STOPIE |
+				I2C_CR1_TCIE   |
+				I2C_CR1_RXIE   |
+				I2C_CR1_TXIE   |
+				I2C_CR1_RXIE);
+		}
+
+		static void
+		disable()
+		{
+			// Disabling the peripheral aborts the transfer and clears all flags,
+			// PE must stay low for at least three APB clock cycles.
+			I2C1->CR1 &= ~(I2C_CR1_PE | I2C_CR1_STOPIE | I2C_CR1_TCIE | I2C_CR1_RXIE | I2C_CR1_TXIE);
+		}
+
+		static void
+		enable()
+		{
+			modm::delay_us(1);
+			I2C1->CR1 |= I2C_CR1_PE;
+		}
+
+		static void
+		startNext()
+		{
+			callNextTransaction();
+		}
+	};
+
+	using Recovery = modm::platform::I2cRecovery<Bus>;
+
 	bool
 	handleError()
 	{
 		uint16_t sr1 = I2C1->ISR;
+		Recovery::Fault fault;
 
 		if (sr1 & I2C_ISR_BERR)
 		{
 			DEBUG_STREAM("BUS ERROR");
 			I2C1->ICR = I2C_ICR_BERRCF;
-			error = modm::I2cMaster::Error::BusCondition;
+			fault = Recovery::Fault::BusError;
 		}
 		else if (sr1 & I2C_ISR_ARLO)
 		{	// arbitration lost
 			I2C1->ICR = I2C_ICR_ARLOCF;
 			DEBUG_STREAM("ARBITRATION LOST");
-			error = modm::I2cMaster::Error::ArbitrationLost;
+			fault = Recovery::Fault::ArbitrationLost;
+		}
+		else if (sr1 & I2C_ISR_TIMEOUT)
+		{
+			// SCL was held low for longer than SclLowTimeout
+			DEBUG_STREAM("SCL LOW TIMEOUT");
+			I2C1->ICR = I2C_ICR_TIMOUTCF;
+			fault = Recovery::Fault::SclLowTimeout;
 		}
-		else if ((sr1 & I2C_ISR_TIMEOUT) || (sr1 & I2C_ISR_ALERT) || (sr1 & I2C_ISR_PECERR))
+		else if ((sr1 & I2C_ISR_ALERT) || (sr1 & I2C_ISR_PECERR))
 		{
 			// should only occur in unsupported SMBus mode
 			DEBUG_STREAM("UNKNOWN, SMBUS");
 			I2C1->ICR = I2C_ICR_ALERTCF;
 			I2C1->ICR = I2C_ICR_TIMOUTCF;
 			I2C1->ICR = I2C_ICR_PECCF;
-			error = modm::I2cMaster::Error::Unknown;
+			fault = Recovery::Fault::Unknown;
 		}
 		else if (sr1 & I2C_ISR_OVR)
 		{
 			// should not occur in master mode
 			DEBUG_STREAM("UNKNOWN");
 			I2C1->ICR = I2C_ICR_OVRCF;
-			error = modm::I2cMaster::Error::Unknown;
+			fault = Recovery::Fault::Unknown;
 		}
 		else
 		{
 			return false;
 		}
 
-		if (transaction) transaction->detaching(modm::I2c::DetachCause::ErrorCondition);
-		transaction = nullptr;
-
-		// Clear flags and interrupts
-		writing.length = 0;
-		reading.length = 0;
-
-		DEBUG_STREAM("disable interrupts");
-		I2C1->CR1 &= ~(
-			I2C_CR1_STOPIE |
-			I2C_CR1_TCIE   |
-			I2C_CR1_RXIE   |
-			I2C_CR1_TXIE   |
-			I2C_CR1_RXIE);
-
-		callNextTransaction();
+		Recovery::handleFault(fault);
 		return true;
 	}
 
@@ -381,18 +473,17 @@ MODM_ISR(I2C1_EV)
 			DEBUG_STREAM("ACK FAIL");
 			// may also be ADDRESS_NACK
 			error = starting.address ? modm::I2cMaster::Error::AddressNack : modm::I2cMaster::Error::DataNack;
-			if (transaction) {
-				transaction->detaching(modm::I2c::DetachCause::ErrorCondition);
-				transaction = nullptr;
+			if (error == modm::I2cMaster::Error::AddressNack) {
+				statistics.addressNacks++;
+			} else {
+				statistics.dataNacks++;
 			}
+			detachTransaction(modm::I2c::DetachCause::ErrorCondition);
 			callNextTransaction();
 		}
 		else if (nextOperation == modm::I2c::Operation::Stop)
 		{
-			if (transaction) {
-				transaction->detaching(modm::I2c::DetachCause::NormalStop);
-				transaction = nullptr;
-			}
+			detachTransaction(modm::I2c::DetachCause::NormalStop);
 			DEBUG_STREAM("transaction finished");
 			callNextTransaction();
 		}
@@ -483,7 +574,8 @@ MODM_ISR(I2C1_ER)
 // ----------------------------------------------------------------------------
 
 void
-modm::platform::I2cMaster1::initializeWithPrescaler(uint32_t timingRegisterValue, uint8_t isrPriority)
+modm::platform::I2cMaster1::initializeWithPrescaler(uint32_t timingRegisterValue, uint8_t isrPriority,
+												  uint32_t timeoutRegisterValue)
 {
 	Rcc::enable<Peripheral::I2c1>();
 
@@ -525,6 +617,9 @@ modm::platform::I2cMaster1::initializeWithPrescaler(uint32_t timingRegisterValue
 	// Disable Own Address 2
 	I2C1->OAR2 = 0;
 
+	// Detect SCL being held low, TIDLE = 0
+	I2C1->TIMEOUTR = I2C_TIMEOUTR_TIMOUTEN | ((timeoutRegisterValue << I2C_TIMEOUTR_TIMEOUTA_Pos) & I2C_TIMEOUTR_TIMEOUTA);
+
 	// Enable Error Interrupt
 	NVIC_SetPriority(I2C1_ER_IRQn, isrPriority);
 	NVIC_EnableIRQ(I2C1_ER_IRQn);
@@ -532,8 +627,8 @@ modm::platform::I2cMaster1::initializeWithPrescaler(uint32_t timingRegisterValue
 	// Enable Event Interrupt
 	NVIC_SetPriority(I2C1_EV_IRQn, isrPriority);
 	NVIC_EnableIRQ(I2C1_EV_IRQn);
-	// Enable peripheral
-	I2C1->CR1 = I2C_CR1_PE;
+	// Enable peripheral and its error interrupt
+	I2C1->CR1 = I2C_CR1_PE | I2C_CR1_ERRIE;
 }
 
 void
@@ -542,13 +637,15 @@ modm::platform::I2cMaster1::reset()
 	reading.length = 0;
 	writing.length = 0;
 	error = Error::SoftwareReset;
-	if (transaction) transaction->detaching(DetachCause::ErrorCondition);
-	transaction = nullptr;
+	detachTransaction(DetachCause::ErrorCondition);
 	// remove all queued transactions
 	while (queue.isNotEmpty())
 	{
 		ConfiguredTransaction next = queue.get();
-		if (next.transaction) { next.transaction->detaching(DetachCause::ErrorCondition); }
+		if (next.transaction) {
+			next.transaction->detaching(DetachCause::ErrorCondition);
+			next.transaction->notify();
+		}
 		queue.pop();
 	}
 }
@@ -568,8 +665,8 @@ modm::platform::I2cMaster1::start(I2cTransaction *transaction, ConfigurationHand
 		// if the transaction object wants to attach to the queue
 		if (transaction->attaching())
 		{
-			// if no current transaction is taking place
-			if (!modm::accessor::asVolatile(::transaction))
+			// if no current transaction is taking place on a usable bus
+			if (!modm::accessor::asVolatile(::transaction) and !Recovery::isPending())
 			{
 				// configure the peripheral if necessary
 				if (handler and (configuration != handler)) {
@@ -578,7 +675,7 @@ modm::platform::I2cMaster1::start(I2cTransaction *transaction, ConfigurationHand
 				}
 
 				DEBUG_STREAM("\n###\n");
-				::transaction = transaction;
+				attachTransaction(transaction);
 				// start the transaction
 				callStarting();
 			}
@@ -600,4 +697,29 @@ modm::I2cMaster::Error
 modm::platform::I2cMaster1::getErrorState()
 {
 	return error;
-}
\ No newline at end of file
+}
+
+bool
+modm::platform::I2cMaster1::supervise()
+{
+	return Recovery::supervise(busReset);
+}
+
+void
+modm::platform::I2cMaster1::recover()
+{
+	Recovery::recover(busReset);
+}
+
+const modm::I2cMaster::Statistics&
+modm::platform::I2cMaster1::getStatistics()
+{
+	return statistics;
+}
+
+void
+modm::platform::I2cMaster1::resetStatistics()
+{
+	modm::atomic::Lock lock;
+	statistics = {};
+}
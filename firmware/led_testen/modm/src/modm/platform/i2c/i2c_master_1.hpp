@@ -21,6 +21,7 @@
 #include <modm/platform/gpio/connector.hpp>
 
 #include "i2c_timing_calculator.hpp"
+#include <algorithm>
 
 namespace modm
 {
@@ -42,6 +43,10 @@ class I2cMaster1 : public ::modm::I2cMaster
 {
 public:
 	static constexpr size_t TransactionBufferSize = 8;
+	/// Transactions running longer are aborted by supervise()
+	static constexpr std::chrono::milliseconds TransactionTimeout{25};
+	/// Timeout of the hardware SCL low detection
+	static constexpr std::chrono::milliseconds SclLowTimeout{25};
 
 private:
 	template<class SystemClock, baudrate_t baudrate, percent_t tolerance>
@@ -89,6 +94,8 @@ public:
 		Sda::setOutput(Gpio::OutputType::OpenDrain);
 		if (reset != ResetDevices::NoReset) resetDevices<Scl>(uint32_t(reset));
 		Connector::connect();
+
+		busReset = resetBus<Connector, Scl, Sda>;
 	}
 
 	/**
@@ -104,7 +111,11 @@ public:
 		constexpr std::optional<uint32_t> timingRegisterValue = calculateTimings<SystemClock, baudrate, tolerance>();
 		static_assert(bool(timingRegisterValue), "Could not find a valid clock configuration for the requested baudrate");
 
-		initializeWithPrescaler(timingRegisterValue.value(), isrPriority);
+		// tTIMEOUT = (TIMEOUTA + 1) * 2048 * tI2CCLK
+		constexpr uint64_t timeoutCycles = uint64_t(SystemClock::I2c1) * SclLowTimeout.count() / 1000;
+		constexpr uint32_t timeoutRegisterValue = std::min<uint64_t>(timeoutCycles / 2048, 4096) - 1;
+
+		initializeWithPrescaler(timingRegisterValue.value(), isrPriority, timeoutRegisterValue);
 	}
 
 	static bool
@@ -116,9 +127,65 @@ public:
 	static void
 	reset();
 
+	/**
+	 * Checks the bus for a stalled transaction or a stuck bus.
+	 *
+	 * Counts a timeout and calls recover() if the current transaction runs
+	 * longer than `TransactionTimeout`, or if the bus is busy while idle.
+	 * Also performs the recovery scheduled by a bus error or an SCL low
+	 * timeout. `modm::I2cDevice` calls this periodically while waiting in a
+	 * fiber.
+	 *
+	 * @return `true` if the bus was recovered.
+	 */
+	static bool
+	supervise();
+
+	/**
+	 * Recovers the bus from a slave holding SDA low.
+	 *
+	 * Fails the current transaction, disables the peripheral, clocks out
+	 * nine SCL pulses followed by a STOP condition, re-enables the peripheral
+	 * and then starts the queued transactions. After a bus error or an SCL
+	 * low timeout the error interrupt holds back the queue and the next
+	 * supervise() does this.
+	 *
+	 * @warning	Takes about 100us with interrupts enabled, call it from thread
+	 *			context only.
+	 */
+	static void
+	recover();
+
+	static const Statistics&
+	getStatistics();
+
+	static void
+	resetStatistics();
+
 private:
 	static void
-	initializeWithPrescaler(uint32_t timingRegisterValue, uint8_t isrPriority = 10u);
+	initializeWithPrescaler(uint32_t timingRegisterValue, uint8_t isrPriority = 10u,
+							uint32_t timeoutRegisterValue = 0xfff);
+
+	template<class Connector, class Scl, class Sda>
+	static void
+	resetBus()
+	{
+		Connector::disconnect();
+		Sda::set();
+		Scl::set();
+		Scl::setOutput(Gpio::OutputType::OpenDrain);
+		Sda::setOutput(Gpio::OutputType::OpenDrain);
+		resetDevices<Scl>(uint32_t(ResetDevices::Standard));
+		// STOP condition: SDA rising while SCL is high
+		Sda::reset();
+		modm::delay_us(5);
+		Sda::set();
+		modm::delay_us(5);
+		Connector::connect();
+	}
+
+	static inline void (*busReset)() = nullptr;
 
 };
 
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2026, modm project
+ *
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include <modm/architecture/interface/atomic_lock.hpp>
+#include <modm/architecture/interface/i2c_master.hpp>
+
+namespace modm
+{
+
+namespace platform
+{
+
+/**
+ * Recovery of a stuck bus, shared by the I2C masters.
+ *
+ * Decides when the bus has to be clocked out, which transaction fails and
+ * when the queue continues. The error interrupt reports a `Fault`: the
+ * transaction in flight fails, and after a bus error or an SCL low timeout
+ * the queue is held back until `supervise()` recovers the bus in thread
+ * context. `supervise()` also recovers a transaction running longer than
+ * `Bus::TransactionTimeout` and a bus which is busy while idle. Only the
+ * queued transactions are replayed, a partial write cannot be repeated.
+ *
+ * The peripheral is reached through `Bus`, so the same logic runs against
+ * a fake bus on the host:
+ *
+ * @code
+ * struct Bus
+ * {
+ *     static constexpr std::chrono::microseconds TransactionTimeout;
+ *     static modm::I2cMaster::Statistics& statistics();
+ *     static bool isAttached();    // a transaction is in flight
+ *     static std::chrono::microseconds getAttachedTime();
+ *     static bool isBusy();        // BUSY flag of the peripheral
+ *     static void fail(modm::I2cMaster::Error error); // detaches the transaction in flight
+ *     static void disable();       // aborts the transfer, no more interrupts
+ *     static void enable();
+ *     static void startNext();     // attaches the next queued transaction
+ * };
+ * @endcode
+ *
+ * @ingroup	modm_platform_i2c
+ */
+template<class Bus>
+class I2cRecovery
+{
+	using Error = modm::I2cMaster::Error;
+
+public:
+	enum class
+	Fault : uint8_t
+	{
+		BusError,
+		ArbitrationLost,
+		SclLowTimeout,
+		Unknown,
+	};
+
+	/// From the error interrupt: counts the fault and fails the transaction in flight.
+	static void
+	handleFault(Fault fault)
+	{
+		modm::I2cMaster::Statistics &statistics = Bus::statistics();
+		Error error = Error::Unknown;
+		// a slave may hold the bus, clock it out before the next transaction
+		bool stuck = false;
+		switch (fault)
+		{
+			case Fault::BusError:
+				statistics.busErrors++;
+				error = Error::BusCondition;
+				stuck = true;
+				break;
+			case Fault::ArbitrationLost:
+				statistics.arbitrationLosses++;
+				error = Error::ArbitrationLost;
+				break;
+			case Fault::SclLowTimeout:
+				statistics.timeouts++;
+				error = Error::BusCondition;
+				stuck = true;
+				break;
+			case Fault::Unknown:
+				break;
+		}
+		Bus::fail(error);
+
+		if (stuck) {
+			// clocking out the bus takes too long for the interrupt, the next
+			// supervise() recovers it and starts the queued transactions
+			pending = true;
+		} else {
+			Bus::startNext();
+		}
+	}
+
+	/// @return `true` while a transaction may not start, but has to be queued
+	static bool
+	isPending()
+	{
+		return pending;
+	}
+
+	/**
+	 * Recovers the bus if the error interrupt asked for it, a transaction
+	 * timed out or the bus is busy while idle.
+	 *
+	 * @param	clockOut	clocks out the bus, may be `nullptr`
+	 * @return `true` if the bus was recovered.
+	 */
+	static bool
+	supervise(void (*clockOut)())
+	{
+		{
+			modm::atomic::Lock lock;
+			modm::I2cMaster::Statistics &statistics = Bus::statistics();
+			if (pending) {
+				// already counted by the error interrupt
+			} else if (Bus::isAttached()) {
+				if (Bus::getAttachedTime() < Bus::TransactionTimeout) return false;
+				statistics.timeouts++;
+			} else if (Bus::isBusy()) {
+				statistics.timeouts++;
+			} else {
+				return false;
+			}
+		}
+		recover(clockOut);
+		return true;
+	}
+
+	/**
+	 * Fails the transaction in flight, clocks out the disabled bus and
+	 * starts the queued transactions.
+	 *
+	 * @param	clockOut	clocks out the bus, may be `nullptr`
+	 */
+	static void
+	recover(void (*clockOut)())
+	{
+		{
+			modm::atomic::Lock lock;
+			Bus::statistics().recoveries++;
+			// keeps start() from using the bus meanwhile
+			pending = true;
+			if (Bus::isAttached()) {
+				Bus::fail(Error::BusCondition);
+			}
+			Bus::disable();
+		}
+
+		// without a transaction and with the peripheral disabled no interrupt
+		// touches the bus, so the slow bit-banging runs with interrupts enabled
+		if (clockOut) {
+			clockOut();
+		}
+
+		modm::atomic::Lock lock;
+		Bus::enable();
+		pending = false;
+		// replay the queued transactions on the recovered bus
+		Bus::startNext();
+	}
+
+private:
+	static inline bool pending{false};
+};
+
+} // namespace platform
+
+} // namespace modm
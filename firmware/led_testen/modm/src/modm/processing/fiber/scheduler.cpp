@@ -21,6 +21,18 @@ yield()
 	modm::fiber::Scheduler::instance().yield();
 }
 
+void
+suspend()
+{
+	modm::fiber::Scheduler::instance().suspend();
+}
+
+void
+suspend_for(std::chrono::milliseconds timeout)
+{
+	modm::fiber::Scheduler::instance().suspend(timeout);
+}
+
 modm::fiber::id
 get_id()
 {
@@ -28,4 +40,18 @@ get_id()
 }
 
 } // namespace modm::this_fiber
+
+namespace modm::fiber
+{
+
+void
+resume(modm::fiber::id fiber)
+{
+	// id 0 is returned by `this_fiber::get_id()` outside of any fiber
+	if (fiber == 0) return;
+	reinterpret_cast<Task*>(fiber)->resumed.store(true, std::memory_order_release);
+	Scheduler::instance().pending.store(true, std::memory_order_release);
+}
+
+} // namespace modm::fiber
 /// @endcond
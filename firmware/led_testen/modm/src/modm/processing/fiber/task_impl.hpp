@@ -67,6 +67,7 @@ Task::start()
 {
 	if (isRunning()) return false;
 	modm_context_reset(&ctx);
+	resumed.store(false, std::memory_order_relaxed);
 	Scheduler::instance().add(this);
 	return true;
 }
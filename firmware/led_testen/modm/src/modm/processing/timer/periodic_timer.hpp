@@ -16,6 +16,7 @@
 
 #pragma once
 #include "timeout.hpp"
+#include <algorithm>
 
 namespace modm
 {
@@ -86,6 +87,145 @@ public:
 	}
 };
 
+/// How a GenericDeadlineTimer treats deadlines which passed unserved
+enum class
+MissedPeriods : uint8_t
+{
+	/// Expire once and continue with the first deadline in the future.
+	Skip,
+	/// Expire once per deadline, back to back until the timer caught up.
+	CatchUp,
+};
+
+/**
+ * Periodic timer against absolute deadlines with lateness statistics.
+ *
+ * The deadlines are `interval` apart from the start, independent of when
+ * `execute()` is polled, so late polls do not shift the later periods. Each
+ * expiration records its lateness, the time from the deadline it serves to
+ * the poll which noticed it, and counts the deadlines missed before it:
+ * with `MissedPeriods::Skip` the ones skipped over, with
+ * `MissedPeriods::CatchUp` a deadline which is served after the next one
+ * passed already.
+ *
+ * The statistics make the timer several times larger than a
+ * GenericPeriodicTimer, they accumulate until `resetStatistics()`, a
+ * `restart()` does not clear them.
+ *
+ * @see		GenericPeriodicTimer
+ *
+ * @tparam	Clock
+ * 		Used clock which inherits from modm::Clock, may have a variable timebase.
+ * @tparam	Duration
+ * 		Used timestamp which is compatible with the chosen Clock.
+ */
+template< class Clock, class Duration >
+class GenericDeadlineTimer : public GenericPeriodicTimer<Clock, Duration>
+{
+public:
+	using duration = Duration;
+	using rep = typename Duration::rep;
+
+	struct Statistics
+	{
+		duration minimum{duration::max()};	///< lateness of the served deadlines
+		duration maximum{0};
+		uint64_t sum{0};					///< of all lateness, in ticks of `duration`
+		uint32_t expirations{0};
+		uint32_t missed{0};					///< deadlines skipped or served after the next one
+
+		duration
+		mean() const
+		{ return duration{rep(expirations ? (sum / expirations) : 0)}; }
+	};
+
+	/// Create a stopped timer
+	GenericDeadlineTimer() = default;
+
+	/// Create and start the timer
+	template< typename Rep, typename Period >
+	GenericDeadlineTimer(std::chrono::duration<Rep, Period> interval,
+						 MissedPeriods policy = MissedPeriods::Skip) :
+		GenericPeriodicTimer<Clock, Duration>(interval), _policy(policy)
+	{}
+
+	void
+	setPolicy(MissedPeriods policy)
+	{ _policy = policy; }
+
+	MissedPeriods
+	policy() const
+	{ return _policy; }
+
+	/**
+	 * With `MissedPeriods::CatchUp` this returns at most 1, call it again
+	 * until it returns 0 to serve all deadlines that passed.
+	 *
+	 * @return the number of periods served, or zero if not expired yet
+	 */
+	size_t
+	execute()
+	{
+		if (not GenericTimeout<Clock, Duration>::execute()) {
+			return 0;
+		}
+		this->_state = this->ARMED;
+		const auto now = this->now();
+		if (not this->_interval.count())
+		{
+			this->_start = now;
+			record(duration{0}, 0);
+			return 1;
+		}
+		const duration elapsed{now - this->_start};
+		const rep periods = elapsed.count() / this->_interval.count();
+		if (_policy == MissedPeriods::CatchUp)
+		{
+			// serve the oldest deadline only
+			this->_start += this->_interval;
+			const duration lateness{elapsed - this->_interval};
+			record(lateness, lateness >= this->_interval);
+			return 1;
+		}
+		this->_start += duration{rep(this->_interval.count() * periods)};
+		record(duration{now - this->_start}, periods - 1);
+		return periods;
+	}
+
+	/// Wait until the timer expired.
+	/// @warning This is a blocking call! Inside a fiber, this function yields.
+	/// @return the number of periods served
+	size_t
+	wait()
+	{
+		size_t count{};
+		modm::this_fiber::poll([&]{ return (count = execute()); });
+		return count;
+	}
+
+	const Statistics&
+	statistics() const
+	{ return _statistics; }
+
+	void
+	resetStatistics()
+	{ _statistics = Statistics(); }
+
+private:
+	void
+	record(duration lateness, uint32_t missed)
+	{
+		_statistics.minimum = std::min(_statistics.minimum, lateness);
+		_statistics.maximum = std::max(_statistics.maximum, lateness);
+		_statistics.sum += lateness.count();
+		_statistics.expirations++;
+		_statistics.missed += missed;
+	}
+
+	Statistics _statistics;
+	MissedPeriods _policy{MissedPeriods::Skip};
+};
+
 /**
  * Periodic software timer for up to 65 seconds with millisecond resolution.
  *
@@ -105,6 +245,15 @@ using ShortPrecisePeriodicTimer = GenericPeriodicTimer< PreciseClock, ShortPreci
 /// Periodic software timer for up to 71 minutes with microsecond resolution.
 using      PrecisePeriodicTimer = GenericPeriodicTimer< PreciseClock, PreciseDuration >;
 
+/// Deadline timer for periods up to 65 seconds with millisecond resolution.
+using        ShortDeadlineTimer = GenericDeadlineTimer< Clock, ShortDuration >;
+/// Deadline timer for periods up to 49 days with millisecond resolution.
+using             DeadlineTimer = GenericDeadlineTimer< Clock, Duration >;
+/// Deadline timer for periods up to 65 milliseconds with microsecond resolution.
+using ShortPreciseDeadlineTimer = GenericDeadlineTimer< PreciseClock, ShortPreciseDuration >;
+/// Deadline timer for periods up to 71 minutes with microsecond resolution.
+using      PreciseDeadlineTimer = GenericDeadlineTimer< PreciseClock, PreciseDuration >;
+
 /// @}
 
 }	// namespace